@@ -0,0 +1,40 @@
+#pragma once
+
+// stl
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Minimal timing helpers for the *.benchmark.cpp executables, built with PUTILS_REFLECTION_BENCHMARKS
+// Benchmarks should be built in release mode, results of debug builds are meaningless
+
+namespace putils::benchmark {
+	// Force `value` to be computed, even if it's otherwise unused
+	template<typename T>
+	void do_not_optimize(const T & value) noexcept {
+		static const volatile void * sink;
+		sink = &value;
+	}
+
+	// Run `func` until at least `min_duration` has elapsed, and print the average time per run
+	// Returns the average time per run, in nanoseconds
+	template<typename Func>
+	double measure(const char * name, Func && func, std::chrono::nanoseconds min_duration = std::chrono::milliseconds(500)) noexcept {
+		func(); // Warm up caches and allocations
+
+		std::size_t runs = 0;
+		const auto start = std::chrono::steady_clock::now();
+		auto elapsed = std::chrono::steady_clock::duration{};
+		// Check the clock every 2^n runs, so that reading it doesn't weigh on short functions
+		for (std::size_t batch = 1; elapsed < min_duration; batch *= 2) {
+			for (std::size_t i = 0; i < batch; ++i)
+				func();
+			runs += batch;
+			elapsed = std::chrono::steady_clock::now() - start;
+		}
+
+		const auto ret = double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / double(runs);
+		std::printf("%-48s %12.1f ns\n", name, ret);
+		return ret;
+	}
+}
@@ -0,0 +1,241 @@
+// stl
+#include <cstddef>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+#include "benchmark.hpp"
+
+// enum_from_string (perfect hash) compared to a chain of string compares, and enum_to_string (dense array or binary search) compared to a switch
+// Names are looked up in a shuffled order, with a few unknown ones, so the branch predictor can't learn the sequence
+
+namespace {
+	enum class component {
+		transform,
+		velocity,
+		sprite,
+		text,
+		camera,
+		light,
+		collision,
+		rigid_body,
+		animation,
+		audio_source,
+		input,
+		health,
+		inventory,
+		ai,
+		network_id,
+		name,
+	};
+
+	// Sparse values, so enum_to_string uses a binary search
+	enum class http_status {
+		ok = 200,
+		created = 201,
+		no_content = 204,
+		moved_permanently = 301,
+		not_modified = 304,
+		bad_request = 400,
+		unauthorized = 401,
+		forbidden = 403,
+		not_found = 404,
+		conflict = 409,
+		internal_server_error = 500,
+		service_unavailable = 503,
+	};
+}
+
+#define refltype component
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(transform),
+		putils_reflection_value(velocity),
+		putils_reflection_value(sprite),
+		putils_reflection_value(text),
+		putils_reflection_value(camera),
+		putils_reflection_value(light),
+		putils_reflection_value(collision),
+		putils_reflection_value(rigid_body),
+		putils_reflection_value(animation),
+		putils_reflection_value(audio_source),
+		putils_reflection_value(input),
+		putils_reflection_value(health),
+		putils_reflection_value(inventory),
+		putils_reflection_value(ai),
+		putils_reflection_value(network_id),
+		putils_reflection_value(name)
+	);
+};
+#undef refltype
+
+#define refltype http_status
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(ok),
+		putils_reflection_value(created),
+		putils_reflection_value(no_content),
+		putils_reflection_value(moved_permanently),
+		putils_reflection_value(not_modified),
+		putils_reflection_value(bad_request),
+		putils_reflection_value(unauthorized),
+		putils_reflection_value(forbidden),
+		putils_reflection_value(not_found),
+		putils_reflection_value(conflict),
+		putils_reflection_value(internal_server_error),
+		putils_reflection_value(service_unavailable)
+	);
+};
+#undef refltype
+
+namespace {
+	// The kind of conversions enum reflection replaces
+	namespace hand_written {
+		std::optional<component> component_from_string(std::string_view name) noexcept {
+			if (name == "transform") return component::transform;
+			if (name == "velocity") return component::velocity;
+			if (name == "sprite") return component::sprite;
+			if (name == "text") return component::text;
+			if (name == "camera") return component::camera;
+			if (name == "light") return component::light;
+			if (name == "collision") return component::collision;
+			if (name == "rigid_body") return component::rigid_body;
+			if (name == "animation") return component::animation;
+			if (name == "audio_source") return component::audio_source;
+			if (name == "input") return component::input;
+			if (name == "health") return component::health;
+			if (name == "inventory") return component::inventory;
+			if (name == "ai") return component::ai;
+			if (name == "network_id") return component::network_id;
+			if (name == "name") return component::name;
+			return std::nullopt;
+		}
+
+		std::string_view component_to_string(component value) noexcept {
+			switch (value) {
+				case component::transform: return "transform";
+				case component::velocity: return "velocity";
+				case component::sprite: return "sprite";
+				case component::text: return "text";
+				case component::camera: return "camera";
+				case component::light: return "light";
+				case component::collision: return "collision";
+				case component::rigid_body: return "rigid_body";
+				case component::animation: return "animation";
+				case component::audio_source: return "audio_source";
+				case component::input: return "input";
+				case component::health: return "health";
+				case component::inventory: return "inventory";
+				case component::ai: return "ai";
+				case component::network_id: return "network_id";
+				case component::name: return "name";
+			}
+			return "";
+		}
+
+		std::string_view http_status_to_string(http_status value) noexcept {
+			switch (value) {
+				case http_status::ok: return "ok";
+				case http_status::created: return "created";
+				case http_status::no_content: return "no_content";
+				case http_status::moved_permanently: return "moved_permanently";
+				case http_status::not_modified: return "not_modified";
+				case http_status::bad_request: return "bad_request";
+				case http_status::unauthorized: return "unauthorized";
+				case http_status::forbidden: return "forbidden";
+				case http_status::not_found: return "not_found";
+				case http_status::conflict: return "conflict";
+				case http_status::internal_server_error: return "internal_server_error";
+				case http_status::service_unavailable: return "service_unavailable";
+			}
+			return "";
+		}
+	}
+
+	// Deterministic shuffle, so that runs are comparable
+	template<typename T>
+	void shuffle(std::vector<T> & values) noexcept {
+		unsigned state = 42;
+		for (std::size_t i = values.size() - 1; i > 0; --i) {
+			state = state * 1664525 + 1013904223;
+			std::swap(values[i], values[state % (i + 1)]);
+		}
+	}
+
+	template<typename E>
+	std::vector<E> make_values(std::size_t count) noexcept {
+		std::vector<E> ret;
+		while (ret.size() < count)
+			putils::reflection::for_each_value<E>([&](const auto & value) noexcept { ret.push_back(value.value); });
+		ret.resize(count);
+		shuffle(ret);
+		return ret;
+	}
+
+	std::vector<std::string> make_names(const std::vector<component> & values) noexcept {
+		std::vector<std::string> ret;
+		for (const auto value : values)
+			ret.emplace_back(putils::reflection::enum_to_string(value));
+		// Some unknown names, sharing prefixes and lengths with real ones
+		for (const char * unknown : { "transforms", "sprit", "lights", "audio", "nam" })
+			ret.emplace_back(unknown);
+		shuffle(ret);
+		return ret;
+	}
+
+	volatile std::size_t sink;
+
+	std::size_t checksum(std::optional<component> value) noexcept { return value ? std::size_t(*value) : 0; }
+	std::size_t checksum(std::string_view name) noexcept { return name.size(); }
+
+	// Results are summed and the sum written to a volatile, so lookups can't be optimized away
+	template<typename Func>
+	double measure_each(const char * name, const auto & inputs, Func && func) noexcept {
+		const auto total = putils::benchmark::measure(name, [&] {
+			std::size_t sum = 0;
+			for (const auto & input : inputs)
+				sum += checksum(func(input));
+			sink = sum;
+		});
+		return total / double(inputs.size());
+	}
+}
+
+int main() {
+	const auto components = make_values<component>(1024);
+	const auto statuses = make_values<http_status>(1024);
+	const auto names = make_names(components);
+
+	std::printf("from_string (%zu names)\n", names.size());
+	const auto perfect_hash = measure_each("  enum_from_string", names, [](const std::string & name) noexcept {
+		return putils::reflection::enum_from_string<component>(name);
+	});
+	const auto compares = measure_each("  chain of string compares", names, [](const std::string & name) noexcept {
+		return hand_written::component_from_string(name);
+	});
+	std::printf("  enum_from_string: %.1f ns per lookup (string compares: %.1f ns)\n", perfect_hash, compares);
+
+	std::printf("to_string, dense values (%zu values)\n", components.size());
+	const auto dense = measure_each("  enum_to_string", components, [](component value) noexcept {
+		return putils::reflection::enum_to_string(value);
+	});
+	const auto dense_switch = measure_each("  switch", components, [](component value) noexcept {
+		return hand_written::component_to_string(value);
+	});
+	std::printf("  enum_to_string: %.1f ns per value (switch: %.1f ns)\n", dense, dense_switch);
+
+	std::printf("to_string, sparse values (%zu values)\n", statuses.size());
+	const auto sparse = measure_each("  enum_to_string", statuses, [](http_status value) noexcept {
+		return putils::reflection::enum_to_string(value);
+	});
+	const auto sparse_switch = measure_each("  switch", statuses, [](http_status value) noexcept {
+		return hand_written::http_status_to_string(value);
+	});
+	std::printf("  enum_to_string: %.1f ns per value (switch: %.1f ns)\n", sparse, sparse_switch);
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+// stl
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// reflection
+#include "putils/reflection_helpers/rpc.hpp"
+#include "benchmark.hpp"
+
+// Round trips through rpc_client and rpc_server, compared to a hand-written command table using the same serializer and framing
+// Both sides run on the same thread and exchange messages through an in-memory stream (loopback), so this measures encoding and dispatch
+
+namespace {
+	struct engine {
+		int counter = 0;
+
+		int add(int a, int b) noexcept { return a + b; }
+		void increment() noexcept { ++counter; }
+		std::string greet(const std::string & name) const noexcept { return "hello " + name; }
+	};
+}
+
+#define refltype engine
+putils_reflection_info {
+	putils_reflection_methods(
+		putils_reflection_attribute(add),
+		putils_reflection_attribute(increment),
+		putils_reflection_attribute(greet)
+	);
+};
+#undef refltype
+
+namespace {
+	// The kind of command table the RPC replaces
+	namespace hand_written {
+		enum class command : std::uint32_t {
+			add,
+			increment,
+			greet,
+		};
+
+		template<typename T>
+		T read(const std::vector<char> & frame, std::size_t & offset) noexcept {
+			T ret;
+			offset += *putils::reflection::from_binary(std::span(frame).subspan(offset), ret);
+			return ret;
+		}
+
+		void handle_calls(engine & service, const std::vector<char> & frame, std::vector<char> & reply) noexcept {
+			std::size_t offset = 0;
+			const auto count = read<std::uint32_t>(frame, offset);
+			putils::reflection::to_binary(count, reply);
+			for (std::uint32_t i = 0; i < count; ++i) {
+				switch (read<command>(frame, offset)) {
+					case command::add: {
+						const auto a = read<int>(frame, offset);
+						const auto b = read<int>(frame, offset);
+						putils::reflection::to_binary(service.add(a, b), reply);
+						break;
+					}
+					case command::increment:
+						service.increment();
+						break;
+					case command::greet:
+						putils::reflection::to_binary(service.greet(read<std::string>(frame, offset)), reply);
+						break;
+				}
+			}
+		}
+	}
+
+	struct loopback {
+		std::vector<char> stream;
+		putils::reflection::rpc_message_reader reader;
+
+		std::vector<char> send(const std::vector<char> & message) noexcept {
+			stream.clear();
+			putils::reflection::write_rpc_message(message, stream);
+			reader.append(stream);
+			return *reader.next_message();
+		}
+	};
+
+	void run(std::size_t calls_per_frame) noexcept {
+		std::printf("%zu calls per frame\n", calls_per_frame);
+
+		engine service;
+		putils::reflection::rpc_server server(service);
+		putils::reflection::rpc_client<engine> client;
+		loopback to_server;
+		loopback to_client;
+
+		std::vector<char> reply;
+		server.handle_handshake(to_server.send(client.make_handshake()), reply);
+		client.handle_handshake(to_client.send(reply));
+
+		const auto rpc = putils::benchmark::measure("  rpc", [&] {
+			for (std::size_t i = 0; i < calls_per_frame; ++i) {
+				client.call<&engine::add>(int(i), 2);
+				client.call<&engine::greet>("world");
+			}
+			reply.clear();
+			server.handle_calls(to_server.send(client.flush()), reply);
+			const auto results = putils::reflection::rpc_results::parse(to_client.send(reply));
+			putils::benchmark::do_not_optimize(results->get<int>(0));
+		});
+
+		const auto table = putils::benchmark::measure("  hand-written command table", [&] {
+			std::vector<char> frame;
+			putils::reflection::to_binary(std::uint32_t(calls_per_frame * 2), frame);
+			for (std::size_t i = 0; i < calls_per_frame; ++i) {
+				putils::reflection::to_binary(hand_written::command::add, frame);
+				putils::reflection::to_binary(int(i), frame);
+				putils::reflection::to_binary(2, frame);
+				putils::reflection::to_binary(hand_written::command::greet, frame);
+				putils::reflection::to_binary(std::string("world"), frame);
+			}
+			reply.clear();
+			hand_written::handle_calls(service, to_server.send(frame), reply);
+			const auto received = to_client.send(reply);
+			int result;
+			putils::reflection::from_binary(std::span(received).subspan(sizeof(std::uint32_t)), result);
+			putils::benchmark::do_not_optimize(result);
+		});
+
+		const auto calls = double(calls_per_frame * 2);
+		std::printf("  rpc: %.1f ns per call, %.2f M calls/s (hand-written: %.1f ns per call)\n", rpc / calls, calls / rpc * 1000, table / calls);
+	}
+}
+
+int main() {
+	run(1); // Latency
+	run(100); // Throughput
+	return 0;
+}
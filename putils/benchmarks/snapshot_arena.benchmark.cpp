@@ -0,0 +1,104 @@
+// stl
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// reflection
+#include "putils/reflection_helpers/snapshot_arena.hpp"
+#include "benchmark.hpp"
+
+// Snapshot and restore of a frame of objects with snapshot_arena, compared to copy-constructing and copy-assigning them
+
+namespace {
+	struct vec3 {
+		float x = 0;
+		float y = 0;
+		float z = 0;
+	};
+
+	struct entity {
+		int id = 0;
+		int health = 100;
+		vec3 position;
+		vec3 velocity;
+		std::string name;
+		std::vector<vec3> path;
+		std::vector<int> inventory;
+	};
+}
+
+#define refltype vec3
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y),
+		putils_reflection_attribute(z)
+	);
+};
+#undef refltype
+
+#define refltype entity
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(health),
+		putils_reflection_attribute(position),
+		putils_reflection_attribute(velocity),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(path),
+		putils_reflection_attribute(inventory)
+	);
+};
+#undef refltype
+
+int main() {
+	constexpr std::size_t entity_count = 10000;
+
+	std::vector<entity> entities(entity_count);
+	for (std::size_t i = 0; i < entity_count; ++i) {
+		auto & e = entities[i];
+		e.id = int(i);
+		e.name = "entity number " + std::to_string(i);
+		e.path.resize(8);
+		e.inventory.resize(16);
+	}
+
+	putils::reflection::snapshot_arena arena;
+	std::vector<putils::reflection::snapshot_arena::snapshot<entity>> snapshots;
+	snapshots.reserve(entity_count);
+
+	const auto start = arena.get_marker();
+	for (const auto & e : entities)
+		snapshots.push_back(arena.save(e));
+	const auto megabytes = double(arena.get_used_size()) / (1024 * 1024);
+	std::printf("%zu entities, %.2f MB per snapshot\n", entity_count, megabytes);
+
+	const auto save = putils::benchmark::measure("snapshot_arena::save", [&] {
+		arena.rewind(start);
+		snapshots.clear();
+		for (const auto & e : entities)
+			snapshots.push_back(arena.save(e));
+	});
+
+	const auto restore = putils::benchmark::measure("snapshot_arena::restore", [&] {
+		for (std::size_t i = 0; i < entity_count; ++i)
+			putils::reflection::snapshot_arena::restore(snapshots[i], entities[i]);
+	});
+
+	std::vector<entity> copies;
+	const auto copy = putils::benchmark::measure("copy-construct", [&] {
+		copies = {};
+		copies.reserve(entity_count);
+		for (const auto & e : entities)
+			copies.push_back(e);
+	});
+
+	const auto assign = putils::benchmark::measure("copy-assign", [&] {
+		for (std::size_t i = 0; i < entity_count; ++i)
+			entities[i] = copies[i];
+	});
+
+	const auto per_megabyte = [&](double nanoseconds) { return nanoseconds / megabytes / 1000; };
+	std::printf("save %.1f us/MB, restore %.1f us/MB, copy-construct %.1f us/MB, copy-assign %.1f us/MB\n", per_megabyte(save), per_megabyte(restore), per_megabyte(copy), per_megabyte(assign));
+	return 0;
+}
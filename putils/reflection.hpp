@@ -1,6 +1,7 @@
 #pragma once
 
 // stl
+#include <cstddef>
 #include <string_view>
 #include <optional>
 #include <type_traits>
@@ -10,6 +11,20 @@
 // meta
 #include "putils/meta/table.hpp"
 
+#ifdef PUTILS_REFLECTION_PROFILE_LOOKUPS
+// stl
+#include <source_location>
+
+// By-name lookups take their call site as an extra argument, recorded in putils::reflection::get_lookup_profile()
+#define putils_impl_reflection_lookup_location_default , std::source_location location = std::source_location::current()
+#define putils_impl_reflection_lookup_location , std::source_location location
+#define putils_impl_reflection_forward_lookup_location , location
+#else
+#define putils_impl_reflection_lookup_location_default
+#define putils_impl_reflection_lookup_location
+#define putils_impl_reflection_forward_lookup_location
+#endif
+
 namespace putils::reflection {
 	template<typename T>
 	struct type_info;
@@ -19,6 +34,7 @@ namespace putils::reflection {
 	// 		static constexpr auto methods = std::tuple<attribute_info>;
 	// 		static constexpr auto parents = std::tuple<used_type_info>;
 	// 		static constexpr auto used_types = std::tuple<used_type_info>;
+	// 		static constexpr auto values = std::tuple<enum_value_info>; // for enums
 	//		static constexpr auto metadata = putils::table<...>;
 
 	template<typename MemberPtr, typename MetadataTable>
@@ -51,6 +67,13 @@ namespace putils::reflection {
 		const MetadataTable metadata; // putils::table<Key, Value...>
 	};
 
+	template<typename Enum, typename MetadataTable>
+	struct enum_value_info {
+		const char * name;
+		const Enum value;
+		const MetadataTable metadata; // putils::table<Key, Value...>
+	};
+
 	template<typename T>
 	concept reflectible = requires {
 		 type_info<T>{};
@@ -118,16 +141,36 @@ namespace putils::reflection {
 	template<typename T, typename Func>
 	constexpr auto for_each_attribute(T && obj, Func && func) noexcept;
 
+	// For each attribute in the objects' type, call `func(attr, a.*attr.ptr, b.*attr.ptr...)` where attr is an attribute_info
+	// All objects must have the same type (ignoring cv-qualifiers and references), and func must come last
+	// Same behavior as putils::tuple_for_each
+	template<typename T, typename... ObjectsAndFunc>
+	constexpr auto for_each_attribute_zip(T && first, ObjectsAndFunc &&... objects_and_func) noexcept;
+
 	template<typename T>
-	constexpr bool has_attribute(std::string_view name) noexcept;
+	constexpr bool has_attribute(std::string_view name putils_impl_reflection_lookup_location_default) noexcept;
 
 	// Try to find an attribute called "name" and get a member pointer to it, or nullopt
 	template<typename Attribute, typename T>
-	constexpr std::optional<Attribute T::*> get_attribute(std::string_view name) noexcept;
+	constexpr std::optional<Attribute T::*> get_attribute(std::string_view name putils_impl_reflection_lookup_location_default) noexcept;
 
 	// Try to find an attribute called "name" and get a pointer to it in obj, or nullptr
 	template<typename Attribute, typename T>
-	constexpr auto /* [const] Attribute * */ get_attribute(T && obj, std::string_view name) noexcept;
+	constexpr auto /* [const] Attribute * */ get_attribute(T && obj, std::string_view name putils_impl_reflection_lookup_location_default) noexcept;
+
+	// Get the attribute_info for the attribute at `index` in get_attributes<T>() and pass it to func, through a jump table
+	// Returns false if index is out of range
+	template<typename T, typename Func>
+	constexpr bool visit_attribute(std::size_t index, Func && func) noexcept;
+
+	// Get the object_attribute_info for the attribute at `index` in get_attributes<T>() and pass it to func, through a jump table
+	// Returns false if index is out of range
+	template<typename T, typename Func>
+	constexpr bool visit_attribute(T && obj, std::size_t index, Func && func) noexcept;
+
+	// Get a pointer to the attribute at `index` in get_attributes<T>() in obj, or nullptr if it's out of range or not an Attribute
+	template<typename Attribute, typename T>
+	constexpr auto /* [const] Attribute * */ get_attribute_by_index(T && obj, std::size_t index) noexcept;
 
 	template<typename T>
 	consteval bool has_methods() noexcept;
@@ -162,6 +205,29 @@ namespace putils::reflection {
 	template<typename Signature, typename T>
 	constexpr auto get_method(T && obj, std::string_view name) noexcept;
 
+	template<typename T>
+	consteval bool has_values() noexcept;
+
+	template<typename T>
+	concept with_values = has_values<T>();
+
+	template<typename T>
+	consteval const auto & get_values() noexcept;
+
+	// For each value of enum T, get an enum_value_info
+	// Same behavior as putils::tuple_for_each
+	template<typename T, typename Func>
+	constexpr auto for_each_value(Func && func) noexcept;
+
+	// Get the name of `value`, or an empty string if it isn't one of E's reflected values
+	// Uses an array indexed by value if E's values are dense enough, or a binary search otherwise
+	template<typename E>
+	constexpr std::string_view enum_to_string(E value) noexcept;
+
+	// Get the value called `name`, or nullopt, through a compile-time perfect hash table
+	template<typename E>
+	constexpr std::optional<E> enum_from_string(std::string_view name) noexcept;
+
 	template<typename T, typename Key>
 	constexpr bool has_metadata(Key && key) noexcept;
 
@@ -169,10 +235,10 @@ namespace putils::reflection {
 	constexpr const Ret * get_metadata(Key && key) noexcept;
 
 	template<typename T, typename Key>
-	constexpr bool has_attribute_metadata(std::string_view attribute, Key && key) noexcept;
+	constexpr bool has_attribute_metadata(std::string_view attribute, Key && key putils_impl_reflection_lookup_location_default) noexcept;
 
 	template<typename Ret, typename T, typename Key>
-	constexpr const Ret * get_attribute_metadata(std::string_view attribute, Key && key) noexcept;
+	constexpr const Ret * get_attribute_metadata(std::string_view attribute, Key && key putils_impl_reflection_lookup_location_default) noexcept;
 
 	template<typename T, typename Key>
 	constexpr bool has_method_metadata(std::string_view method, Key && key) noexcept;
@@ -185,6 +251,48 @@ namespace putils::reflection {
 
 	template<typename Ret, typename... Metadata, typename Key>
 	constexpr const Ret * get_metadata(const putils::table<Metadata...> & metadata, Key && key) noexcept;
+
+	// String usable as a template parameter, for the compile-time-indexed metadata lookups below:
+	//		get_attribute_metadata<float, T, "editor_range">(attribute)
+	template<std::size_t N>
+	struct metadata_key {
+		consteval metadata_key(const char (&str)[N]) noexcept {
+			for (std::size_t i = 0; i < N; ++i)
+				value[i] = str[i];
+		}
+
+		constexpr std::string_view view() const noexcept { return { value, N - 1 }; }
+
+		char value[N];
+	};
+
+	// The following overloads resolve Key at compile-time, and find attributes and methods through a compile-time hash table,
+	// so their cost doesn't depend on the number of attributes, methods or metadata
+	template<typename T, metadata_key Key>
+	consteval bool has_metadata() noexcept;
+
+	template<typename Ret, typename T, metadata_key Key>
+	consteval const Ret * get_metadata() noexcept;
+
+	template<typename T, metadata_key Key>
+	constexpr bool has_attribute_metadata(std::string_view attribute putils_impl_reflection_lookup_location_default) noexcept;
+
+	template<typename Ret, typename T, metadata_key Key>
+	constexpr const Ret * get_attribute_metadata(std::string_view attribute putils_impl_reflection_lookup_location_default) noexcept;
+
+	template<typename T, metadata_key Key>
+	constexpr bool has_method_metadata(std::string_view method) noexcept;
+
+	template<typename Ret, typename T, metadata_key Key>
+	constexpr const Ret * get_method_metadata(std::string_view method) noexcept;
+
+	// Get a std::array of the indices (in get_attributes<T>()) of the attributes with metadata Key
+	template<typename T, metadata_key Key>
+	consteval const auto & get_attributes_with_metadata() noexcept;
+
+	// For each attribute in T with metadata Key, get an attribute_info
+	template<typename T, metadata_key Key, typename Func>
+	constexpr void for_each_attribute_with_metadata(Func && func) noexcept;
 }
 
 #include "reflection.inl"
\ No newline at end of file
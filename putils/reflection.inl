@@ -1,51 +1,42 @@
 #include "reflection.hpp"
+#include "reflection_macros.hpp"
 
 // stl
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <string_view>
+#include <tuple>
 
 // meta
-#include "putils/meta/nameof.hpp"
 #include "putils/meta/for_each.hpp"
 #include "putils/meta/members.hpp"
 #include "putils/meta/traits/member_function_signature.hpp"
 
-// Define a type_info for a templated type, like C in the example above
-#define putils_reflection_info_template struct putils::reflection::type_info<refltype>
+#ifdef PUTILS_REFLECTION_PROFILE_LOOKUPS
+// reflection
+#include "putils/reflection_helpers/lookup_profile.hpp"
 
-// Define a type_info for a given type
-#define putils_reflection_info \
-	template<> \
-	putils_reflection_info_template
+// Record a by-name lookup of `name` in T made from `location`, which compared `scanned` attributes to it
+#define putils_impl_reflection_profile_lookup(T, name, scanned) detail::lookup_profile::record(&get_attributes<T>(), get_class_name<T>(), __func__, name, scanned, location)
+#else
+#define putils_impl_reflection_profile_lookup(T, name, scanned)
+#endif
 
-// Place inside classes that need to have reflectible private fields
-#define putils_reflection_friend(T) friend struct putils::reflection::type_info<T>;
+#ifdef PUTILS_REFLECTION_INSTRUMENT_METHODS
+// reflection
+#include "putils/reflection_helpers/method_stats.hpp"
 
-// implementation detail
-#define putils_impl_reflection_static_tuple(NAME, FUNCTION, ...) static constexpr auto NAME = FUNCTION(__VA_ARGS__);
-
-// Lets you define a custom class name
-#define putils_reflection_custom_class_name(custom_class_name) static constexpr auto class_name = putils_nameof(custom_class_name) + (std::string_view(putils_nameof(custom_class_name)).rfind("::") != std::string_view::npos ? std::string_view(putils_nameof(custom_class_name)).rfind("::") + 2 : 0);
-
-// Uses refltype as class name
-#define putils_reflection_class_name putils_reflection_custom_class_name(refltype)
-
-#define putils_reflection_attributes(...) putils_impl_reflection_static_tuple(attributes, std::make_tuple, __VA_ARGS__)
-#define putils_reflection_methods(...) putils_impl_reflection_static_tuple(methods, std::make_tuple, __VA_ARGS__)
-#define putils_reflection_parents(...) putils_impl_reflection_static_tuple(parents, std::make_tuple, __VA_ARGS__)
-#define putils_reflection_used_types(...) putils_impl_reflection_static_tuple(used_types, std::make_tuple, __VA_ARGS__)
-#define putils_reflection_type_metadata(...) putils_impl_reflection_static_tuple(metadata, putils::make_table, __VA_ARGS__)
-
-#define putils_reflection_attribute(member, ...) \
-	putils::reflection::attribute_info { .name = #member, .ptr = &refltype::member, .metadata = putils::make_table(__VA_ARGS__) }
-#define putils_reflection_metadata(key, value) key, value
-#define putils_reflection_attribute_private(member, ...) \
-	putils::reflection::attribute_info { .name = #member + 1, .ptr = &refltype::member, .metadata = putils::make_table(__VA_ARGS__) }
-#define putils_reflection_type(T, ...) \
-	putils::reflection::used_type_info { .type = putils::meta::type<T>(), .metadata = putils::make_table(__VA_ARGS__) }
+// Time the enclosing scope and record it in the method's putils::reflection::method_stats
+#define putils_impl_reflection_time_method(id) const putils::reflection::detail::method_stats::scoped_timer putils_impl_reflection_method_timer(id)
+#else
+#define putils_impl_reflection_time_method(id)
+#endif
 
 namespace putils::reflection {
 	namespace detail {
-		inline static const auto empty_tuple = std::tuple<>();
+		inline constexpr auto empty_tuple = std::tuple<>();
 	}
 
 #define putils_impl_reflection_member_detector(NAME) \
@@ -108,10 +99,32 @@ namespace putils::reflection {
 			return std::tuple_cat(get_all_parents<Ts>()...);
 		}
 
+		template<typename Parents, std::size_t I>
+		consteval bool is_first_parent_occurrence() noexcept {
+			using parent = putils_wrapped_type(std::get<I>(std::declval<Parents>()).type);
+			return []<std::size_t... Js>(std::index_sequence<Js...>) {
+				return !(std::is_same_v<putils_wrapped_type(std::get<Js>(std::declval<Parents>()).type), parent> || ...);
+			}(std::make_index_sequence<I>());
+		}
+
+		// Keep only the first occurrence of each type, for types reachable through several paths (diamonds)
+		// Without virtual inheritance their attributes couldn't be accessed anyway, as the conversion to the duplicated base is ambiguous
+		template<typename Parents>
+		consteval auto remove_duplicate_parents(const Parents & parents) noexcept {
+			return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+				return std::tuple_cat([&] {
+					if constexpr (is_first_parent_occurrence<Parents, Is>())
+						return std::make_tuple(std::get<Is>(parents));
+					else
+						return std::tuple<>();
+				}()...);
+			}(std::make_index_sequence<std::tuple_size_v<Parents>>());
+		}
+
 		template<typename T>
 		consteval auto get_all_parents() noexcept {
 			if constexpr (has_parents<T>())
-				return std::tuple_cat(get_single_parents<T>(), get_all_parents(get_single_parents<T>()));
+				return remove_duplicate_parents(std::tuple_cat(get_single_parents<T>(), get_all_parents(get_single_parents<T>())));
 			else
 				return get_single_parents<T>();
 		}
@@ -132,6 +145,10 @@ namespace putils::reflection {
 	putils_impl_reflection_member(used_types);
 	putils_impl_reflection_member(metadata);
 
+	// Enums have no parents
+	putils_impl_reflection_member_detector(values);
+	putils_impl_reflection_member_get_single(values, detail::empty_tuple);
+
 	namespace detail {
 		template<typename T>
 		struct type_info_with_parents {
@@ -141,6 +158,7 @@ namespace putils::reflection {
 			static constexpr auto methods = get_all_methods<T>(parents);
 			static constexpr auto used_types = get_all_used_types<T>(parents);
 			static constexpr auto metadata = get_all_metadata<T>(parents);
+			static constexpr auto values = get_single_values<T>();
 		};
 	}
 
@@ -164,6 +182,8 @@ namespace putils::reflection {
 	//		returns a tuple<pair<const char *, MemberPointer>> of all the attributes/methods in T and its parents
 	// get_parents/used_types<T>():
 	//		returns a tuple<putils::meta::type<T>> of all the parents/used types of T and its parents
+	// get_values<T>():
+	//		returns a tuple<enum_value_info> of all the values of enum T
 
 	// for_each_attribute/method<T>(functor):
 	//		calls `functor(name, memberPointer)` for each attribute/method in T and its parents
@@ -174,6 +194,7 @@ namespace putils::reflection {
 	putils_impl_reflection_member_getter_and_for_each(method);
 	putils_impl_reflection_member_getter_and_for_each(parent);
 	putils_impl_reflection_member_getter_and_for_each(used_type);
+	putils_impl_reflection_member_getter_and_for_each(value);
 
 	// Can't use macro for these as we don't want "get_metadatas"
 	template<typename T>
@@ -213,15 +234,51 @@ namespace putils::reflection {
 		});
 	}
 
+	namespace detail {
+		template<typename Objects, size_t... I>
+		constexpr auto for_each_attribute_zip(Objects & objects, std::index_sequence<I...>) noexcept {
+			using type = std::decay_t<std::tuple_element_t<0, Objects>>;
+			static_assert((std::is_same_v<type, std::decay_t<std::tuple_element_t<I, Objects>>> && ...), "for_each_attribute_zip requires objects of the same type");
+
+			auto && func = std::get<sizeof...(I)>(objects);
+			// Member pointers come straight from the constexpr attribute table, so each dereference resolves to a fixed offset
+			return for_each_attribute<type>([&](const auto & attr) noexcept {
+				return func(attr, std::get<I>(objects).*attr.ptr...);
+			});
+		}
+	}
+
+	template<typename T, typename... ObjectsAndFunc>
+	constexpr auto for_each_attribute_zip(T && first, ObjectsAndFunc &&... objects_and_func) noexcept {
+		static_assert(sizeof...(ObjectsAndFunc) > 0, "for_each_attribute_zip requires a function");
+		auto objects = std::forward_as_tuple(FWD(first), FWD(objects_and_func)...);
+		return detail::for_each_attribute_zip(objects, std::make_index_sequence<sizeof...(ObjectsAndFunc)>());
+	}
+
+	namespace detail {
+		// Number of attributes compared to name by a linear lookup
+		template<typename T>
+		constexpr std::size_t get_scanned_attribute_count(std::string_view name) noexcept {
+			std::size_t ret = 0;
+			for_each_attribute<T>([&](const auto & attr) noexcept {
+				++ret;
+				return attr.name == name;
+			});
+			return ret;
+		}
+	}
+
 	template<typename T>
-	constexpr bool has_attribute(std::string_view name) noexcept {
+	constexpr bool has_attribute(std::string_view name putils_impl_reflection_lookup_location) noexcept {
+		putils_impl_reflection_profile_lookup(T, name, detail::get_scanned_attribute_count<T>(name));
 		return for_each_attribute<T>([&](const auto & attribute) {
 			return attribute.name == name;
 		});
 	}
 
 	template<typename Attribute, typename T>
-	constexpr std::optional<Attribute T::*> get_attribute(std::string_view name) noexcept {
+	constexpr std::optional<Attribute T::*> get_attribute(std::string_view name putils_impl_reflection_lookup_location) noexcept {
+		putils_impl_reflection_profile_lookup(T, name, detail::get_scanned_attribute_count<T>(name));
 		return for_each_attribute<T>([&](const auto & attr) noexcept -> std::optional<Attribute T::*> {
 			if constexpr (std::is_same<putils::member_type<putils_typeof(attr.ptr)>, Attribute>()) {
 				if (name == attr.name)
@@ -232,8 +289,8 @@ namespace putils::reflection {
 	}
 
 	template<typename Attribute, typename T>
-	constexpr auto get_attribute(T && obj, std::string_view name) noexcept {
-		const auto member = get_attribute<Attribute, std::decay_t<T>>(name);
+	constexpr auto get_attribute(T && obj, std::string_view name putils_impl_reflection_lookup_location) noexcept {
+		const auto member = get_attribute<Attribute, std::decay_t<T>>(name putils_impl_reflection_forward_lookup_location);
 
 		using return_type = decltype(&(obj.*(*member)));
 		if (!member)
@@ -241,12 +298,70 @@ namespace putils::reflection {
 		return &(obj.*(*member));
 	}
 
+	namespace detail {
+		template<typename Func, std::size_t I>
+		constexpr void call_with_index(Func & func) noexcept {
+			func(std::integral_constant<std::size_t, I>());
+		}
+
+		template<typename Func, std::size_t... Is>
+		constexpr auto make_index_jump_table(std::index_sequence<Is...>) noexcept {
+			return std::array<void (*)(Func &) noexcept, sizeof...(Is)>{ &call_with_index<Func, Is>... };
+		}
+
+		template<typename T, typename Func>
+		constexpr auto attribute_jump_table = make_index_jump_table<Func>(std::make_index_sequence<std::tuple_size_v<putils_typeof(get_attributes<T>())>>());
+
+		// Call func(std::integral_constant<size_t, index>)
+		template<typename T, typename Func>
+		constexpr bool visit_attribute_index(std::size_t index, Func & func) noexcept {
+			constexpr auto & table = attribute_jump_table<T, Func>;
+			if (index >= table.size())
+				return false;
+			table[index](func);
+			return true;
+		}
+	}
+
+	template<typename T, typename Func>
+	constexpr bool visit_attribute(std::size_t index, Func && func) noexcept {
+		auto visitor = [&](auto i) noexcept {
+			func(std::get<i()>(get_attributes<T>()));
+		};
+		return detail::visit_attribute_index<T>(index, visitor);
+	}
+
+	template<typename T, typename Func>
+	constexpr bool visit_attribute(T && obj, std::size_t index, Func && func) noexcept {
+		return visit_attribute<std::decay_t<T>>(index, [&](const auto & attr) noexcept {
+			func(object_attribute_info{
+				.name = attr.name,
+				.member = obj.*attr.ptr,
+				.metadata = attr.metadata,
+			});
+		});
+	}
+
+	template<typename Attribute, typename T>
+	constexpr auto get_attribute_by_index(T && obj, std::size_t index) noexcept {
+		using return_type = decltype(&(obj.*std::declval<Attribute std::decay_t<T>::*>()));
+		return_type ret = nullptr;
+		visit_attribute<std::decay_t<T>>(index, [&](const auto & attr) noexcept {
+			if constexpr (std::is_same<putils::member_type<putils_typeof(attr.ptr)>, Attribute>())
+				ret = &(obj.*attr.ptr);
+		});
+		return ret;
+	}
+
 	template<typename T, typename Func>
 	constexpr auto for_each_method(T && obj, Func && func) noexcept {
 		return for_each_method<std::decay_t<T>>([&](const auto & attr) noexcept {
 			return func(object_method_info{
 				.name = attr.name,
-				.method = [&](auto &&... args) { return (obj.*attr.ptr)(FWD(args)...); },
+				.method = [&](auto &&... args) {
+					putils_impl_reflection_time_method((detail::method_stats::method_id{ &attr, get_class_name<std::decay_t<T>>(), attr.name }));
+					return (obj.*attr.ptr)(FWD(args)...);
+				},
 				.metadata = attr.metadata,
 			});
 		});
@@ -320,10 +435,34 @@ namespace putils::reflection {
 		});
 	}
 
+#ifdef PUTILS_REFLECTION_INSTRUMENT_METHODS
+	namespace detail {
+		template<typename T>
+		constexpr method_stats::method_id get_method_id(std::string_view name) noexcept {
+			method_stats::method_id ret{ nullptr, get_class_name<T>(), nullptr };
+			for_each_method<T>([&](const auto & attr) noexcept {
+				if (name != attr.name)
+					return false;
+				ret.key = &attr;
+				ret.method_name = attr.name;
+				return true;
+			});
+			return ret;
+		}
+	}
+#endif
+
 	template<typename Signature, typename T>
 	constexpr auto get_method(T && obj, std::string_view name) noexcept {
+#ifdef PUTILS_REFLECTION_INSTRUMENT_METHODS
+		const auto id = detail::get_method_id<std::decay_t<T>>(name);
+		const auto call_method = [&](const auto method) {
+			const auto ret = [&obj, method, id](auto &&... args) noexcept {
+				putils_impl_reflection_time_method(id);
+#else
 		const auto call_method = [&](const auto method) {
 			const auto ret = [&obj, method](auto &&... args) noexcept {
+#endif
 				const auto ptr = *method;
 				auto & decayed = (std::decay_t<T> &)obj; // method might have lost its qualifier
 				return (decayed.*ptr)(FWD(args)...);
@@ -358,7 +497,8 @@ namespace putils::reflection {
 	}
 
 	template<typename T, typename Key>
-	constexpr bool has_attribute_metadata(std::string_view attribute, Key && key) noexcept {
+	constexpr bool has_attribute_metadata(std::string_view attribute, Key && key putils_impl_reflection_lookup_location) noexcept {
+		putils_impl_reflection_profile_lookup(T, attribute, detail::get_scanned_attribute_count<T>(attribute));
 		bool ret = false;
 		for_each_attribute<T>([&](const auto & attr) {
 			if (attr.name == attribute) {
@@ -371,7 +511,8 @@ namespace putils::reflection {
 	}
 
 	template<typename Ret, typename T, typename Key>
-	constexpr const Ret * get_attribute_metadata(std::string_view attribute, Key && key) noexcept {
+	constexpr const Ret * get_attribute_metadata(std::string_view attribute, Key && key putils_impl_reflection_lookup_location) noexcept {
+		putils_impl_reflection_profile_lookup(T, attribute, detail::get_scanned_attribute_count<T>(attribute));
 		const Ret * ret = nullptr;
 		for_each_attribute<T>([&](const auto & attr) {
 			if (attr.name == attribute) {
@@ -418,4 +559,384 @@ namespace putils::reflection {
 	constexpr const Ret * get_metadata(const putils::table<Metadata...> & metadata, Key && key) noexcept {
 		return get_value<Ret>(metadata, FWD(key));
 	}
+
+	namespace detail {
+		constexpr std::uint64_t hash_name(std::string_view name) noexcept {
+			// FNV-1a
+			std::uint64_t hash = 14695981039346656037ull;
+			for (const char c : name) {
+				hash ^= std::uint8_t(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		// Open-addressing hash table mapping names to their index, built at compile-time
+		template<std::size_t N>
+		struct name_index {
+			static constexpr std::size_t bucket_count = std::bit_ceil(N * 2 + 1); // Always keep an empty bucket to end probing
+
+			constexpr std::optional<std::size_t> find(std::string_view name) const noexcept {
+				for (auto bucket = hash_name(name) & (bucket_count - 1); buckets[bucket] != 0; bucket = (bucket + 1) & (bucket_count - 1))
+					if (names[buckets[bucket] - 1] == name)
+						return buckets[bucket] - 1;
+				return std::nullopt;
+			}
+
+			std::array<std::string_view, N> names{};
+			std::array<std::size_t, bucket_count> buckets{}; // index + 1, or 0 for empty buckets
+		};
+
+		template<std::size_t N>
+		constexpr auto make_name_index(const std::array<std::string_view, N> & names) noexcept {
+			name_index<N> ret;
+			ret.names = names;
+			for (std::size_t i = 0; i < N; ++i) {
+				if (ret.find(names[i])) // If several elements share a name, find the first one, as with for_each_attribute
+					continue;
+				auto bucket = hash_name(names[i]) & (ret.bucket_count - 1);
+				while (ret.buckets[bucket] != 0)
+					bucket = (bucket + 1) & (ret.bucket_count - 1);
+				ret.buckets[bucket] = i + 1;
+			}
+			return ret;
+		}
+
+		// Index the names of a tuple of attribute_info
+		template<typename... Infos>
+		constexpr auto make_name_index(const std::tuple<Infos...> & infos) noexcept {
+			return make_name_index(std::apply(
+				[](const auto &... info) noexcept {
+					return std::array<std::string_view, sizeof...(Infos)>{ info.name... };
+				},
+				infos
+			));
+		}
+
+		// Derive independent hashes from a name's hash (splitmix64 finalizer)
+		constexpr std::uint64_t mix_hash(std::uint64_t hash, std::uint64_t seed) noexcept {
+			hash ^= seed * 0x9e3779b97f4a7c15ull;
+			hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+			hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+			return hash ^ (hash >> 31);
+		}
+
+		// Length, first, middle and last characters of a name: much cheaper than hash_name, as it doesn't loop over the name
+		// Only usable as a hash when it tells all the names of a table apart
+		constexpr std::uint64_t quick_hash_name(std::string_view name) noexcept {
+			if (name.empty())
+				return 0;
+			return std::uint64_t(name.size())
+				| std::uint64_t(std::uint8_t(name.front())) << 16
+				| std::uint64_t(std::uint8_t(name[name.size() / 2])) << 24
+				| std::uint64_t(std::uint8_t(name.back())) << 32;
+		}
+
+		template<std::size_t N>
+		constexpr bool has_unique_quick_hashes(const std::array<std::string_view, N> & names) noexcept {
+			for (std::size_t i = 0; i < N; ++i)
+				for (std::size_t j = i + 1; j < N; ++j)
+					if (quick_hash_name(names[i]) == quick_hash_name(names[j]) && names[i] != names[j])
+						return false;
+			return true;
+		}
+
+		// Perfect hash table mapping names to their index, built at compile-time with "hash and displace":
+		// names are grouped by a first hash, then each group gets a seed for which the second hash of its names doesn't collide
+		// Lookups are a first hash, a second hash and a single string comparison
+		template<std::size_t N>
+		struct perfect_name_index {
+			static constexpr std::size_t size = std::bit_ceil(N);
+
+			constexpr std::uint64_t hash(std::string_view name) const noexcept {
+				return quick_hash ? quick_hash_name(name) : hash_name(name);
+			}
+
+			constexpr std::optional<std::size_t> find(std::string_view name) const noexcept {
+				const auto hash = this->hash(name);
+				const auto displacement = displacements[mix_hash(hash, 0) & (size - 1)];
+				// Negative displacements directly store the slot for groups of a single name
+				const auto slot = displacement < 0 ? std::size_t(-displacement - 1) : mix_hash(hash, std::uint64_t(displacement)) & (size - 1);
+				const auto index = slots[slot];
+				if (index == 0 || names[index - 1] != name)
+					return std::nullopt;
+				return index - 1;
+			}
+
+			bool quick_hash = false;
+			std::array<std::string_view, N> names{};
+			std::array<std::int64_t, size> displacements{};
+			std::array<std::size_t, size> slots{}; // index + 1, or 0 for empty slots
+		};
+
+		template<std::size_t N>
+		constexpr auto make_perfect_name_index(const std::array<std::string_view, N> & names) noexcept {
+			perfect_name_index<N> ret;
+			ret.names = names;
+			ret.quick_hash = has_unique_quick_hashes(names);
+			constexpr auto mask = ret.size - 1;
+
+			std::array<std::uint64_t, N> hashes{};
+			std::array<std::size_t, N> groups{};
+			std::array<std::size_t, ret.size> group_sizes{};
+			std::array<std::size_t, N> order{};
+			for (std::size_t i = 0; i < N; ++i) {
+				hashes[i] = ret.hash(names[i]);
+				groups[i] = mix_hash(hashes[i], 0) & mask;
+				++group_sizes[groups[i]];
+				order[i] = i;
+			}
+
+			// Place the biggest groups first, while most slots are free
+			std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+				if (group_sizes[groups[lhs]] != group_sizes[groups[rhs]])
+					return group_sizes[groups[lhs]] > group_sizes[groups[rhs]];
+				return groups[lhs] < groups[rhs];
+			});
+
+			std::size_t next_free_slot = 0;
+			for (std::size_t start = 0; start < N;) {
+				const auto group = groups[order[start]];
+				const auto group_size = group_sizes[group];
+
+				if (group_size == 1) {
+					while (ret.slots[next_free_slot] != 0)
+						++next_free_slot;
+					ret.displacements[group] = -std::int64_t(next_free_slot) - 1;
+					ret.slots[next_free_slot] = order[start] + 1;
+				}
+				else {
+					std::array<std::size_t, N> group_slots{};
+					for (std::int64_t displacement = 1;; ++displacement) {
+						bool found = true;
+						for (std::size_t i = 0; i < group_size && found; ++i) {
+							group_slots[i] = mix_hash(hashes[order[start + i]], std::uint64_t(displacement)) & mask;
+							found = ret.slots[group_slots[i]] == 0 && std::find(group_slots.begin(), group_slots.begin() + std::ptrdiff_t(i), group_slots[i]) == group_slots.begin() + std::ptrdiff_t(i);
+						}
+
+						if (found) {
+							ret.displacements[group] = displacement;
+							for (std::size_t i = 0; i < group_size; ++i)
+								ret.slots[group_slots[i]] = order[start + i] + 1;
+							break;
+						}
+					}
+				}
+				start += group_size;
+			}
+			return ret;
+		}
+
+		template<typename T>
+		constexpr auto attribute_name_index = make_name_index(get_attributes<T>());
+
+		template<typename T>
+		constexpr auto method_name_index = make_name_index(get_methods<T>());
+
+		// For each element of a tuple of attribute_info, a pointer to its metadata for Key (or nullptr)
+		template<typename Ret, metadata_key Key, typename... Infos>
+		constexpr auto get_metadata_pointers(const std::tuple<Infos...> & infos) noexcept {
+			return std::apply(
+				[](const auto &... info) noexcept {
+					return std::array<const Ret *, sizeof...(Infos)>{ get_metadata<Ret>(info.metadata, Key.view())... };
+				},
+				infos
+			);
+		}
+
+		template<metadata_key Key, typename... Infos>
+		constexpr auto get_metadata_flags(const std::tuple<Infos...> & infos) noexcept {
+			return std::apply(
+				[](const auto &... info) noexcept {
+					return std::array<bool, sizeof...(Infos)>{ has_metadata(info.metadata, Key.view())... };
+				},
+				infos
+			);
+		}
+
+		template<typename Ret, typename T, metadata_key Key>
+		constexpr auto attribute_metadata_pointers = get_metadata_pointers<Ret, Key>(get_attributes<T>());
+
+		template<typename T, metadata_key Key>
+		constexpr auto attribute_metadata_flags = get_metadata_flags<Key>(get_attributes<T>());
+
+		template<typename Ret, typename T, metadata_key Key>
+		constexpr auto method_metadata_pointers = get_metadata_pointers<Ret, Key>(get_methods<T>());
+
+		template<typename T, metadata_key Key>
+		constexpr auto method_metadata_flags = get_metadata_flags<Key>(get_methods<T>());
+
+		template<typename T, metadata_key Key>
+		constexpr auto get_attributes_with_metadata() noexcept {
+			constexpr auto & flags = attribute_metadata_flags<T, Key>;
+			constexpr auto count = std::count(flags.begin(), flags.end(), true);
+
+			std::array<std::size_t, count> ret{};
+			std::size_t index = 0;
+			for (std::size_t i = 0; i < flags.size(); ++i)
+				if (flags[i])
+					ret[index++] = i;
+			return ret;
+		}
+
+		template<typename T, metadata_key Key>
+		constexpr auto attributes_with_metadata = get_attributes_with_metadata<T, Key>();
+	}
+
+	namespace detail {
+		template<typename E>
+		constexpr auto enum_value_count = std::tuple_size_v<putils_typeof(get_values<E>())>;
+
+		template<typename E>
+		constexpr auto enum_names = std::apply(
+			[](const auto &... info) noexcept {
+				return std::array<std::string_view, sizeof...(info)>{ info.name... };
+			},
+			get_values<E>()
+		);
+
+		template<typename E>
+		constexpr auto enum_values = std::apply(
+			[](const auto &... info) noexcept {
+				return std::array<E, sizeof...(info)>{ info.value... };
+			},
+			get_values<E>()
+		);
+
+		// Unsigned representation of E's values, preserving their order
+		template<typename E>
+		constexpr auto to_ordered_unsigned(E value) noexcept {
+			using underlying = std::underlying_type_t<E>;
+			using unsigned_type = std::make_unsigned_t<underlying>;
+			auto ret = unsigned_type(value);
+			if constexpr (std::is_signed_v<underlying>)
+				ret ^= unsigned_type(1) << (sizeof(unsigned_type) * 8 - 1);
+			return ret;
+		}
+
+		template<typename E>
+		constexpr auto enum_range = [] {
+			using unsigned_type = decltype(to_ordered_unsigned(E()));
+			if (enum_values<E>.empty())
+				return std::pair(unsigned_type(0), std::uint64_t(0));
+
+			const auto [min, max] = std::minmax_element(enum_values<E>.begin(), enum_values<E>.end(), [](E lhs, E rhs) {
+				return to_ordered_unsigned(lhs) < to_ordered_unsigned(rhs);
+			});
+			return std::pair(to_ordered_unsigned(*min), std::uint64_t(to_ordered_unsigned(*max) - to_ordered_unsigned(*min)) + 1);
+		}();
+
+		template<typename E>
+		constexpr bool is_dense_enum = enum_range<E>.second > 0 && enum_range<E>.second <= enum_value_count<E> * 2 + 8;
+
+		template<typename E>
+		struct enum_name_entry {
+			decltype(to_ordered_unsigned(E())) value;
+			std::string_view name;
+		};
+
+		// Names indexed by value - min value if E is dense, or sorted by value otherwise
+		template<typename E>
+		constexpr auto enum_name_table = [] {
+			if constexpr (is_dense_enum<E>) {
+				std::array<std::string_view, enum_range<E>.second> ret{};
+				for (std::size_t i = enum_value_count<E>; i-- > 0;) // Iterate backwards so that the first name wins for aliases
+					ret[to_ordered_unsigned(enum_values<E>[i]) - enum_range<E>.first] = enum_names<E>[i];
+				return ret;
+			}
+			else {
+				// Insertion sort, as it's stable (so that the first name wins for aliases) and std::stable_sort isn't constexpr
+				std::array<enum_name_entry<E>, enum_value_count<E>> ret{};
+				for (std::size_t i = 0; i < ret.size(); ++i) {
+					const enum_name_entry<E> entry{ to_ordered_unsigned(enum_values<E>[i]), enum_names<E>[i] };
+					auto j = i;
+					for (; j > 0 && entry.value < ret[j - 1].value; --j)
+						ret[j] = ret[j - 1];
+					ret[j] = entry;
+				}
+				return ret;
+			}
+		}();
+
+		template<typename E>
+		constexpr auto enum_name_index = make_perfect_name_index(enum_names<E>);
+	}
+
+	template<typename E>
+	constexpr std::string_view enum_to_string(E value) noexcept {
+		constexpr auto & table = detail::enum_name_table<E>;
+		const auto key = detail::to_ordered_unsigned(value);
+
+		if constexpr (detail::is_dense_enum<E>) {
+			const auto index = std::uint64_t(key - detail::enum_range<E>.first);
+			if (key < detail::enum_range<E>.first || index >= table.size())
+				return {};
+			return table[index];
+		}
+		else {
+			const auto it = std::lower_bound(table.begin(), table.end(), key, [](const auto & entry, auto key) {
+				return entry.value < key;
+			});
+			if (it == table.end() || it->value != key)
+				return {};
+			return it->name;
+		}
+	}
+
+	template<typename E>
+	constexpr std::optional<E> enum_from_string(std::string_view name) noexcept {
+		const auto index = detail::enum_name_index<E>.find(name);
+		if (!index)
+			return std::nullopt;
+		return detail::enum_values<E>[*index];
+	}
+
+	template<typename T, metadata_key Key>
+	consteval bool has_metadata() noexcept {
+		return has_metadata(get_metadata<T>(), Key.view());
+	}
+
+	template<typename Ret, typename T, metadata_key Key>
+	consteval const Ret * get_metadata() noexcept {
+		return get_metadata<Ret>(get_metadata<T>(), Key.view());
+	}
+
+	template<typename T, metadata_key Key>
+	constexpr bool has_attribute_metadata(std::string_view attribute putils_impl_reflection_lookup_location) noexcept {
+		putils_impl_reflection_profile_lookup(T, attribute, 1); // single hash table probe
+		const auto index = detail::attribute_name_index<T>.find(attribute);
+		return index && detail::attribute_metadata_flags<T, Key>[*index];
+	}
+
+	template<typename Ret, typename T, metadata_key Key>
+	constexpr const Ret * get_attribute_metadata(std::string_view attribute putils_impl_reflection_lookup_location) noexcept {
+		putils_impl_reflection_profile_lookup(T, attribute, 1); // single hash table probe
+		const auto index = detail::attribute_name_index<T>.find(attribute);
+		return index ? detail::attribute_metadata_pointers<Ret, T, Key>[*index] : nullptr;
+	}
+
+	template<typename T, metadata_key Key>
+	constexpr bool has_method_metadata(std::string_view method) noexcept {
+		const auto index = detail::method_name_index<T>.find(method);
+		return index && detail::method_metadata_flags<T, Key>[*index];
+	}
+
+	template<typename Ret, typename T, metadata_key Key>
+	constexpr const Ret * get_method_metadata(std::string_view method) noexcept {
+		const auto index = detail::method_name_index<T>.find(method);
+		return index ? detail::method_metadata_pointers<Ret, T, Key>[*index] : nullptr;
+	}
+
+	template<typename T, metadata_key Key>
+	consteval const auto & get_attributes_with_metadata() noexcept {
+		return detail::attributes_with_metadata<T, Key>;
+	}
+
+	template<typename T, metadata_key Key, typename Func>
+	constexpr void for_each_attribute_with_metadata(Func && func) noexcept {
+		constexpr auto & indices = detail::attributes_with_metadata<T, Key>;
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			(func(std::get<indices[Is]>(get_attributes<T>())), ...);
+		}(std::make_index_sequence<indices.size()>());
+	}
 }
@@ -0,0 +1,88 @@
+module;
+
+// The library is declared in the global module fragment, and its public API exported below
+// Macros can't be exported: include "putils/reflection_macros.hpp" along with `import putils.reflection;`
+#include "putils/reflection.hpp"
+
+export module putils.reflection;
+
+export namespace putils::reflection {
+	// Reflection info
+	using putils::reflection::type_info;
+	using putils::reflection::attribute_info;
+	using putils::reflection::method_info;
+	using putils::reflection::object_attribute_info;
+	using putils::reflection::object_method_info;
+	using putils::reflection::used_type_info;
+	using putils::reflection::enum_value_info;
+
+	using putils::reflection::is_reflectible;
+	using putils::reflection::reflectible;
+
+	// Class name
+	using putils::reflection::has_class_name;
+	using putils::reflection::with_class_name;
+	using putils::reflection::get_class_name;
+
+	// Parents
+	using putils::reflection::has_parents;
+	using putils::reflection::with_parents;
+	using putils::reflection::get_parents;
+	using putils::reflection::for_each_parent;
+	using putils::reflection::has_parent;
+
+	// Used types
+	using putils::reflection::has_used_types;
+	using putils::reflection::with_used_types;
+	using putils::reflection::get_used_types;
+	using putils::reflection::for_each_used_type;
+	using putils::reflection::has_used_type;
+
+	// Attributes
+	using putils::reflection::has_attributes;
+	using putils::reflection::with_attributes;
+	using putils::reflection::get_attributes;
+	using putils::reflection::for_each_attribute;
+	using putils::reflection::for_each_attribute_zip;
+	using putils::reflection::has_attribute;
+	using putils::reflection::get_attribute;
+	using putils::reflection::visit_attribute;
+	using putils::reflection::get_attribute_by_index;
+
+	// Methods
+	using putils::reflection::has_methods;
+	using putils::reflection::with_methods;
+	using putils::reflection::get_methods;
+	using putils::reflection::for_each_method;
+	using putils::reflection::has_method;
+	using putils::reflection::get_method;
+
+	// Enums
+	using putils::reflection::has_values;
+	using putils::reflection::with_values;
+	using putils::reflection::get_values;
+	using putils::reflection::for_each_value;
+	using putils::reflection::enum_to_string;
+	using putils::reflection::enum_from_string;
+
+	// Metadata
+	using putils::reflection::has_metadata;
+	using putils::reflection::get_metadata;
+	using putils::reflection::has_attribute_metadata;
+	using putils::reflection::get_attribute_metadata;
+	using putils::reflection::has_method_metadata;
+	using putils::reflection::get_method_metadata;
+	using putils::reflection::metadata_key;
+	using putils::reflection::get_attributes_with_metadata;
+	using putils::reflection::for_each_attribute_with_metadata;
+}
+
+// Used by the reflection macros
+export namespace putils {
+	using putils::table;
+	using putils::make_table;
+}
+
+export namespace putils::meta {
+	using putils::meta::type;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// stl
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+// reflection
+#include "putils/reflection.hpp"
+#include "type_id.hpp"
+
+namespace putils::reflection {
+	// Functions and information for one attribute of one type, stored statically
+	struct attribute_vtable {
+		std::string_view name;
+		type_id type; // without const
+		bool is_const;
+		void * (*get_address)(void * obj) noexcept;
+		std::to_chars_result (*to_chars)(const void * obj, char * first, char * last) noexcept;
+		std::size_t (*formatted_size)(const void * obj) noexcept;
+		// Assign a value of one of detail::attribute_ref::convertible_values, identified by `value_type`. Returns false if the attribute can't be assigned it
+		bool (*assign)(void * obj, type_id value_type, const void * value) noexcept;
+	};
+
+	// Type-erased reference to an attribute of an object, for code that can't be templated (scripting, editors...)
+	// Holds a pointer to the object and one to the attribute's static attribute_vtable: it is trivially copyable and never allocates
+	// The object must outlive the reference
+	class attribute_ref {
+	public:
+		constexpr attribute_ref() noexcept = default;
+		constexpr attribute_ref(void * object, const attribute_vtable & vtable) noexcept;
+
+		constexpr explicit operator bool() const noexcept;
+
+		constexpr std::string_view get_name() const noexcept;
+		constexpr type_id get_type() const noexcept;
+		constexpr bool is_const() const noexcept;
+
+		// Get a pointer to the attribute, or nullptr if it isn't an Attribute, or if it's const and Attribute isn't
+		template<typename Attribute>
+		Attribute * get() const noexcept;
+
+		// Assign `value` to the attribute. Returns false if the attribute is const or can't be assigned `value`:
+		//	- any value can be assigned to an attribute of the same type (std::decay_t<Value>)
+		//	- arithmetic values can be assigned to arithmetic attributes, e.g. `set(1)` on a float
+		//	- strings (const char *, std::string_view, std::string) can be assigned to non-arithmetic attributes they're assignable to, e.g. `set("x")` on a std::string
+		// Other conversions can't be looked up through the type-erased attribute, so they require an exact type match
+		template<typename Value>
+		bool set(Value && value) const noexcept;
+
+		// Format the attribute's value, as putils::reflection::to_chars
+		// Attributes to_chars can't write return `{ first, std::errc::not_supported }`, and a formatted_size of 0
+		std::to_chars_result to_chars(char * first, char * last) const noexcept;
+		std::size_t formatted_size() const noexcept;
+
+	private:
+		void * _object = nullptr;
+		const attribute_vtable * _vtable = nullptr;
+	};
+
+	// Get a reference to the attribute called `name` in obj, or an empty attribute_ref
+	template<typename T>
+	attribute_ref get_attribute_ref(T & obj, std::string_view name) noexcept;
+
+	// For each attribute in obj, get an attribute_ref
+	template<typename T, typename Func> // Func: void(attribute_ref)
+	void for_each_attribute_ref(T & obj, Func && func) noexcept;
+}
+
+#include "attribute_ref.inl"
@@ -0,0 +1,158 @@
+#include "attribute_ref.hpp"
+
+// stl
+#include <array>
+
+// meta
+#include "putils/meta/fwd.hpp"
+
+// reflection
+#include "to_chars.hpp"
+
+namespace putils::reflection {
+	namespace detail::attribute_ref {
+		// Types of the values attribute_ref::set converts to the attribute's type
+		using convertible_values = std::tuple<
+			bool, char, signed char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long, long long, unsigned long long,
+			float, double, long double,
+			const char *, std::string_view, std::string>;
+
+		template<typename Value, typename Values = convertible_values>
+		constexpr bool is_convertible_value = false;
+
+		template<typename Value, typename... Values>
+		constexpr bool is_convertible_value<Value, std::tuple<Values...>> = (std::is_same_v<Value, Values> || ...);
+
+		// Arithmetic values only convert to arithmetic attributes, so that e.g. a char isn't assigned to a std::string
+		template<typename Member, typename Value>
+		constexpr bool can_assign = std::is_assignable_v<Member &, const Value &> && std::is_arithmetic_v<Member> == std::is_arithmetic_v<Value>;
+
+		template<typename Member, typename... Values>
+		bool assign(void * member, type_id value_type, const void * value, std::tuple<Values...> *) noexcept {
+			bool ret = false;
+			([&] {
+				if constexpr (can_assign<Member, Values>) {
+					if (!ret && value_type == get_type_id<Values>()) {
+						*static_cast<Member *>(member) = *static_cast<const Values *>(value);
+						ret = true;
+					}
+				}
+			}(),
+			 ...);
+			return ret;
+		}
+
+		// T may be const, in which case all its attributes are
+		template<typename T, std::size_t I>
+		constexpr attribute_vtable make_vtable() noexcept {
+			constexpr auto & attr = std::get<I>(get_attributes<std::remove_const_t<T>>());
+			using member = std::remove_reference_t<decltype(std::declval<T &>().*attr.ptr)>;
+
+			return {
+				.name = attr.name,
+				.type = get_type_id<std::remove_const_t<member>>(),
+				.is_const = std::is_const_v<member>,
+				.get_address = [](void * obj) noexcept -> void * {
+					return const_cast<std::remove_const_t<member> *>(&(static_cast<T *>(obj)->*attr.ptr));
+				},
+				.to_chars = [](const void * obj, char * first, char * last) noexcept {
+					if constexpr (writable<std::remove_const_t<member>>)
+						return putils::reflection::to_chars(first, last, static_cast<const T *>(obj)->*attr.ptr);
+					else
+						return std::to_chars_result{ first, std::errc::not_supported };
+				},
+				.formatted_size = [](const void * obj) noexcept {
+					if constexpr (writable<std::remove_const_t<member>>)
+						return putils::reflection::formatted_size(static_cast<const T *>(obj)->*attr.ptr);
+					else
+						return std::size_t(0);
+				},
+				.assign = [](void * obj, type_id value_type, const void * value) noexcept {
+					if constexpr (std::is_const_v<member>)
+						return false;
+					else
+						return assign<member>(&(static_cast<T *>(obj)->*attr.ptr), value_type, value, static_cast<convertible_values *>(nullptr));
+				},
+			};
+		}
+
+		template<typename T, std::size_t I>
+		constexpr attribute_vtable vtable = make_vtable<T, I>();
+
+		template<typename T>
+		constexpr auto vtables = []<std::size_t... Is>(std::index_sequence<Is...>) {
+			return std::array<const attribute_vtable *, sizeof...(Is)>{ &vtable<T, Is>... };
+		}(std::make_index_sequence<std::tuple_size_v<putils_typeof(get_attributes<std::remove_const_t<T>>())>>());
+	}
+
+	constexpr attribute_ref::attribute_ref(void * object, const attribute_vtable & vtable) noexcept
+		: _object(object),
+		  _vtable(&vtable) {}
+
+	constexpr attribute_ref::operator bool() const noexcept {
+		return _vtable != nullptr;
+	}
+
+	constexpr std::string_view attribute_ref::get_name() const noexcept {
+		return _vtable ? _vtable->name : std::string_view{};
+	}
+
+	constexpr type_id attribute_ref::get_type() const noexcept {
+		return _vtable ? _vtable->type : nullptr;
+	}
+
+	constexpr bool attribute_ref::is_const() const noexcept {
+		return _vtable && _vtable->is_const;
+	}
+
+	template<typename Attribute>
+	Attribute * attribute_ref::get() const noexcept {
+		if (!_vtable || _vtable->type != get_type_id<std::remove_const_t<Attribute>>())
+			return nullptr;
+		if (_vtable->is_const && !std::is_const_v<Attribute>)
+			return nullptr;
+		return static_cast<Attribute *>(_vtable->get_address(_object));
+	}
+
+	template<typename Value>
+	bool attribute_ref::set(Value && value) const noexcept {
+		using value_type = std::decay_t<Value>;
+		if (const auto attribute = get<value_type>()) {
+			*attribute = FWD(value);
+			return true;
+		}
+
+		if constexpr (detail::attribute_ref::is_convertible_value<value_type>) {
+			if (!_vtable || _vtable->is_const)
+				return false;
+			const value_type converted = value; // decays string literals
+			return _vtable->assign(_object, get_type_id<value_type>(), &converted);
+		}
+		else
+			return false;
+	}
+
+	inline std::to_chars_result attribute_ref::to_chars(char * first, char * last) const noexcept {
+		if (!_vtable)
+			return { first, std::errc::invalid_argument };
+		return _vtable->to_chars(_object, first, last);
+	}
+
+	inline std::size_t attribute_ref::formatted_size() const noexcept {
+		return _vtable ? _vtable->formatted_size(_object) : 0;
+	}
+
+	template<typename T>
+	attribute_ref get_attribute_ref(T & obj, std::string_view name) noexcept {
+		const auto index = detail::attribute_name_index<std::remove_const_t<T>>.find(name);
+		if (!index)
+			return {};
+		return { const_cast<std::remove_const_t<T> *>(&obj), *detail::attribute_ref::vtables<T>[*index] };
+	}
+
+	template<typename T, typename Func>
+	void for_each_attribute_ref(T & obj, Func && func) noexcept {
+		for (const auto vtable : detail::attribute_ref::vtables<T>)
+			func(attribute_ref(const_cast<std::remove_const_t<T> *>(&obj), *vtable));
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// stl
+#include <string_view>
+
+// reflection
+#include "putils/reflection.hpp"
+
+// Support for the constexpr tables generated by scripts/bake_tables.py
+
+namespace putils::reflection {
+	// Assign a string from a data file to `member`, at compile-time:
+	//	- reflectible enums are looked up by name, and unknown names fail to compile
+	//	- const char * is assigned the string's data (which comes from a literal, so is null-terminated)
+	//	- other types are constructed from the std::string_view
+	template<typename Member>
+	constexpr void bake_value(Member & member, std::string_view value) noexcept;
+
+	// Whether `path` names an attribute of T, going through reflected attribute names
+	// Nested attributes and fixed-size array elements are separated by '.', e.g. "position.x" or "loot.0"
+	template<typename T>
+	consteval bool has_attribute_path(std::string_view path) noexcept;
+
+	// Assign a value from a data file to the attribute of `obj` named by `path`, at compile-time
+	// `text` is the value as written in the data file, and `number` its value if it's a number or a boolean
+	// The attribute's type picks which one is used:
+	//	- booleans are assigned `number`, which must be a bool
+	//	- arithmetic types and unreflected enums are assigned `number`, which must not lose precision
+	//	- other types are assigned `text` through bake_value
+	// Unknown paths and values that don't fit the attribute fail to compile
+	template<typename T>
+	constexpr void bake_attribute(T & obj, std::string_view path, std::string_view text) noexcept;
+
+	template<typename T, typename Number>
+	constexpr void bake_attribute(T & obj, std::string_view path, std::string_view text, Number number) noexcept;
+}
+
+#include "bake.inl"
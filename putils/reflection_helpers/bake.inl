@@ -0,0 +1,192 @@
+#include "bake.hpp"
+
+// stl
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+namespace putils::reflection {
+	namespace detail::bake {
+		// Not constexpr: calling them in a baked table's initializer makes the compiler report it
+		inline void unknown_enum_value() noexcept {}
+		inline void unknown_attribute() noexcept {}
+		inline void invalid_value() noexcept {}
+
+		template<typename T>
+		concept fixed_size_array = std::is_array_v<T> || requires(T & obj) {
+			std::tuple_size<T>::value;
+			obj[0];
+		};
+
+		template<typename T>
+		constexpr std::size_t array_size = [] {
+			if constexpr (std::is_array_v<T>)
+				return std::extent_v<T>;
+			else
+				return std::tuple_size<T>::value;
+		}();
+
+		template<typename T>
+		using array_element = std::remove_reference_t<decltype(std::declval<T &>()[0])>;
+
+		constexpr std::optional<std::size_t> parse_index(std::string_view text) noexcept {
+			if (text.empty())
+				return std::nullopt;
+
+			std::size_t ret = 0;
+			for (const char c : text) {
+				if (c < '0' || c > '9')
+					return std::nullopt;
+				ret = ret * 10 + std::size_t(c - '0');
+			}
+			return ret;
+		}
+
+		// First component of a path, and the rest of it (if any)
+		struct path_components {
+			std::string_view head;
+			std::optional<std::string_view> tail;
+		};
+
+		constexpr path_components split_path(std::string_view path) noexcept {
+			const auto dot = path.find('.');
+			if (dot == std::string_view::npos)
+				return { path, std::nullopt };
+			return { path.substr(0, dot), path.substr(dot + 1) };
+		}
+
+		// Call `func(member &)` for the attribute of `obj` named by `path`. Returns false if there's none
+		template<typename T, typename Func>
+		constexpr bool visit_path(T & obj, std::string_view path, Func && func) noexcept {
+			const auto [head, tail] = split_path(path);
+			const auto visit_member = [&](auto & member) noexcept {
+				if (!tail) {
+					func(member);
+					return true;
+				}
+				return visit_path(member, *tail, func);
+			};
+
+			if constexpr (has_attributes<T>()) {
+				bool found = false;
+				for_each_attribute(obj, [&](const auto & attr) noexcept {
+					if (!found && head == attr.name)
+						found = visit_member(attr.member);
+				});
+				return found;
+			}
+			else if constexpr (fixed_size_array<T>) {
+				const auto index = parse_index(head);
+				if (!index || *index >= array_size<T>)
+					return false;
+				return visit_member(obj[*index]);
+			}
+			else
+				return false;
+		}
+
+		// Arithmetic types and enums without reflected values are read from numbers
+		template<typename T>
+		concept number = std::is_arithmetic_v<T> || (std::is_enum_v<T> && !has_values<T>());
+
+		template<typename Member>
+		constexpr void assign(Member & member, std::string_view text) noexcept {
+			if constexpr (number<Member>)
+				invalid_value();
+			else
+				bake_value(member, text);
+		}
+
+		template<typename Member, typename Number>
+		constexpr void assign(Member & member, std::string_view text, Number value) noexcept {
+			if constexpr (std::is_same_v<Member, bool>) {
+				if constexpr (std::is_same_v<Number, bool>)
+					member = value;
+				else
+					invalid_value();
+			}
+			else if constexpr (number<Member>) {
+				if constexpr (std::is_same_v<Number, bool>)
+					invalid_value();
+				else {
+					member = static_cast<Member>(value);
+					// Reject "1.5" or out-of-range values for integers. Floating-point values are rounded to the closest
+					if constexpr (!std::is_floating_point_v<Member>)
+						if (static_cast<Number>(member) != value)
+							invalid_value();
+				}
+			}
+			else
+				assign(member, text);
+		}
+
+		template<typename T>
+		constexpr bool has_attribute_path(std::string_view path) noexcept {
+			const auto [head, tail] = split_path(path);
+
+			if constexpr (has_attributes<T>()) {
+				bool found = false;
+				for_each_attribute<T>([&](const auto & attr) noexcept {
+					using member_type = std::remove_cvref_t<decltype(std::declval<T &>().*attr.ptr)>;
+					if (!found && head == attr.name)
+						found = !tail || has_attribute_path<member_type>(*tail);
+				});
+				return found;
+			}
+			else if constexpr (fixed_size_array<T>) {
+				const auto index = parse_index(head);
+				if (!index || *index >= array_size<T>)
+					return false;
+				return !tail || has_attribute_path<std::remove_cv_t<array_element<T>>>(*tail);
+			}
+			else
+				return false;
+		}
+	}
+
+	template<typename Member>
+	constexpr void bake_value(Member & member, std::string_view value) noexcept {
+		if constexpr (std::is_enum_v<Member> && has_values<Member>()) {
+			const auto enum_value = enum_from_string<Member>(value);
+			if (!enum_value)
+				detail::bake::unknown_enum_value();
+			else
+				member = *enum_value;
+		}
+		else if constexpr (std::is_same_v<Member, const char *>)
+			member = value.data();
+		else if constexpr (std::is_constructible_v<Member, std::string_view>)
+			member = Member(value);
+		else
+			detail::bake::invalid_value();
+	}
+
+	template<typename T>
+	consteval bool has_attribute_path(std::string_view path) noexcept {
+		return detail::bake::has_attribute_path<T>(path);
+	}
+
+	template<typename T>
+	constexpr void bake_attribute(T & obj, std::string_view path, std::string_view text) noexcept {
+		const bool found = detail::bake::visit_path(obj, path, [&](auto & member) noexcept {
+			if constexpr (std::is_const_v<std::remove_reference_t<decltype(member)>>)
+				detail::bake::invalid_value();
+			else
+				detail::bake::assign(member, text);
+		});
+		if (!found)
+			detail::bake::unknown_attribute();
+	}
+
+	template<typename T, typename Number>
+	constexpr void bake_attribute(T & obj, std::string_view path, std::string_view text, Number number) noexcept {
+		const bool found = detail::bake::visit_path(obj, path, [&](auto & member) noexcept {
+			if constexpr (std::is_const_v<std::remove_reference_t<decltype(member)>>)
+				detail::bake::invalid_value();
+			else
+				detail::bake::assign(member, text, number);
+		});
+		if (!found)
+			detail::bake::unknown_attribute();
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// stl
+#include <coroutine>
+#include <cstddef>
+#include <span>
+
+// reflection
+#include "putils/reflection.hpp"
+#include "binary_serializer.hpp"
+
+namespace putils::reflection {
+	namespace detail::binary_decoder {
+		// Chunk being decoded, and the read waiting for more bytes
+		struct input {
+			std::span<const char> chunk;
+			std::size_t offset = 0;
+			char * pending_dest = nullptr;
+			std::size_t pending_size = 0;
+			std::coroutine_handle<> suspended;
+			std::coroutine_handle<> next; // task to resume once the current one suspends
+
+			// Copy as much of the pending read as possible. Returns true if it's complete
+			bool fill_pending() noexcept;
+		};
+
+		class task;
+	}
+
+	// Incremental decoder for the format written by to_binary, for input received in chunks of arbitrary size
+	// Decoding is a coroutine that suspends when a chunk is exhausted, possibly in the middle of an attribute, and resumes with the next chunk
+	// Bytes are copied straight from the chunks into the object, and containers grow with the bytes received rather than with their encoded size,
+	// so only the current chunk needs to be kept in memory
+	// The decoder references the object, which must outlive it
+	template<typename T>
+	class binary_decoder {
+	public:
+		explicit binary_decoder(T & obj) noexcept;
+		~binary_decoder() noexcept;
+
+		binary_decoder(const binary_decoder &) = delete;
+		binary_decoder & operator=(const binary_decoder &) = delete;
+
+		// Decode the bytes in `chunk`, which doesn't need to outlive the call
+		// Returns the number of bytes consumed, which is less than chunk.size() if the object was completed before the end of the chunk
+		std::size_t feed(std::span<const char> chunk) noexcept;
+
+		// Whether the object has been completely decoded
+		bool is_done() const noexcept;
+
+	private:
+		detail::binary_decoder::input _input;
+		std::coroutine_handle<> _root;
+	};
+}
+
+#include "binary_decoder.inl"
@@ -0,0 +1,256 @@
+#include "binary_decoder.hpp"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+namespace putils::reflection {
+	namespace detail::binary_decoder {
+		inline bool input::fill_pending() noexcept {
+			if (pending_size == 0)
+				return true;
+
+			const auto size = std::min(pending_size, chunk.size() - offset);
+			std::memcpy(pending_dest, chunk.data() + offset, size);
+			offset += size;
+			pending_dest += size;
+			pending_size -= size;
+			return pending_size == 0;
+		}
+
+		// Coroutine decoding a part of the object, started when awaited and resuming its parent when it completes
+		// Tasks don't resume each other directly: they set `input::next` and suspend back to binary_decoder::feed, which resumes it.
+		// Symmetric transfer would also avoid nesting stack frames, but only when the compiler turns it into a tail call, which it may not do in debug builds
+		class task {
+		public:
+			struct promise_type {
+				input & in;
+				std::coroutine_handle<> parent;
+
+				// All tasks take the input as their first parameter
+				template<typename... Args>
+				promise_type(input & in, Args &...) noexcept
+					: in(in) {}
+
+				task get_return_object() noexcept {
+					return task(std::coroutine_handle<promise_type>::from_promise(*this));
+				}
+
+				std::suspend_always initial_suspend() noexcept { return {}; }
+
+				auto final_suspend() noexcept {
+					struct resume_parent {
+						bool await_ready() noexcept { return false; }
+						void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+							auto & promise = handle.promise();
+							promise.in.next = promise.parent;
+						}
+						void await_resume() noexcept {}
+					};
+					return resume_parent{};
+				}
+
+				void return_void() noexcept {}
+				void unhandled_exception() noexcept { std::terminate(); }
+			};
+
+			explicit task(std::coroutine_handle<promise_type> handle) noexcept
+				: _handle(handle) {}
+
+			task(task && rhs) noexcept
+				: _handle(std::exchange(rhs._handle, nullptr)) {}
+
+			~task() noexcept {
+				if (_handle)
+					_handle.destroy();
+			}
+
+			// Release the coroutine, for the root task owned by binary_decoder
+			std::coroutine_handle<> release() noexcept {
+				return std::exchange(_handle, nullptr);
+			}
+
+			bool await_ready() noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> parent) noexcept {
+				auto & promise = _handle.promise();
+				promise.parent = parent;
+				promise.in.next = _handle;
+			}
+
+			void await_resume() noexcept {}
+
+		private:
+			std::coroutine_handle<promise_type> _handle;
+		};
+
+		// Read `size` bytes into `dest`, suspending until they've all been received
+		// This doesn't need a coroutine frame, so scalars are read without allocating
+		struct read_bytes {
+			input & in;
+			void * dest;
+			std::size_t size;
+			bool little_endian;
+
+			bool await_ready() noexcept {
+				in.pending_dest = static_cast<char *>(dest);
+				in.pending_size = size;
+				return in.fill_pending();
+			}
+
+			void await_suspend(std::coroutine_handle<> handle) noexcept {
+				in.suspended = handle;
+			}
+
+			void await_resume() noexcept {
+				if constexpr (std::endian::native != std::endian::little)
+					if (little_endian)
+						std::reverse(static_cast<char *>(dest), static_cast<char *>(dest) + size);
+			}
+		};
+
+		template<typename T>
+		auto read(input & in, T & obj) noexcept;
+
+		template<typename T>
+		constexpr auto read_attribute_count = [] {
+			std::size_t ret = 0;
+			for_each_attribute<T>([&](const auto & attr) noexcept {
+				using member = putils::member_type<putils_typeof(attr.ptr)>;
+				if constexpr (!std::is_const_v<member>)
+					++ret;
+			});
+			return ret;
+		}();
+
+		// Indices of the non-const attributes, which are the ones written by to_binary
+		template<typename T>
+		constexpr auto read_attributes = [] {
+			std::array<std::size_t, read_attribute_count<T>> ret{};
+			std::size_t index = 0;
+			std::size_t i = 0;
+			for_each_attribute<T>([&](const auto & attr) noexcept {
+				using member = putils::member_type<putils_typeof(attr.ptr)>;
+				if constexpr (!std::is_const_v<member>)
+					ret[i++] = index;
+				++index;
+			});
+			return ret;
+		}();
+
+		template<typename T, std::size_t... Is>
+		task read_object(input & in, T & obj, std::index_sequence<Is...>) noexcept {
+			(co_await read(in, obj.*std::get<read_attributes<T>[Is]>(get_attributes<T>()).ptr), ...);
+			co_return;
+		}
+
+		template<typename T>
+		task read_contiguous_block(input & in, T & obj) noexcept {
+			using element = typename T::value_type;
+
+			binary::size_type size;
+			co_await read_bytes{ in, &size, sizeof(size), true };
+
+			// Grow with the bytes received, so a corrupted size doesn't allocate more than was actually sent
+			// The container is never resized while a read into it is pending
+			obj.resize(0);
+			std::size_t read_count = 0;
+			while (read_count < size) {
+				const auto available = (in.chunk.size() - in.offset) / sizeof(element);
+				const auto count = std::clamp<std::size_t>(available, 1, size - read_count);
+				obj.resize(read_count + count);
+				co_await read_bytes{ in, obj.data() + read_count, count * sizeof(element), false };
+				read_count += count;
+			}
+		}
+
+		template<typename T>
+		task read_resizable(input & in, T & obj) noexcept {
+			binary::size_type size;
+			co_await read_bytes{ in, &size, sizeof(size), true };
+
+			obj.resize(0);
+			for (std::size_t i = 0; i < size; ++i) {
+				obj.resize(i + 1);
+				auto && element = *std::next(obj.begin(), std::ptrdiff_t(i));
+				if constexpr (std::is_reference_v<decltype(*obj.begin())>)
+					co_await read(in, element);
+				else { // Proxy references, e.g. std::vector<bool>
+					typename T::value_type value;
+					co_await read(in, value);
+					element = value;
+				}
+			}
+		}
+
+		template<typename T>
+		task read_fixed_size_range(input & in, T & obj) noexcept {
+			for (auto & element : obj)
+				co_await read(in, element);
+		}
+
+		template<typename T>
+		auto read(input & in, T & obj) noexcept {
+			if constexpr (binary::scalar<T>)
+				return read_bytes{ in, &obj, sizeof(T), true };
+			else if constexpr (binary::object<T>)
+				return read_object(in, obj, std::make_index_sequence<read_attribute_count<T>>());
+			else if constexpr (binary::contiguous_block<T>)
+				return read_contiguous_block(in, obj);
+			else if constexpr (binary::resizable<T>)
+				return read_resizable(in, obj);
+			else if constexpr (binary::fixed_size_range<T>)
+				return read_fixed_size_range(in, obj);
+			else if constexpr (binary::raw<T>)
+				return read_bytes{ in, &obj, sizeof(T), false };
+			else
+				static_assert(std::is_void_v<T>, "Type cannot be read by binary_decoder");
+		}
+
+		template<typename T>
+		task read_root(input & in, T & obj) noexcept {
+			co_await read(in, obj);
+		}
+	}
+
+	template<typename T>
+	binary_decoder<T>::binary_decoder(T & obj) noexcept
+		: _root(detail::binary_decoder::read_root(_input, obj).release()) {
+		_input.suspended = _root;
+	}
+
+	template<typename T>
+	binary_decoder<T>::~binary_decoder() noexcept {
+		// Destroying the root also destroys the tasks it's awaiting
+		_root.destroy();
+	}
+
+	template<typename T>
+	std::size_t binary_decoder<T>::feed(std::span<const char> chunk) noexcept {
+		if (is_done())
+			return 0;
+
+		_input.chunk = chunk;
+		_input.offset = 0;
+		if (_input.fill_pending()) {
+			// Runs until the chunk is exhausted or the object is complete
+			_input.next = _input.suspended;
+			while (_input.next)
+				std::exchange(_input.next, nullptr).resume();
+		}
+
+		const auto consumed = _input.offset;
+		_input.chunk = {};
+		return consumed;
+	}
+
+	template<typename T>
+	bool binary_decoder<T>::is_done() const noexcept {
+		return _root.done();
+	}
+}
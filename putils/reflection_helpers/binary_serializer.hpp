@@ -0,0 +1,31 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	// Append the binary representation of `obj` to `out`:
+	//	- arithmetic types and enums are written in little-endian
+	//	- reflectible types are written as the sequence of their non-const attributes
+	//	- resizable containers (strings, vectors...) are prefixed with their size as a uint32, then written element by element,
+	//	  or as a single block of bytes if they're contiguous and their elements' encoding is their in-memory representation
+	//	  (e.g. reflectible types whose reflected attributes cover the whole object, without padding)
+	//	- string views are written like strings, but can only be read back into strings
+	//	- fixed-size arrays are written element by element
+	//	- other trivially copyable types are written as-is
+	// Pointers and views other than string views (e.g. std::span) are rejected at compile-time
+	template<typename T>
+	void to_binary(const T & obj, std::vector<char> & out) noexcept;
+
+	// Read `obj` from the beginning of `in`. Returns the number of bytes read, or nullopt if `in` is too short
+	template<typename T>
+	std::optional<std::size_t> from_binary(std::span<const char> in, T & obj) noexcept;
+}
+
+#include "binary_serializer.inl"
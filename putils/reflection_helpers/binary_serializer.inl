@@ -0,0 +1,331 @@
+#include "binary_serializer.hpp"
+
+// stl
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+namespace putils::reflection {
+	namespace detail::binary {
+		using size_type = std::uint32_t;
+
+		template<typename T>
+		concept scalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+		template<typename T>
+		concept object = !scalar<T> && has_attributes<T>();
+
+		template<typename T>
+		concept resizable = !object<T> && requires(T & obj) {
+			obj.begin();
+			obj.end();
+			obj.size();
+			obj.resize(std::size_t());
+		};
+
+		template<typename T>
+		concept fixed_size_range = !object<T> && !resizable<T> && (std::is_array_v<T> || requires(T & obj) {
+			obj.begin();
+			obj.end();
+			std::tuple_size<T>::value;
+		});
+
+		// Written as strings, but can't be read back as they don't own their characters
+		template<typename T>
+		concept string_view = requires { typename T::traits_type; } && std::is_same_v<T, std::basic_string_view<typename T::value_type, typename T::traits_type>>;
+
+		// Pointers and views (e.g. std::span) would be written as addresses, meaningless to whoever reads them
+		template<typename T>
+		concept pointer = std::is_pointer_v<T> || std::is_member_pointer_v<T>;
+
+		template<typename T>
+		concept view = !object<T> && !resizable<T> && !fixed_size_range<T> && requires(T & obj) {
+			obj.begin();
+			obj.end();
+		};
+
+		template<typename T>
+		concept raw = !scalar<T> && !object<T> && !resizable<T> && !fixed_size_range<T> && !pointer<T> && !view<T> && std::is_trivially_copyable_v<T>;
+
+		// Whether the encoding of a T is its in-memory representation, so that arrays of T can be copied as a single block
+		template<typename T>
+		constexpr bool is_bulk_copyable() noexcept {
+			if constexpr (!std::is_trivially_copyable_v<T>)
+				return false;
+			else if constexpr (scalar<T>)
+				return sizeof(T) == 1 || std::endian::native == std::endian::little;
+			else if constexpr (object<T>) {
+				// Padding, const attributes and attributes that aren't reflected aren't encoded
+				bool ret = true;
+				std::size_t size = 0;
+				for_each_attribute<T>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (std::is_const_v<member> || !is_bulk_copyable<member>())
+						ret = false;
+					else
+						size += sizeof(member);
+				});
+				return ret && size == sizeof(T);
+			}
+			else if constexpr (std::is_array_v<T>)
+				return is_bulk_copyable<std::remove_extent_t<T>>();
+			else if constexpr (fixed_size_range<T>)
+				return is_bulk_copyable<typename T::value_type>() && sizeof(T) == std::tuple_size<T>::value * sizeof(typename T::value_type);
+			else
+				return raw<T>;
+		}
+
+		template<typename T>
+		concept contiguous_block = resizable<T> && is_bulk_copyable<typename T::value_type>() && requires(T & obj) {
+			{ obj.data() } -> std::same_as<typename T::value_type *>;
+		};
+
+		// Copy `size` bytes, reversing them on big-endian platforms
+		inline void copy_little_endian(void * dest, const void * src, std::size_t size) noexcept {
+			if constexpr (std::endian::native == std::endian::little)
+				std::memcpy(dest, src, size);
+			else
+				std::reverse_copy((const char *)src, (const char *)src + size, (char *)dest);
+		}
+
+		// Smallest number of bytes an encoded T can take
+		template<typename T>
+		constexpr std::size_t get_min_encoded_size() noexcept {
+			if constexpr (scalar<T> || raw<T>)
+				return sizeof(T);
+			else if constexpr (object<T>) {
+				std::size_t ret = 0;
+				for_each_attribute<T>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (!std::is_const_v<member>)
+						ret += get_min_encoded_size<member>();
+				});
+				return ret;
+			}
+			else if constexpr (resizable<T>)
+				return sizeof(size_type);
+			else if constexpr (fixed_size_range<T>) {
+				if constexpr (std::is_array_v<T>)
+					return std::extent_v<T> * get_min_encoded_size<std::remove_extent_t<T>>();
+				else
+					return std::tuple_size<T>::value * get_min_encoded_size<typename T::value_type>();
+			}
+			else
+				return 0;
+		}
+
+		// Whether a T can be both written and read
+		template<typename T>
+		constexpr bool is_serializable() noexcept {
+			if constexpr (scalar<T> || raw<T>)
+				return true;
+			else if constexpr (object<T>) {
+				bool ret = true;
+				for_each_attribute<T>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (!std::is_const_v<member> && !is_serializable<member>())
+						ret = false;
+				});
+				return ret;
+			}
+			else if constexpr (resizable<T>)
+				return is_serializable<typename T::value_type>();
+			else if constexpr (std::is_array_v<T>)
+				return is_serializable<std::remove_extent_t<T>>();
+			else if constexpr (fixed_size_range<T>)
+				return is_serializable<typename T::value_type>();
+			else
+				return false;
+		}
+
+		// FNV-1a
+		constexpr std::uint64_t hash_combine(std::uint64_t hash, std::uint64_t value) noexcept {
+			for (std::size_t i = 0; i < sizeof(value); ++i) {
+				hash ^= (value >> (i * 8)) & 0xff;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		// Hash of the layout of an encoded T, identical for types that are encoded the same way
+		template<typename T>
+		constexpr std::uint64_t get_encoding_hash(std::uint64_t hash = 14695981039346656037ull) noexcept {
+			if constexpr (std::is_enum_v<T>)
+				return get_encoding_hash<std::underlying_type_t<T>>(hash);
+			else if constexpr (scalar<T>) {
+				// char's signedness depends on the platform, but not its encoding
+				const char kind = std::is_same_v<T, bool> ? 'b' : std::is_same_v<T, char> ? 'c' : std::is_floating_point_v<T> ? 'f' : std::is_signed_v<T> ? 'i' : 'u';
+				return hash_combine(hash_combine(hash, kind), sizeof(T));
+			}
+			else if constexpr (object<T>) {
+				hash = hash_combine(hash, '{');
+				for_each_attribute<T>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (!std::is_const_v<member>)
+						hash = get_encoding_hash<member>(hash);
+				});
+				return hash_combine(hash, '}');
+			}
+			else if constexpr (string_view<T> || resizable<T>)
+				return hash_combine(get_encoding_hash<typename T::value_type>(hash_combine(hash, '[')), ']');
+			else if constexpr (std::is_array_v<T>)
+				return get_encoding_hash<std::remove_extent_t<T>>(hash_combine(hash_combine(hash, '<'), std::extent_v<T>));
+			else if constexpr (fixed_size_range<T>)
+				return get_encoding_hash<typename T::value_type>(hash_combine(hash_combine(hash, '<'), std::tuple_size<T>::value));
+			else
+				return hash_combine(hash_combine(hash, 'r'), sizeof(T));
+		}
+
+		template<typename T>
+		void write(const T & obj, std::vector<char> & out) noexcept;
+
+		template<typename T>
+		bool read(std::span<const char> in, std::size_t & offset, T & obj) noexcept;
+
+		template<typename T>
+		void write_object(const T & obj, std::vector<char> & out) noexcept {
+			for_each_attribute<T>([&](const auto & attr) noexcept {
+				using member = putils::member_type<putils_typeof(attr.ptr)>;
+				if constexpr (!std::is_const_v<member>)
+					write(obj.*attr.ptr, out);
+			});
+		}
+
+		template<typename T>
+		bool read_object(std::span<const char> in, std::size_t & offset, T & obj) noexcept {
+			bool ok = true;
+			for_each_attribute<T>([&](const auto & attr) noexcept {
+				using member = putils::member_type<putils_typeof(attr.ptr)>;
+				if constexpr (!std::is_const_v<member>) {
+					if (ok)
+						ok = read(in, offset, obj.*attr.ptr);
+				}
+			});
+			return ok;
+		}
+
+		template<typename T>
+		void write(const T & obj, std::vector<char> & out) noexcept {
+			if constexpr (scalar<T>) {
+				const auto offset = out.size();
+				out.resize(offset + sizeof(T));
+				copy_little_endian(out.data() + offset, &obj, sizeof(T));
+			}
+			else if constexpr (object<T>)
+				write_object(obj, out);
+			else if constexpr (string_view<T>) {
+				write(size_type(obj.size()), out);
+				const auto bytes = (const char *)obj.data();
+				out.insert(out.end(), bytes, bytes + obj.size() * sizeof(typename T::value_type));
+			}
+			else if constexpr (contiguous_block<T>) {
+				write(size_type(obj.size()), out);
+				const auto bytes = (const char *)obj.data();
+				out.insert(out.end(), bytes, bytes + obj.size() * sizeof(typename T::value_type));
+			}
+			else if constexpr (resizable<T>) {
+				write(size_type(obj.size()), out);
+				for (const auto & element : obj)
+					write(element, out);
+			}
+			else if constexpr (fixed_size_range<T>) {
+				for (const auto & element : obj)
+					write(element, out);
+			}
+			else if constexpr (raw<T>) {
+				const auto bytes = (const char *)&obj;
+				out.insert(out.end(), bytes, bytes + sizeof(T));
+			}
+			else if constexpr (pointer<T> || view<T>)
+				static_assert(std::is_void_v<T>, "Pointers and views can't be written by to_binary, use std::string for strings");
+			else
+				static_assert(std::is_void_v<T>, "Type cannot be written by to_binary");
+		}
+
+		template<typename T>
+		bool read(std::span<const char> in, std::size_t & offset, T & obj) noexcept {
+			const auto remaining = in.size() - offset;
+
+			if constexpr (scalar<T>) {
+				if (remaining < sizeof(T))
+					return false;
+				copy_little_endian(&obj, in.data() + offset, sizeof(T));
+				offset += sizeof(T);
+				return true;
+			}
+			else if constexpr (object<T>)
+				return read_object(in, offset, obj);
+			else if constexpr (contiguous_block<T>) {
+				size_type size;
+				if (!read(in, offset, size))
+					return false;
+				const auto byte_size = std::size_t(size) * sizeof(typename T::value_type);
+				if (in.size() - offset < byte_size)
+					return false;
+				obj.resize(size);
+				std::memcpy(obj.data(), in.data() + offset, byte_size);
+				offset += byte_size;
+				return true;
+			}
+			else if constexpr (resizable<T>) {
+				size_type size;
+				if (!read(in, offset, size))
+					return false;
+				// Don't let a corrupted size allocate more elements than the remaining input can hold
+				// Elements that encode to nothing can't be checked this way, but don't carry any data either
+				constexpr auto element_size = get_min_encoded_size<typename T::value_type>();
+				if constexpr (element_size > 0)
+					if (std::size_t(size) > (in.size() - offset) / element_size)
+						return false;
+				obj.resize(size);
+				for (auto && element : obj) {
+					if constexpr (std::is_reference_v<decltype(*obj.begin())>) {
+						if (!read(in, offset, element))
+							return false;
+					}
+					else { // Proxy references, e.g. std::vector<bool>
+						typename T::value_type value;
+						if (!read(in, offset, value))
+							return false;
+						element = value;
+					}
+				}
+				return true;
+			}
+			else if constexpr (fixed_size_range<T>) {
+				for (auto & element : obj)
+					if (!read(in, offset, element))
+						return false;
+				return true;
+			}
+			else if constexpr (raw<T>) {
+				if (remaining < sizeof(T))
+					return false;
+				std::memcpy(&obj, in.data() + offset, sizeof(T));
+				offset += sizeof(T);
+				return true;
+			}
+			else if constexpr (pointer<T> || view<T>)
+				static_assert(std::is_void_v<T>, "Pointers and views can't be read by from_binary, use std::string for strings");
+			else
+				static_assert(std::is_void_v<T>, "Type cannot be read by from_binary");
+		}
+	}
+
+	template<typename T>
+	void to_binary(const T & obj, std::vector<char> & out) noexcept {
+		detail::binary::write(obj, out);
+	}
+
+	template<typename T>
+	std::optional<std::size_t> from_binary(std::span<const char> in, T & obj) noexcept {
+		std::size_t offset = 0;
+		if (!detail::binary::read(in, offset, obj))
+			return std::nullopt;
+		return offset;
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+// stl
+#include <optional>
+#include <span>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	// Encode a batch of reflectible objects column by column: the values of each (non-const, possibly nested) attribute are
+	// stored contiguously, with an encoding chosen from the attribute's type:
+	//	- integers: delta from the previous row, zigzag-encoded as a varint
+	//	- floating-point numbers: XOR with the previous row, with leading and trailing zero bytes omitted
+	//	- strings and enums: dictionary of distinct values, followed by a varint index per row
+	//	- reflectible types: one column per attribute
+	//	- others: written row by row with to_binary. Pointers are rejected at compile-time, as their values can't be read back
+	template<typename T>
+	void encode_columns(std::span<const T> objects, std::vector<char> & out) noexcept;
+
+	// Decode a batch written by encode_columns, appending the objects to `objects`
+	// Returns the number of bytes read, or nullopt if `in` is invalid
+	template<typename T>
+	std::optional<std::size_t> decode_columns(std::span<const char> in, std::vector<T> & objects) noexcept;
+}
+
+#include "columnar.inl"
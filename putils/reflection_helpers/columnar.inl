@@ -0,0 +1,266 @@
+#include "columnar.hpp"
+
+// stl
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+// reflection
+#include "binary_serializer.hpp"
+
+namespace putils::reflection {
+	namespace detail::columnar {
+		template<typename T>
+		concept object = has_attributes<T>();
+
+		template<typename T>
+		concept integer = std::is_integral_v<T>;
+
+		template<typename T>
+		concept floating_point = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+		template<typename T>
+		concept enumeration = std::is_enum_v<T>;
+
+		template<typename T>
+		concept string = !object<T> && std::is_convertible_v<const T &, std::string_view> && std::is_constructible_v<T, std::string_view>;
+
+		inline void write_varint(std::uint64_t value, std::vector<char> & out) noexcept {
+			while (value >= 0x80) {
+				out.push_back(char(value | 0x80));
+				value >>= 7;
+			}
+			out.push_back(char(value));
+		}
+
+		inline bool read_varint(std::span<const char> in, std::size_t & offset, std::uint64_t & value) noexcept {
+			value = 0;
+			for (unsigned shift = 0; shift < 64; shift += 7) {
+				if (offset >= in.size())
+					return false;
+				const auto byte = std::uint8_t(in[offset++]);
+				value |= std::uint64_t(byte & 0x7f) << shift;
+				if (!(byte & 0x80))
+					return true;
+			}
+			return false;
+		}
+
+		constexpr std::uint64_t zigzag(std::int64_t value) noexcept {
+			return (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63);
+		}
+
+		constexpr std::int64_t unzigzag(std::uint64_t value) noexcept {
+			return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+		}
+
+		// Integers are widened to 64 bits (sign-extended for signed types), so deltas wrap around consistently
+		template<integer I>
+		constexpr std::uint64_t to_bits(I value) noexcept {
+			return std::uint64_t(std::int64_t(value));
+		}
+
+		// Smallest number of bytes each row adds to Value's columns
+		template<typename Value>
+		constexpr std::size_t get_min_row_size() noexcept {
+			if constexpr (integer<Value> || floating_point<Value> || string<Value> || enumeration<Value>)
+				return 1; // varint, control byte or dictionary index
+			else if constexpr (object<Value>) {
+				std::size_t ret = 0;
+				for_each_attribute<Value>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (!std::is_const_v<member>)
+						ret += get_min_row_size<member>();
+				});
+				return ret;
+			}
+			else
+				return detail::binary::get_min_encoded_size<Value>();
+		}
+
+		template<typename Value, typename Get>
+		void encode_column(std::size_t count, Get && get, std::vector<char> & out) noexcept {
+			if constexpr (integer<Value>) {
+				std::uint64_t previous = 0;
+				for (std::size_t i = 0; i < count; ++i) {
+					const auto bits = to_bits(get(i));
+					write_varint(zigzag(std::int64_t(bits - previous)), out);
+					previous = bits;
+				}
+			}
+			else if constexpr (floating_point<Value>) {
+				using bits_type = std::conditional_t<sizeof(Value) == 8, std::uint64_t, std::uint32_t>;
+				bits_type previous = 0;
+				for (std::size_t i = 0; i < count; ++i) {
+					const auto bits = std::bit_cast<bits_type>(get(i));
+					const auto x = bits ^ previous;
+					previous = bits;
+
+					// Control byte: leading zero bytes in the high nibble, trailing zero bytes in the low one, followed by the other bytes
+					const auto leading = x == 0 ? sizeof(bits_type) : std::size_t(std::countl_zero(x) / 8);
+					const auto trailing = x == 0 ? 0 : std::size_t(std::countr_zero(x) / 8);
+					out.push_back(char((leading << 4) | trailing));
+					for (auto byte = trailing; byte < sizeof(bits_type) - leading; ++byte)
+						out.push_back(char(x >> (byte * 8)));
+				}
+			}
+			else if constexpr (string<Value> || enumeration<Value>) {
+				using key_type = std::conditional_t<string<Value>, std::string_view, Value>;
+				std::unordered_map<key_type, std::uint64_t> dictionary;
+				std::vector<std::uint64_t> indices;
+				std::vector<key_type> values;
+				indices.reserve(count);
+				for (std::size_t i = 0; i < count; ++i) {
+					const key_type key = get(i);
+					const auto [it, inserted] = dictionary.emplace(key, values.size());
+					if (inserted)
+						values.push_back(key);
+					indices.push_back(it->second);
+				}
+
+				write_varint(values.size(), out);
+				for (const auto & value : values) {
+					if constexpr (string<Value>) {
+						write_varint(value.size(), out);
+						out.insert(out.end(), value.begin(), value.end());
+					}
+					else
+						write_varint(zigzag(std::int64_t(value)), out);
+				}
+				for (const auto index : indices)
+					write_varint(index, out);
+			}
+			else if constexpr (object<Value>) {
+				for_each_attribute<Value>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (!std::is_const_v<member>)
+						encode_column<member>(count, [&](std::size_t i) noexcept -> const member & { return get(i).*attr.ptr; }, out);
+				});
+			}
+			else {
+				static_assert(!std::is_pointer_v<Value>, "Pointers can't be encoded by encode_columns");
+				for (std::size_t i = 0; i < count; ++i)
+					to_binary(get(i), out);
+			}
+		}
+
+		template<typename Value, typename Get>
+		bool decode_column(std::span<const char> in, std::size_t & offset, std::size_t count, Get && get) noexcept {
+			if constexpr (integer<Value>) {
+				std::uint64_t previous = 0;
+				for (std::size_t i = 0; i < count; ++i) {
+					std::uint64_t delta;
+					if (!read_varint(in, offset, delta))
+						return false;
+					previous += std::uint64_t(unzigzag(delta));
+					get(i) = Value(previous);
+				}
+				return true;
+			}
+			else if constexpr (floating_point<Value>) {
+				using bits_type = std::conditional_t<sizeof(Value) == 8, std::uint64_t, std::uint32_t>;
+				bits_type previous = 0;
+				for (std::size_t i = 0; i < count; ++i) {
+					if (offset >= in.size())
+						return false;
+					const auto control = std::uint8_t(in[offset++]);
+					const std::size_t leading = control >> 4;
+					const std::size_t trailing = control & 0xf;
+					if (leading + trailing > sizeof(bits_type))
+						return false;
+					const auto size = sizeof(bits_type) - leading - trailing;
+					if (in.size() - offset < size)
+						return false;
+
+					bits_type x = 0;
+					for (std::size_t byte = 0; byte < size; ++byte)
+						x |= bits_type(std::uint8_t(in[offset++])) << ((trailing + byte) * 8);
+					previous ^= x;
+					get(i) = std::bit_cast<Value>(previous);
+				}
+				return true;
+			}
+			else if constexpr (string<Value> || enumeration<Value>) {
+				std::uint64_t dictionary_size;
+				if (!read_varint(in, offset, dictionary_size) || dictionary_size > in.size() - offset)
+					return false;
+
+				using key_type = std::conditional_t<string<Value>, std::string_view, Value>;
+				std::vector<key_type> values(dictionary_size);
+				for (auto & value : values) {
+					std::uint64_t raw;
+					if (!read_varint(in, offset, raw))
+						return false;
+					if constexpr (string<Value>) {
+						if (raw > in.size() - offset)
+							return false;
+						value = std::string_view(in.data() + offset, raw);
+						offset += raw;
+					}
+					else
+						value = Value(unzigzag(raw));
+				}
+
+				for (std::size_t i = 0; i < count; ++i) {
+					std::uint64_t index;
+					if (!read_varint(in, offset, index) || index >= values.size())
+						return false;
+					get(i) = Value(values[index]);
+				}
+				return true;
+			}
+			else if constexpr (object<Value>) {
+				bool ok = true;
+				for_each_attribute<Value>([&](const auto & attr) noexcept {
+					using member = putils::member_type<putils_typeof(attr.ptr)>;
+					if constexpr (!std::is_const_v<member>) {
+						if (ok)
+							ok = decode_column<member>(in, offset, count, [&](std::size_t i) noexcept -> member & { return get(i).*attr.ptr; });
+					}
+				});
+				return ok;
+			}
+			else {
+				static_assert(!std::is_pointer_v<Value>, "Pointers can't be decoded by decode_columns");
+				for (std::size_t i = 0; i < count; ++i)
+					if (!detail::binary::read(in, offset, get(i)))
+						return false;
+				return true;
+			}
+		}
+	}
+
+	template<typename T>
+	void encode_columns(std::span<const T> objects, std::vector<char> & out) noexcept {
+		detail::columnar::write_varint(objects.size(), out);
+		detail::columnar::encode_column<T>(objects.size(), [&](std::size_t i) noexcept -> const T & { return objects[i]; }, out);
+	}
+
+	template<typename T>
+	std::optional<std::size_t> decode_columns(std::span<const char> in, std::vector<T> & objects) noexcept {
+		std::size_t offset = 0;
+		std::uint64_t count;
+		if (!detail::columnar::read_varint(in, offset, count))
+			return std::nullopt;
+
+		// Protect against huge counts in corrupted input. Rows that encode to nothing can't be checked this way
+		constexpr auto row_size = detail::columnar::get_min_row_size<T>();
+		if constexpr (row_size > 0) {
+			if (count > (in.size() - offset) / row_size)
+				return std::nullopt;
+		}
+		else if (count > objects.max_size() - objects.size())
+			return std::nullopt;
+
+		const auto first = objects.size();
+		objects.resize(first + count);
+		const auto get = [&](std::size_t i) noexcept -> T & { return objects[first + i]; };
+		if (!detail::columnar::decode_column<T>(in, offset, count, get)) {
+			objects.resize(first);
+			return std::nullopt;
+		}
+		return offset;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	// Convert between reflectible types by copying attributes with the same name
+	// A destination attribute can be converted from a differently-named source attribute with the "convert_from" metadata:
+	//		putils_reflection_attribute(pos, putils_reflection_metadata("convert_from", "position"))
+	// Attributes are copied if they have the same type, assigned if the destination type is assignable from the source type,
+	// or recursively converted if both are reflectible. Other pairs fail to compile
+	// Destination attributes with no source attribute, and const destination attributes, are left untouched,
+	// but a "convert_from" naming an attribute that doesn't exist in the source type fails to compile
+	// For standard-layout types, consecutive trivially copyable attributes that are laid out the same way in both types are
+	// copied with a single memcpy. These runs are computed at compile-time
+	template<typename Dst, typename Src>
+	Dst convert(const Src & src) noexcept;
+
+	template<typename Dst, typename Src>
+	void convert(const Src & src, Dst & dst) noexcept;
+}
+
+#include "convert.inl"
@@ -0,0 +1,178 @@
+#include "convert.hpp"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+// meta
+#include "putils/meta/fwd.hpp"
+
+namespace putils::reflection {
+	namespace detail::convert {
+		template<typename T, std::size_t I>
+		using member_at = putils::member_type<putils_typeof(std::get<I>(get_attributes<T>()).ptr)>;
+
+		template<typename T>
+		constexpr auto attribute_count = std::tuple_size_v<putils_typeof(get_attributes<T>())>;
+
+		// Whether Dst's attribute J is converted from a differently-named attribute
+		template<typename Dst, std::size_t J>
+		constexpr bool has_convert_from = has_metadata(std::get<J>(get_attributes<Dst>()).metadata, "convert_from");
+
+		// Index of the Src attribute that Dst's attribute J is converted from
+		template<typename Dst, typename Src, std::size_t J>
+		constexpr std::optional<std::size_t> source_index = [] {
+			constexpr auto & attr = std::get<J>(get_attributes<Dst>());
+			if constexpr (has_convert_from<Dst, J>)
+				return detail::attribute_name_index<Src>.find(*get_metadata<const char *>(attr.metadata, "convert_from"));
+			else
+				return detail::attribute_name_index<Src>.find(attr.name);
+		}();
+
+		enum class field_kind {
+			none,
+			copy,
+			assign,
+			convert,
+			unsupported, // rejected by convert, but other helpers may handle it differently
+		};
+
+		template<typename Dst, typename Src, std::size_t J>
+		consteval field_kind get_field_kind() noexcept {
+			using dst_member = member_at<Dst, J>;
+			constexpr auto source = source_index<Dst, Src, J>;
+			static_assert(source || !has_convert_from<Dst, J>, "\"convert_from\" metadata names an attribute that doesn't exist in the source type");
+
+			if constexpr (!source || std::is_const_v<dst_member>)
+				return field_kind::none;
+			else {
+				using src_member = std::remove_const_t<member_at<Src, *source>>;
+				constexpr bool standard_layout = std::is_standard_layout_v<Dst> && std::is_standard_layout_v<Src>;
+				if constexpr (standard_layout && std::is_same_v<src_member, dst_member> && std::is_trivially_copyable_v<dst_member>)
+					return field_kind::copy;
+				else if constexpr (std::is_assignable_v<dst_member &, const src_member &>)
+					return field_kind::assign;
+				else if constexpr (has_attributes<dst_member>() && has_attributes<src_member>())
+					return field_kind::convert;
+				else
+					return field_kind::unsupported;
+			}
+		}
+
+		template<typename Dst, typename Src>
+		constexpr auto field_kinds = []<std::size_t... Js>(std::index_sequence<Js...>) {
+			return std::array<field_kind, sizeof...(Js)>{ get_field_kind<Dst, Src, Js>()... };
+		}(std::make_index_sequence<attribute_count<Dst>>());
+
+		template<typename Dst, typename Src>
+		constexpr auto copy_count = std::count(field_kinds<Dst, Src>.begin(), field_kinds<Dst, Src>.end(), field_kind::copy);
+
+		struct copy_run {
+			std::size_t src_offset;
+			std::size_t dst_offset;
+			std::size_t size;
+		};
+
+		template<typename Dst, typename Src>
+		struct copy_plan {
+			std::array<copy_run, copy_count<Dst, Src>> runs;
+			std::size_t run_count = 0;
+		};
+
+		// Offset of a member of T, found by looking for the byte of an uninitialized T that it starts at
+		// Comparing addresses inside the union is a constant expression, whereas casting them to char pointers wouldn't be
+		template<typename T, typename Member, typename Class>
+		constexpr std::size_t get_offset(Member Class::*ptr) noexcept {
+			union storage {
+				char bytes[sizeof(T)];
+				T obj;
+
+				constexpr storage() noexcept : bytes{} {}
+				constexpr ~storage() noexcept {}
+			};
+			const storage s;
+
+			const auto member = static_cast<const void *>(&(s.obj.*ptr));
+			for (std::size_t i = 0; i < sizeof(T); ++i)
+				if (static_cast<const void *>(&s.bytes[i]) == member)
+					return i;
+			return sizeof(T);
+		}
+
+		// Merge the attributes to copy into runs that are contiguous in both types
+		template<typename Dst, typename Src>
+		constexpr copy_plan<Dst, Src> make_copy_plan() noexcept {
+			copy_plan<Dst, Src> ret{};
+			[&]<std::size_t... Js>(std::index_sequence<Js...>) noexcept {
+				([&] {
+					if constexpr (field_kinds<Dst, Src>[Js] == field_kind::copy) {
+						const copy_run run{
+							.src_offset = get_offset<Src>(std::get<*source_index<Dst, Src, Js>>(get_attributes<Src>()).ptr),
+							.dst_offset = get_offset<Dst>(std::get<Js>(get_attributes<Dst>()).ptr),
+							.size = sizeof(member_at<Dst, Js>),
+						};
+
+						if (ret.run_count > 0) {
+							auto & last = ret.runs[ret.run_count - 1];
+							if (last.src_offset + last.size == run.src_offset && last.dst_offset + last.size == run.dst_offset) {
+								last.size += run.size;
+								return;
+							}
+						}
+						ret.runs[ret.run_count++] = run;
+					}
+				}(),
+				 ...);
+			}(std::make_index_sequence<attribute_count<Dst>>());
+			return ret;
+		}
+
+		template<typename Dst, typename Src>
+		constexpr auto copy_plan_for = make_copy_plan<Dst, Src>();
+
+		// Copy the attributes for which field_kinds is `copy`, with memcpy runs
+		template<typename Dst, typename Src>
+		void copy_runs(const Src & src, Dst & dst) noexcept {
+			if constexpr (copy_count<Dst, Src> > 0) {
+				constexpr auto & plan = copy_plan_for<Dst, Src>;
+				for (std::size_t i = 0; i < plan.run_count; ++i) {
+					const auto & run = plan.runs[i];
+					std::memcpy((char *)&dst + run.dst_offset, (const char *)&src + run.src_offset, run.size);
+				}
+			}
+		}
+	}
+
+	template<typename Dst, typename Src>
+	Dst convert(const Src & src) noexcept {
+		Dst ret;
+		convert(src, ret);
+		return ret;
+	}
+
+	template<typename Dst, typename Src>
+	void convert(const Src & src, Dst & dst) noexcept {
+		using namespace detail::convert;
+
+		copy_runs(src, dst);
+
+		[&]<std::size_t... Js>(std::index_sequence<Js...>) noexcept {
+			([&] {
+				constexpr auto kind = field_kinds<Dst, Src>[Js];
+				static_assert(kind != field_kind::unsupported, "Attribute cannot be converted");
+				if constexpr (kind == field_kind::assign || kind == field_kind::convert) {
+					const auto & src_member = src.*std::get<*source_index<Dst, Src, Js>>(get_attributes<Src>()).ptr;
+					auto & dst_member = dst.*std::get<Js>(get_attributes<Dst>()).ptr;
+					if constexpr (kind == field_kind::assign)
+						dst_member = src_member;
+					else
+						convert(src_member, dst_member);
+				}
+			}(),
+			 ...);
+		}(std::make_index_sequence<attribute_count<Dst>>());
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	struct csv_options {
+		char separator = ',';
+
+		// What to do with header columns that don't match any (parseable) attribute
+		enum class unknown_column_policy {
+			error,
+			skip,
+		};
+		unknown_column_policy unknown_columns = unknown_column_policy::error;
+
+		// 0 means std::thread::hardware_concurrency()
+		std::size_t thread_count = 0;
+		// Inputs are never split into chunks smaller than this, to avoid spawning threads for small files
+		std::size_t min_chunk_size = 1024 * 1024;
+	};
+
+	struct csv_error {
+		std::size_t line; // 1-based, the header being line 1
+		std::string message;
+	};
+
+	template<typename T>
+	struct csv_result {
+		std::vector<T> objects;
+		std::optional<csv_error> error; // if set, `objects` is empty
+	};
+
+	// Parse `data` as CSV (or TSV, depending on `options.separator`), with a header row naming T's attributes
+	// Columns are mapped to attributes once, then rows are parsed in parallel chunks directly into T objects
+	// Supported attribute types are arithmetic types, enums (as their underlying value) and types assignable from std::string_view
+	// Quoted fields (with "" escapes) are supported, but may not contain line breaks
+	template<typename T>
+	csv_result<T> load_csv(std::string_view data, const csv_options & options = {}) noexcept;
+
+	// Memory-map the file at `path` and call load_csv on its contents
+	template<typename T>
+	csv_result<T> load_csv_file(const char * path, const csv_options & options = {}) noexcept;
+}
+
+#include "csv_loader.inl"
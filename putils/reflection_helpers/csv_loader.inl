@@ -0,0 +1,356 @@
+#include "csv_loader.hpp"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iterator>
+#include <span>
+#include <thread>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace putils::reflection {
+	namespace detail::csv {
+		template<typename Member>
+		constexpr bool is_parseable = !std::is_const_v<Member> && (std::is_arithmetic_v<Member> || std::is_enum_v<Member> || std::is_assignable_v<Member &, std::string_view>);
+
+		template<typename Member>
+		bool parse_value(Member & member, std::string_view value) noexcept {
+			if constexpr (std::is_same_v<Member, bool>) {
+				if (value == "1" || value == "true") {
+					member = true;
+					return true;
+				}
+				if (value == "0" || value == "false") {
+					member = false;
+					return true;
+				}
+				return false;
+			}
+			else if constexpr (std::is_enum_v<Member>) {
+				std::underlying_type_t<Member> underlying;
+				if (!parse_value(underlying, value))
+					return false;
+				member = Member(underlying);
+				return true;
+			}
+			else if constexpr (std::is_arithmetic_v<Member>) {
+				const auto end = value.data() + value.size();
+				const auto result = std::from_chars(value.data(), end, member);
+				return result.ec == std::errc() && result.ptr == end;
+			}
+			else {
+				member = value;
+				return true;
+			}
+		}
+
+		template<typename T>
+		using attribute_parser = bool (*)(T &, std::string_view) noexcept;
+
+		template<typename T, std::size_t I>
+		bool parse_attribute(T & obj, std::string_view value) noexcept {
+			constexpr auto & attr = std::get<I>(get_attributes<T>());
+			return parse_value(obj.*attr.ptr, value);
+		}
+
+		template<typename T, std::size_t I>
+		consteval attribute_parser<T> get_attribute_parser() noexcept {
+			using member = putils::member_type<putils_typeof(std::get<I>(get_attributes<T>()).ptr)>;
+			if constexpr (is_parseable<member>)
+				return &parse_attribute<T, I>;
+			else
+				return nullptr;
+		}
+
+		// Jump table mapping each attribute index to the function parsing it, or nullptr if it can't be parsed
+		template<typename T, std::size_t... Is>
+		consteval auto make_attribute_parsers(std::index_sequence<Is...>) noexcept {
+			return std::array<attribute_parser<T>, sizeof...(Is)>{ get_attribute_parser<T, Is>()... };
+		}
+
+		template<typename T>
+		constexpr auto attribute_parsers = make_attribute_parsers<T>(std::make_index_sequence<std::tuple_size_v<putils_typeof(get_attributes<T>())>>());
+
+		class field_splitter {
+		public:
+			field_splitter(std::string_view line, char separator) noexcept
+				: _remaining(line), _separator(separator) {}
+
+			// Returns nullopt once all fields have been read, or if a quoted field isn't closed before the end of the line
+			std::optional<std::string_view> next() noexcept {
+				if (_done)
+					return std::nullopt;
+
+				if (!_remaining.empty() && _remaining.front() == '"')
+					return next_quoted();
+
+				const auto separator = _remaining.find(_separator);
+				const auto field = _remaining.substr(0, separator);
+				skip_past(separator);
+				return field;
+			}
+
+			bool has_unclosed_quote() const noexcept { return _unclosed_quote; }
+
+		private:
+			std::optional<std::string_view> next_quoted() noexcept {
+				bool escaped = false;
+				std::size_t i = 1;
+				for (; i < _remaining.size(); ++i) {
+					if (_remaining[i] != '"')
+						continue;
+					if (i + 1 < _remaining.size() && _remaining[i + 1] == '"') {
+						escaped = true;
+						++i;
+						continue;
+					}
+					break;
+				}
+
+				if (i >= _remaining.size()) {
+					_unclosed_quote = true;
+					skip_past(std::string_view::npos);
+					return std::nullopt;
+				}
+
+				const auto contents = _remaining.substr(1, i - 1);
+				skip_past(_remaining.find(_separator, i));
+
+				if (!escaped)
+					return contents;
+
+				_buffer.clear();
+				for (std::size_t j = 0; j < contents.size(); ++j) {
+					_buffer += contents[j];
+					if (contents[j] == '"')
+						++j;
+				}
+				return _buffer;
+			}
+
+			void skip_past(std::size_t separator) noexcept {
+				if (separator == std::string_view::npos) {
+					_remaining = {};
+					_done = true;
+				}
+				else
+					_remaining.remove_prefix(separator + 1);
+			}
+
+		private:
+			std::string_view _remaining;
+			char _separator;
+			bool _done = false;
+			bool _unclosed_quote = false;
+			std::string _buffer;
+		};
+
+		// Splits the next line off `data`, without its line break
+		inline std::string_view next_line(std::string_view & data) noexcept {
+			const auto end = data.find('\n');
+			auto line = data.substr(0, end);
+			if (end == std::string_view::npos)
+				data = {};
+			else
+				data.remove_prefix(end + 1);
+
+			if (!line.empty() && line.back() == '\r')
+				line.remove_suffix(1);
+			return line;
+		}
+
+		template<typename T>
+		struct chunk_result {
+			std::vector<T> objects;
+			const char * error_line = nullptr;
+			std::string error_message;
+		};
+
+		template<typename T>
+		void parse_chunk(std::string_view chunk, std::span<const attribute_parser<T>> column_parsers, std::span<const std::string> column_names, char separator, std::size_t estimated_line_size, chunk_result<T> & result) noexcept {
+			result.objects.reserve(chunk.size() / std::max<std::size_t>(estimated_line_size, 1));
+
+			while (!chunk.empty()) {
+				const auto line = next_line(chunk);
+				if (line.empty())
+					continue;
+
+				const auto fail = [&](std::string message) noexcept {
+					result.objects.clear();
+					result.error_line = line.data();
+					result.error_message = std::move(message);
+				};
+
+				T & obj = result.objects.emplace_back();
+				field_splitter fields(line, separator);
+				for (std::size_t column = 0; column < column_parsers.size(); ++column) {
+					const auto field = fields.next();
+					if (!field) {
+						if (fields.has_unclosed_quote())
+							fail("Unclosed quote in column '" + column_names[column] + "'");
+						else
+							fail("Missing value for column '" + column_names[column] + "'");
+						return;
+					}
+
+					const auto parser = column_parsers[column];
+					if (parser && !parser(obj, *field)) {
+						fail("Invalid value '" + std::string(*field) + "' for column '" + column_names[column] + "'");
+						return;
+					}
+				}
+
+				if (fields.next()) {
+					fail("Too many values");
+					return;
+				}
+			}
+		}
+
+		// Split `data` into `count` chunks of roughly the same size, each ending on a line break
+		inline std::vector<std::string_view> split_chunks(std::string_view data, std::size_t count) noexcept {
+			std::vector<std::string_view> chunks;
+			std::size_t begin = 0;
+			for (std::size_t i = 1; i <= count && begin < data.size(); ++i) {
+				auto end = data.size();
+				if (i < count) {
+					end = data.find('\n', std::max(begin, data.size() * i / count));
+					end = end == std::string_view::npos ? data.size() : end + 1;
+				}
+				chunks.push_back(data.substr(begin, end - begin));
+				begin = end;
+			}
+			return chunks;
+		}
+	}
+
+	template<typename T>
+	csv_result<T> load_csv(std::string_view data, const csv_options & options) noexcept {
+		static_assert(std::is_default_constructible_v<T>);
+
+		csv_result<T> ret;
+		const auto set_error = [&](std::size_t line, std::string message) noexcept {
+			ret.objects.clear();
+			ret.error = csv_error{ .line = line, .message = std::move(message) };
+			return ret;
+		};
+
+		// Map columns to attributes once
+		auto body = data;
+		const auto header = detail::csv::next_line(body);
+		if (header.empty())
+			return ret;
+
+		std::vector<detail::csv::attribute_parser<T>> column_parsers;
+		std::vector<std::string> column_names;
+		detail::csv::field_splitter header_fields(header, options.separator);
+		while (const auto field = header_fields.next()) {
+			detail::csv::attribute_parser<T> parser = nullptr;
+			std::size_t index = 0;
+			for_each_attribute<T>([&](const auto & attr) noexcept {
+				if (!parser && *field == attr.name)
+					parser = detail::csv::attribute_parsers<T>[index];
+				++index;
+			});
+
+			if (!parser && options.unknown_columns == csv_options::unknown_column_policy::error)
+				return set_error(1, "Unknown column '" + std::string(*field) + "'");
+
+			column_parsers.push_back(parser);
+			column_names.emplace_back(*field);
+		}
+
+		if (header_fields.has_unclosed_quote())
+			return set_error(1, "Unclosed quote in header");
+
+		// Parse chunks in parallel
+		const auto thread_count = options.thread_count ? options.thread_count : std::max(1u, std::thread::hardware_concurrency());
+		const auto chunk_count = std::clamp<std::size_t>(body.size() / std::max<std::size_t>(options.min_chunk_size, 1), 1, thread_count);
+		const auto chunks = detail::csv::split_chunks(body, chunk_count);
+
+		std::vector<detail::csv::chunk_result<T>> results(chunks.size());
+		const auto parse_chunk = [&](std::size_t i) noexcept {
+			detail::csv::parse_chunk<T>(chunks[i], column_parsers, column_names, options.separator, header.size() + 1, results[i]);
+		};
+
+		std::vector<std::thread> threads;
+		for (std::size_t i = 1; i < chunks.size(); ++i)
+			threads.emplace_back(parse_chunk, i);
+		if (!chunks.empty())
+			parse_chunk(0);
+		for (auto & thread : threads)
+			thread.join();
+
+		// Report the first error, or gather all chunks
+		for (const auto & result : results)
+			if (result.error_line) {
+				const auto line = 2 + std::count(body.data(), result.error_line, '\n');
+				return set_error(line, result.error_message);
+			}
+
+		if (results.size() == 1) {
+			ret.objects = std::move(results[0].objects);
+			return ret;
+		}
+
+		std::size_t total_size = 0;
+		for (const auto & result : results)
+			total_size += result.objects.size();
+		ret.objects.reserve(total_size);
+		for (auto & result : results)
+			std::move(result.objects.begin(), result.objects.end(), std::back_inserter(ret.objects));
+		return ret;
+	}
+
+	template<typename T>
+	csv_result<T> load_csv_file(const char * path, const csv_options & options) noexcept {
+		const auto open_error = [&] {
+			csv_result<T> ret;
+			ret.error = csv_error{ .line = 0, .message = std::string("Failed to open '") + path + "'" };
+			return ret;
+		};
+
+#ifdef _WIN32
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return open_error();
+		const std::string contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+		return load_csv<T>(contents, options);
+#else
+		const int fd = open(path, O_RDONLY);
+		if (fd < 0)
+			return open_error();
+
+		struct stat file_info;
+		if (fstat(fd, &file_info) != 0) {
+			close(fd);
+			return open_error();
+		}
+
+		const auto size = std::size_t(file_info.st_size);
+		if (size == 0) {
+			close(fd);
+			return load_csv<T>({}, options);
+		}
+
+		void * const mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (mapping == MAP_FAILED)
+			return open_error();
+
+		madvise(mapping, size, MADV_SEQUENTIAL);
+		auto ret = load_csv<T>(std::string_view((const char *)mapping, size), options);
+		munmap(mapping, size);
+		return ret;
+#endif
+	}
+}
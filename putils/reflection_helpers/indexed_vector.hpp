@@ -0,0 +1,294 @@
+#pragma once
+
+// stl
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	// Passed to indexed_vector instead of a member pointer to give the attribute a sorted index, which also supports range queries
+	template<auto Member>
+	struct sorted_index_t {
+		static constexpr auto member = Member;
+	};
+
+	template<auto Member>
+	inline constexpr sorted_index_t<Member> sorted_index{};
+
+	namespace detail::indexed_vector {
+		template<typename Key>
+		concept hashable = std::copy_constructible<Key> && requires(const Key & key) {
+			{ std::hash<Key>{}(key) } -> std::convertible_to<std::size_t>;
+			{ key == key } -> std::convertible_to<bool>;
+		};
+
+		template<typename Key>
+		concept ordered = std::copy_constructible<Key> && requires(const Key & key) {
+			{ key < key } -> std::convertible_to<bool>;
+		};
+
+		// Positions of the elements for each key
+		// Each element's slot in its bucket is remembered, so it can be removed or moved without scanning the bucket
+		template<typename Map>
+		class index {
+		public:
+			using key_type = typename Map::key_type;
+			using size_type = std::size_t;
+
+			static constexpr bool sorted = !requires(const Map & map) { map.bucket_count(); };
+
+			void add(const key_type & key, size_type position) noexcept;
+			void remove(const key_type & key, size_type position) noexcept;
+			// The element at `from` has been moved to `to`, which must have been removed first
+			void move(const key_type & key, size_type from, size_type to) noexcept;
+			// Forget the positions at or after `size`
+			void truncate(size_type size) noexcept;
+			void clear() noexcept;
+			void reserve(size_type size) noexcept;
+
+			std::span<const size_type> find(const key_type & key) const noexcept;
+
+			// Call `func(size_type position)` for each element whose key is in [min, max], in key order
+			template<typename Func>
+			void for_each_in_range(const key_type & min, const key_type & max, Func && func) const noexcept;
+
+			size_type memory_usage() const noexcept;
+
+		private:
+			Map _buckets;
+			std::vector<size_type> _slots; // `_slots[position]` is the index of `position` in its bucket
+		};
+
+		template<typename Key>
+		using hash_map_index = index<std::unordered_map<Key, std::vector<std::size_t>>>;
+
+		template<typename Key>
+		using sorted_map_index = index<std::map<Key, std::vector<std::size_t>>>;
+
+		template<typename Index>
+		constexpr bool is_sorted_index = false;
+
+		template<auto Member>
+		constexpr bool is_sorted_index<sorted_index_t<Member>> = true;
+
+		// Member pointer of one of indexed_vector's `Indexes`
+		template<auto Index>
+		constexpr auto get_member() noexcept {
+			if constexpr (is_sorted_index<std::remove_cvref_t<decltype(Index)>>)
+				return Index.member;
+			else
+				return Index;
+		}
+
+		// Placeholder for the indexes an attribute's type doesn't support, never constructed
+		struct no_index {
+			void add(const auto &, std::size_t) noexcept {}
+			void remove(const auto &, std::size_t) noexcept {}
+			void move(const auto &, std::size_t, std::size_t) noexcept {}
+			void truncate(std::size_t) noexcept {}
+			void clear() noexcept {}
+			void reserve(std::size_t) noexcept {}
+			std::span<const std::size_t> find(const auto &) const noexcept { return {}; }
+			std::size_t memory_usage() const noexcept { return 0; }
+		};
+	}
+
+	// Vector of reflectible objects maintaining indexes on the attributes chosen by `Indexes`
+	// Each of `Indexes` is either a member pointer, for a hash index, or `sorted_index<member pointer>`, for a sorted index
+	// Indexed members must be part of `get_attributes<T>()`, so that indexes can also be queried by attribute name
+	// Indexed attributes must only be modified through `set` or `modify`, so that indexes are kept up to date
+	template<typename T, auto... Indexes>
+	class indexed_vector {
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		// Adding/removing elements. Functions adding an element return its position
+		size_type push_back(const T & obj) noexcept;
+		size_type push_back(T && obj) noexcept;
+
+		template<typename... Args>
+		size_type emplace_back(Args &&... args) noexcept;
+
+		// Moves the last element to `index`, so the positions returned by previous lookups may be invalidated
+		void erase(size_type index) noexcept;
+		void clear() noexcept;
+		void reserve(size_type size) noexcept;
+
+		// Read-only access
+		const T & operator[](size_type index) const noexcept;
+		std::span<const T> values() const noexcept;
+		auto begin() const noexcept { return _values.begin(); }
+		auto end() const noexcept { return _values.end(); }
+		size_type size() const noexcept;
+		bool empty() const noexcept;
+
+		// Set an attribute of the element at `index`, updating its index if it has one
+		template<auto Member, typename Value>
+		void set(size_type index, Value && value) noexcept;
+
+		// Set the attribute called `attribute`. Returns false if no attribute with that name can be assigned `value`
+		template<typename Value>
+		bool set(size_type index, std::string_view attribute, Value && value) noexcept;
+
+		// Call `func(T &)` on the element at `index`, then update all its indexes
+		template<typename Func>
+		void modify(size_type index, Func && func) noexcept;
+
+		// Get the positions of all elements whose `Member` is equal to `key`
+		template<auto Member>
+		std::span<const size_type> find(const putils::member_type<decltype(Member)> & key) const noexcept;
+
+		// Get the positions of all elements whose attribute called `attribute` is equal to `key`
+		// Returns an empty span if `attribute` is not indexed
+		template<typename Key>
+		std::span<const size_type> find(std::string_view attribute, const Key & key) const noexcept;
+
+		// Call `func(size_type position)` for each element whose `Member` is in [min, max], in increasing order of `Member`
+		// `Member` must have a sorted index
+		template<auto Member, typename Func>
+		void for_each_in_range(const putils::member_type<decltype(Member)> & min, const putils::member_type<decltype(Member)> & max, Func && func) const noexcept;
+
+		// Same as above for the attribute called `attribute`. Returns false if it doesn't have a sorted index
+		template<typename Key, typename Func>
+		bool for_each_in_range(std::string_view attribute, const Key & min, const Key & max, Func && func) const noexcept;
+
+		// Check whether the attribute called `attribute` is indexed
+		static constexpr bool is_indexed(std::string_view attribute) noexcept;
+
+		// Approximate number of bytes used by the indexes, on top of the elements themselves
+		size_type index_memory_usage() const noexcept;
+
+	private:
+		template<auto Index>
+		static constexpr auto member_of = detail::indexed_vector::get_member<Index>();
+
+		template<auto Index>
+		using key_of = std::decay_t<putils::member_type<putils_typeof(member_of<Index>)>>;
+
+		template<auto Index>
+		using index_type = std::conditional_t<
+			detail::indexed_vector::is_sorted_index<std::remove_cvref_t<decltype(Index)>>,
+			detail::indexed_vector::sorted_map_index<key_of<Index>>,
+			detail::indexed_vector::hash_map_index<key_of<Index>>>;
+
+		template<auto Member>
+		static consteval const char * get_member_name() noexcept;
+
+		template<auto Member>
+		static consteval bool is_indexed() noexcept;
+
+		template<auto Member>
+		static consteval size_type get_index_position() noexcept;
+
+		void add_to_indexes(size_type index) noexcept;
+		void remove_from_indexes(size_type index) noexcept;
+
+	private:
+		std::vector<T> _values;
+		std::tuple<index_type<Indexes>...> _indexes;
+	};
+
+	enum class index_kind {
+		hash,
+		sorted, // also supports range queries
+	};
+
+	// Vector of reflectible objects maintaining indexes on attributes chosen at runtime by name
+	// Any attribute whose type is hashable (or ordered, for sorted indexes) can be indexed
+	// Indexed attributes must only be modified through `set` or `modify`, so that indexes are kept up to date
+	template<typename T>
+	class runtime_indexed_vector {
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		// Index the attribute called `attribute`, including the elements already present
+		// Returns false if there's no such attribute, or if its type doesn't support `kind`
+		bool add_index(std::string_view attribute, index_kind kind = index_kind::hash) noexcept;
+		// Drop all indexes on the attribute called `attribute`. Returns false if it had none
+		bool remove_index(std::string_view attribute) noexcept;
+		bool is_indexed(std::string_view attribute) const noexcept;
+
+		// Adding/removing elements. Functions adding an element return its position
+		size_type push_back(const T & obj) noexcept;
+		size_type push_back(T && obj) noexcept;
+
+		template<typename... Args>
+		size_type emplace_back(Args &&... args) noexcept;
+
+		// Moves the last element to `index`, so the positions returned by previous lookups may be invalidated
+		void erase(size_type index) noexcept;
+		void clear() noexcept;
+		void reserve(size_type size) noexcept;
+
+		// Read-only access
+		const T & operator[](size_type index) const noexcept;
+		std::span<const T> values() const noexcept;
+		auto begin() const noexcept { return _values.begin(); }
+		auto end() const noexcept { return _values.end(); }
+		size_type size() const noexcept;
+		bool empty() const noexcept;
+
+		// Set the attribute called `attribute`, updating its indexes. Returns false if no attribute with that name can be assigned `value`
+		template<typename Value>
+		bool set(size_type index, std::string_view attribute, Value && value) noexcept;
+
+		// Call `func(T &)` on the element at `index`, then update all its indexes
+		template<typename Func>
+		void modify(size_type index, Func && func) noexcept;
+
+		// Get the positions of all elements whose attribute called `attribute` is equal to `key`
+		// Returns an empty span if `attribute` is not indexed
+		template<typename Key>
+		std::span<const size_type> find(std::string_view attribute, const Key & key) const noexcept;
+
+		// Call `func(size_type position)` for each element whose attribute called `attribute` is in [min, max], in increasing order
+		// Returns false if `attribute` doesn't have a sorted index
+		template<typename Key, typename Func>
+		bool for_each_in_range(std::string_view attribute, const Key & min, const Key & max, Func && func) const noexcept;
+
+		// Approximate number of bytes used by the indexes, on top of the elements themselves
+		size_type index_memory_usage() const noexcept;
+
+	private:
+		template<typename Key>
+		struct attribute_indexes {
+			std::optional<std::conditional_t<detail::indexed_vector::hashable<Key>, detail::indexed_vector::hash_map_index<Key>, detail::indexed_vector::no_index>> hash;
+			std::optional<std::conditional_t<detail::indexed_vector::ordered<Key>, detail::indexed_vector::sorted_map_index<Key>, detail::indexed_vector::no_index>> sorted;
+		};
+
+		template<std::size_t... Is>
+		static auto make_indexes(std::index_sequence<Is...>) noexcept
+			-> std::tuple<attribute_indexes<std::decay_t<putils::member_type<putils_typeof(std::get<Is>(get_attributes<T>()).ptr)>>>...>;
+
+		using indexes_type = decltype(make_indexes(std::make_index_sequence<std::tuple_size_v<putils_typeof(get_attributes<T>())>>()));
+
+		// Call `func(attr, indexes)` for the attribute called `attribute`. Returns false if there's none
+		template<typename Self, typename Func>
+		static bool visit_attribute(Self & self, std::string_view attribute, Func && func) noexcept;
+
+		// Call `func(attr, indexes)` for each attribute
+		template<typename Self, typename Func>
+		static void for_each_attribute_indexes(Self & self, Func && func) noexcept;
+
+		void add_to_indexes(size_type index) noexcept;
+		void remove_from_indexes(size_type index) noexcept;
+
+	private:
+		std::vector<T> _values;
+		indexes_type _indexes;
+	};
+}
+
+#include "indexed_vector.inl"
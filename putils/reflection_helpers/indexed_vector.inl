@@ -0,0 +1,569 @@
+#include "indexed_vector.hpp"
+
+// meta
+#include "putils/meta/fwd.hpp"
+
+namespace putils::reflection {
+	namespace detail {
+		template<auto A, auto B>
+		consteval bool is_same_member() noexcept {
+			if constexpr (std::is_same_v<decltype(A), decltype(B)>)
+				return A == B;
+			else
+				return false;
+		}
+	}
+
+	namespace detail::indexed_vector {
+		template<typename Map>
+		void index<Map>::add(const key_type & key, size_type position) noexcept {
+			auto & bucket = _buckets[key];
+			if (position >= _slots.size())
+				_slots.resize(position + 1);
+			_slots[position] = bucket.size();
+			bucket.push_back(position);
+		}
+
+		template<typename Map>
+		void index<Map>::remove(const key_type & key, size_type position) noexcept {
+			const auto it = _buckets.find(key);
+			if (it == _buckets.end())
+				return;
+
+			// Fill the slot with the bucket's last position
+			auto & bucket = it->second;
+			const auto slot = _slots[position];
+			bucket[slot] = bucket.back();
+			_slots[bucket[slot]] = slot;
+			bucket.pop_back();
+
+			// Don't keep empty buckets around, so memory stays bounded by the number of distinct keys
+			if (bucket.empty())
+				_buckets.erase(it);
+		}
+
+		template<typename Map>
+		void index<Map>::move(const key_type & key, size_type from, size_type to) noexcept {
+			const auto it = _buckets.find(key);
+			if (it == _buckets.end())
+				return;
+
+			const auto slot = _slots[from];
+			it->second[slot] = to;
+			_slots[to] = slot;
+		}
+
+		template<typename Map>
+		void index<Map>::truncate(size_type size) noexcept {
+			if (size < _slots.size())
+				_slots.resize(size);
+		}
+
+		template<typename Map>
+		void index<Map>::clear() noexcept {
+			_buckets.clear();
+			_slots.clear();
+		}
+
+		template<typename Map>
+		void index<Map>::reserve(size_type size) noexcept {
+			if constexpr (!sorted)
+				_buckets.reserve(size);
+			_slots.reserve(size);
+		}
+
+		template<typename Map>
+		std::span<const typename index<Map>::size_type> index<Map>::find(const key_type & key) const noexcept {
+			const auto it = _buckets.find(key);
+			if (it == _buckets.end())
+				return {};
+			return it->second;
+		}
+
+		template<typename Map>
+		template<typename Func>
+		void index<Map>::for_each_in_range(const key_type & min, const key_type & max, Func && func) const noexcept {
+			static_assert(sorted, "Range queries require a sorted index");
+
+			for (auto it = _buckets.lower_bound(min); it != _buckets.end() && !(max < it->first); ++it)
+				for (const auto position : it->second)
+					func(position);
+		}
+
+		template<typename Map>
+		typename index<Map>::size_type index<Map>::memory_usage() const noexcept {
+			using node_type = typename Map::value_type;
+
+			size_type ret = _slots.capacity() * sizeof(size_type);
+			if constexpr (sorted)
+				// One tree node per key, with its parent and child pointers and its colour (padded to a pointer)
+				ret += _buckets.size() * (sizeof(node_type) + 4 * sizeof(void *));
+			else
+				// Bucket array, then one node per key (with its `next` pointer and cached hash)
+				ret += _buckets.bucket_count() * sizeof(void *) + _buckets.size() * (sizeof(node_type) + 2 * sizeof(void *));
+
+			for (const auto & [key, positions] : _buckets)
+				ret += positions.capacity() * sizeof(size_type);
+			return ret;
+		}
+	}
+
+	template<typename T, auto... Indexes>
+	typename indexed_vector<T, Indexes...>::size_type indexed_vector<T, Indexes...>::push_back(const T & obj) noexcept {
+		return emplace_back(obj);
+	}
+
+	template<typename T, auto... Indexes>
+	typename indexed_vector<T, Indexes...>::size_type indexed_vector<T, Indexes...>::push_back(T && obj) noexcept {
+		return emplace_back(std::move(obj));
+	}
+
+	template<typename T, auto... Indexes>
+	template<typename... Args>
+	typename indexed_vector<T, Indexes...>::size_type indexed_vector<T, Indexes...>::emplace_back(Args &&... args) noexcept {
+		_values.emplace_back(FWD(args)...);
+		const auto index = _values.size() - 1;
+		add_to_indexes(index);
+		return index;
+	}
+
+	template<typename T, auto... Indexes>
+	void indexed_vector<T, Indexes...>::erase(size_type index) noexcept {
+		const auto last = _values.size() - 1;
+		remove_from_indexes(index);
+		if (index != last) {
+			(std::get<get_index_position<member_of<Indexes>>()>(_indexes).move(_values[last].*member_of<Indexes>, last, index), ...);
+			_values[index] = std::move(_values[last]);
+		}
+		_values.pop_back();
+		std::apply([last](auto &... index) noexcept { (index.truncate(last), ...); }, _indexes);
+	}
+
+	template<typename T, auto... Indexes>
+	void indexed_vector<T, Indexes...>::clear() noexcept {
+		_values.clear();
+		std::apply([](auto &... index) noexcept { (index.clear(), ...); }, _indexes);
+	}
+
+	template<typename T, auto... Indexes>
+	void indexed_vector<T, Indexes...>::reserve(size_type size) noexcept {
+		_values.reserve(size);
+		std::apply([size](auto &... index) noexcept { (index.reserve(size), ...); }, _indexes);
+	}
+
+	template<typename T, auto... Indexes>
+	const T & indexed_vector<T, Indexes...>::operator[](size_type index) const noexcept {
+		return _values[index];
+	}
+
+	template<typename T, auto... Indexes>
+	std::span<const T> indexed_vector<T, Indexes...>::values() const noexcept {
+		return _values;
+	}
+
+	template<typename T, auto... Indexes>
+	typename indexed_vector<T, Indexes...>::size_type indexed_vector<T, Indexes...>::size() const noexcept {
+		return _values.size();
+	}
+
+	template<typename T, auto... Indexes>
+	bool indexed_vector<T, Indexes...>::empty() const noexcept {
+		return _values.empty();
+	}
+
+	template<typename T, auto... Indexes>
+	template<auto Member, typename Value>
+	void indexed_vector<T, Indexes...>::set(size_type index, Value && value) noexcept {
+		static_assert(std::is_assignable_v<putils::member_type<decltype(Member)> &, Value &&>);
+
+		if constexpr (is_indexed<Member>()) {
+			auto & member_index = std::get<get_index_position<Member>()>(_indexes);
+			member_index.remove(_values[index].*Member, index);
+			_values[index].*Member = FWD(value);
+			member_index.add(_values[index].*Member, index);
+		}
+		else
+			_values[index].*Member = FWD(value);
+	}
+
+	template<typename T, auto... Indexes>
+	template<typename Value>
+	bool indexed_vector<T, Indexes...>::set(size_type index, std::string_view attribute, Value && value) noexcept {
+		bool ret = false;
+		for_each_attribute<T>([&](const auto & attr) noexcept {
+			using member_type = putils::member_type<putils_typeof(attr.ptr)>;
+			if constexpr (std::is_assignable_v<member_type &, Value &&>) {
+				if (ret || attribute != attr.name)
+					return;
+				ret = true;
+
+				bool indexed = false;
+				([&] {
+					if constexpr (std::is_same_v<putils_typeof(attr.ptr), putils_typeof(member_of<Indexes>)>) {
+						if (!indexed && attr.ptr == member_of<Indexes>) {
+							indexed = true;
+							set<member_of<Indexes>>(index, FWD(value));
+						}
+					}
+				}(),
+				 ...);
+
+				if (!indexed)
+					_values[index].*attr.ptr = FWD(value);
+			}
+		});
+		return ret;
+	}
+
+	template<typename T, auto... Indexes>
+	template<typename Func>
+	void indexed_vector<T, Indexes...>::modify(size_type index, Func && func) noexcept {
+		remove_from_indexes(index);
+		func(_values[index]);
+		add_to_indexes(index);
+	}
+
+	template<typename T, auto... Indexes>
+	template<auto Member>
+	std::span<const typename indexed_vector<T, Indexes...>::size_type> indexed_vector<T, Indexes...>::find(const putils::member_type<decltype(Member)> & key) const noexcept {
+		static_assert(is_indexed<Member>(), "Attribute is not indexed");
+		return std::get<get_index_position<Member>()>(_indexes).find(key);
+	}
+
+	template<typename T, auto... Indexes>
+	template<typename Key>
+	std::span<const typename indexed_vector<T, Indexes...>::size_type> indexed_vector<T, Indexes...>::find(std::string_view attribute, const Key & key) const noexcept {
+		std::span<const size_type> ret;
+		bool found = false;
+		([&] {
+			if constexpr (std::is_convertible_v<const Key &, key_of<Indexes>>) {
+				if (!found && attribute == get_member_name<member_of<Indexes>>()) {
+					found = true;
+					ret = find<member_of<Indexes>>(key_of<Indexes>(key));
+				}
+			}
+		}(),
+		 ...);
+		return ret;
+	}
+
+	template<typename T, auto... Indexes>
+	template<auto Member, typename Func>
+	void indexed_vector<T, Indexes...>::for_each_in_range(const putils::member_type<decltype(Member)> & min, const putils::member_type<decltype(Member)> & max, Func && func) const noexcept {
+		static_assert(is_indexed<Member>(), "Attribute is not indexed");
+		std::get<get_index_position<Member>()>(_indexes).for_each_in_range(min, max, func);
+	}
+
+	template<typename T, auto... Indexes>
+	template<typename Key, typename Func>
+	bool indexed_vector<T, Indexes...>::for_each_in_range(std::string_view attribute, const Key & min, const Key & max, Func && func) const noexcept {
+		bool found = false;
+		([&] {
+			if constexpr (index_type<Indexes>::sorted && std::is_convertible_v<const Key &, key_of<Indexes>>) {
+				if (!found && attribute == get_member_name<member_of<Indexes>>()) {
+					found = true;
+					for_each_in_range<member_of<Indexes>>(key_of<Indexes>(min), key_of<Indexes>(max), func);
+				}
+			}
+		}(),
+		 ...);
+		return found;
+	}
+
+	template<typename T, auto... Indexes>
+	constexpr bool indexed_vector<T, Indexes...>::is_indexed(std::string_view attribute) noexcept {
+		return ((attribute == get_member_name<member_of<Indexes>>()) || ...);
+	}
+
+	template<typename T, auto... Indexes>
+	typename indexed_vector<T, Indexes...>::size_type indexed_vector<T, Indexes...>::index_memory_usage() const noexcept {
+		return std::apply([](const auto &... index) noexcept { return (size_type(0) + ... + index.memory_usage()); }, _indexes);
+	}
+
+	template<typename T, auto... Indexes>
+	template<auto Member>
+	consteval const char * indexed_vector<T, Indexes...>::get_member_name() noexcept {
+		const char * ret = nullptr;
+		for_each_attribute<T>([&](const auto & attr) {
+			if constexpr (std::is_same_v<putils_typeof(attr.ptr), decltype(Member)>) {
+				if (attr.ptr == Member)
+					ret = attr.name;
+			}
+		});
+		return ret;
+	}
+
+	template<typename T, auto... Indexes>
+	template<auto Member>
+	consteval bool indexed_vector<T, Indexes...>::is_indexed() noexcept {
+		return (detail::is_same_member<Member, member_of<Indexes>>() || ...);
+	}
+
+	template<typename T, auto... Indexes>
+	template<auto Member>
+	consteval typename indexed_vector<T, Indexes...>::size_type indexed_vector<T, Indexes...>::get_index_position() noexcept {
+		constexpr bool matches[] = { detail::is_same_member<Member, member_of<Indexes>>()... };
+		for (size_type i = 0; i < sizeof...(Indexes); ++i)
+			if (matches[i])
+				return i;
+		return sizeof...(Indexes);
+	}
+
+	template<typename T, auto... Indexes>
+	void indexed_vector<T, Indexes...>::add_to_indexes(size_type index) noexcept {
+		static_assert(sizeof...(Indexes) > 0, "indexed_vector requires at least one indexed attribute");
+		static_assert(((get_member_name<member_of<Indexes>>() != nullptr) && ...), "Indexed members must be reflected attributes of T");
+		static_assert(((index_type<Indexes>::sorted ? detail::indexed_vector::ordered<key_of<Indexes>> : detail::indexed_vector::hashable<key_of<Indexes>>) && ...), "Hash indexes require hashable attributes, and sorted indexes require attributes ordered by operator<");
+		(std::get<get_index_position<member_of<Indexes>>()>(_indexes).add(_values[index].*member_of<Indexes>, index), ...);
+	}
+
+	template<typename T, auto... Indexes>
+	void indexed_vector<T, Indexes...>::remove_from_indexes(size_type index) noexcept {
+		(std::get<get_index_position<member_of<Indexes>>()>(_indexes).remove(_values[index].*member_of<Indexes>, index), ...);
+	}
+
+	template<typename T>
+	bool runtime_indexed_vector<T>::add_index(std::string_view attribute, index_kind kind) noexcept {
+		bool ret = false;
+		visit_attribute(*this, attribute, [&](const auto & attr, auto & indexes) noexcept {
+			const auto build = [&](auto & index) noexcept {
+				if (index)
+					return;
+				index.emplace();
+				index->reserve(_values.size());
+				for (size_type i = 0; i < _values.size(); ++i)
+					index->add(_values[i].*attr.ptr, i);
+			};
+
+			using key_type = std::decay_t<putils::member_type<putils_typeof(attr.ptr)>>;
+			if (kind == index_kind::hash) {
+				if constexpr (detail::indexed_vector::hashable<key_type>) {
+					build(indexes.hash);
+					ret = true;
+				}
+			}
+			else if constexpr (detail::indexed_vector::ordered<key_type>) {
+				build(indexes.sorted);
+				ret = true;
+			}
+		});
+		return ret;
+	}
+
+	template<typename T>
+	bool runtime_indexed_vector<T>::remove_index(std::string_view attribute) noexcept {
+		bool ret = false;
+		visit_attribute(*this, attribute, [&](const auto &, auto & indexes) noexcept {
+			ret = indexes.hash || indexes.sorted;
+			indexes.hash.reset();
+			indexes.sorted.reset();
+		});
+		return ret;
+	}
+
+	template<typename T>
+	bool runtime_indexed_vector<T>::is_indexed(std::string_view attribute) const noexcept {
+		bool ret = false;
+		visit_attribute(*this, attribute, [&](const auto &, const auto & indexes) noexcept {
+			ret = indexes.hash || indexes.sorted;
+		});
+		return ret;
+	}
+
+	template<typename T>
+	typename runtime_indexed_vector<T>::size_type runtime_indexed_vector<T>::push_back(const T & obj) noexcept {
+		return emplace_back(obj);
+	}
+
+	template<typename T>
+	typename runtime_indexed_vector<T>::size_type runtime_indexed_vector<T>::push_back(T && obj) noexcept {
+		return emplace_back(std::move(obj));
+	}
+
+	template<typename T>
+	template<typename... Args>
+	typename runtime_indexed_vector<T>::size_type runtime_indexed_vector<T>::emplace_back(Args &&... args) noexcept {
+		_values.emplace_back(FWD(args)...);
+		const auto index = _values.size() - 1;
+		add_to_indexes(index);
+		return index;
+	}
+
+	template<typename T>
+	void runtime_indexed_vector<T>::erase(size_type index) noexcept {
+		const auto last = _values.size() - 1;
+		remove_from_indexes(index);
+		for_each_attribute_indexes(*this, [&](const auto & attr, auto & indexes) noexcept {
+			const auto move = [&](auto & index_to_move) noexcept {
+				if (!index_to_move)
+					return;
+				if (index != last)
+					index_to_move->move(_values[last].*attr.ptr, last, index);
+				index_to_move->truncate(last);
+			};
+			move(indexes.hash);
+			move(indexes.sorted);
+		});
+		if (index != last)
+			_values[index] = std::move(_values[last]);
+		_values.pop_back();
+	}
+
+	template<typename T>
+	void runtime_indexed_vector<T>::clear() noexcept {
+		_values.clear();
+		for_each_attribute_indexes(*this, [](const auto &, auto & indexes) noexcept {
+			if (indexes.hash)
+				indexes.hash->clear();
+			if (indexes.sorted)
+				indexes.sorted->clear();
+		});
+	}
+
+	template<typename T>
+	void runtime_indexed_vector<T>::reserve(size_type size) noexcept {
+		_values.reserve(size);
+		for_each_attribute_indexes(*this, [size](const auto &, auto & indexes) noexcept {
+			if (indexes.hash)
+				indexes.hash->reserve(size);
+			if (indexes.sorted)
+				indexes.sorted->reserve(size);
+		});
+	}
+
+	template<typename T>
+	const T & runtime_indexed_vector<T>::operator[](size_type index) const noexcept {
+		return _values[index];
+	}
+
+	template<typename T>
+	std::span<const T> runtime_indexed_vector<T>::values() const noexcept {
+		return _values;
+	}
+
+	template<typename T>
+	typename runtime_indexed_vector<T>::size_type runtime_indexed_vector<T>::size() const noexcept {
+		return _values.size();
+	}
+
+	template<typename T>
+	bool runtime_indexed_vector<T>::empty() const noexcept {
+		return _values.empty();
+	}
+
+	template<typename T>
+	template<typename Value>
+	bool runtime_indexed_vector<T>::set(size_type index, std::string_view attribute, Value && value) noexcept {
+		bool ret = false;
+		visit_attribute(*this, attribute, [&](const auto & attr, auto & indexes) noexcept {
+			using member_type = putils::member_type<putils_typeof(attr.ptr)>;
+			if constexpr (std::is_assignable_v<member_type &, Value &&>) {
+				ret = true;
+				auto & member = _values[index].*attr.ptr;
+				if (indexes.hash)
+					indexes.hash->remove(member, index);
+				if (indexes.sorted)
+					indexes.sorted->remove(member, index);
+				member = FWD(value);
+				if (indexes.hash)
+					indexes.hash->add(member, index);
+				if (indexes.sorted)
+					indexes.sorted->add(member, index);
+			}
+		});
+		return ret;
+	}
+
+	template<typename T>
+	template<typename Func>
+	void runtime_indexed_vector<T>::modify(size_type index, Func && func) noexcept {
+		remove_from_indexes(index);
+		func(_values[index]);
+		add_to_indexes(index);
+	}
+
+	template<typename T>
+	template<typename Key>
+	std::span<const typename runtime_indexed_vector<T>::size_type> runtime_indexed_vector<T>::find(std::string_view attribute, const Key & key) const noexcept {
+		std::span<const size_type> ret;
+		visit_attribute(*this, attribute, [&](const auto & attr, const auto & indexes) noexcept {
+			using key_type = std::decay_t<putils::member_type<putils_typeof(attr.ptr)>>;
+			if constexpr (std::is_convertible_v<const Key &, key_type>) {
+				if (indexes.hash)
+					ret = indexes.hash->find(key_type(key));
+				else if (indexes.sorted)
+					ret = indexes.sorted->find(key_type(key));
+			}
+		});
+		return ret;
+	}
+
+	template<typename T>
+	template<typename Key, typename Func>
+	bool runtime_indexed_vector<T>::for_each_in_range(std::string_view attribute, const Key & min, const Key & max, Func && func) const noexcept {
+		bool ret = false;
+		visit_attribute(*this, attribute, [&](const auto & attr, const auto & indexes) noexcept {
+			using key_type = std::decay_t<putils::member_type<putils_typeof(attr.ptr)>>;
+			if constexpr (detail::indexed_vector::ordered<key_type> && std::is_convertible_v<const Key &, key_type>) {
+				if (indexes.sorted) {
+					ret = true;
+					indexes.sorted->for_each_in_range(key_type(min), key_type(max), func);
+				}
+			}
+		});
+		return ret;
+	}
+
+	template<typename T>
+	typename runtime_indexed_vector<T>::size_type runtime_indexed_vector<T>::index_memory_usage() const noexcept {
+		size_type ret = 0;
+		for_each_attribute_indexes(*this, [&](const auto &, const auto & indexes) noexcept {
+			if (indexes.hash)
+				ret += indexes.hash->memory_usage();
+			if (indexes.sorted)
+				ret += indexes.sorted->memory_usage();
+		});
+		return ret;
+	}
+
+	template<typename T>
+	template<typename Self, typename Func>
+	bool runtime_indexed_vector<T>::visit_attribute(Self & self, std::string_view attribute, Func && func) noexcept {
+		const auto position = detail::attribute_name_index<T>.find(attribute);
+		if (!position)
+			return false;
+
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) noexcept {
+			((Is == *position ? func(std::get<Is>(get_attributes<T>()), std::get<Is>(self._indexes)) : void()), ...);
+		}(std::make_index_sequence<std::tuple_size_v<indexes_type>>());
+		return true;
+	}
+
+	template<typename T>
+	template<typename Self, typename Func>
+	void runtime_indexed_vector<T>::for_each_attribute_indexes(Self & self, Func && func) noexcept {
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) noexcept {
+			(func(std::get<Is>(get_attributes<T>()), std::get<Is>(self._indexes)), ...);
+		}(std::make_index_sequence<std::tuple_size_v<indexes_type>>());
+	}
+
+	template<typename T>
+	void runtime_indexed_vector<T>::add_to_indexes(size_type index) noexcept {
+		for_each_attribute_indexes(*this, [&](const auto & attr, auto & indexes) noexcept {
+			if (indexes.hash)
+				indexes.hash->add(_values[index].*attr.ptr, index);
+			if (indexes.sorted)
+				indexes.sorted->add(_values[index].*attr.ptr, index);
+		});
+	}
+
+	template<typename T>
+	void runtime_indexed_vector<T>::remove_from_indexes(size_type index) noexcept {
+		for_each_attribute_indexes(*this, [&](const auto & attr, auto & indexes) noexcept {
+			if (indexes.hash)
+				indexes.hash->remove(_values[index].*attr.ptr, index);
+			if (indexes.sorted)
+				indexes.sorted->remove(_values[index].*attr.ptr, index);
+		});
+	}
+}
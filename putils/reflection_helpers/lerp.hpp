@@ -0,0 +1,31 @@
+#pragma once
+
+// stl
+#include <span>
+
+// reflection
+#include "putils/reflection.hpp"
+
+// Interpolation between two states of reflectible objects, e.g. for smoothing between network snapshots
+// Each non-const attribute is handled according to its type and metadata:
+//	- floating-point numbers are interpolated linearly
+//	- integers are interpolated linearly, and rounded to the nearest value. The difference between the two values is computed
+//	  as a double, so 64-bit integers further apart than 2^53 lose precision
+//	- reflectible types are interpolated attribute by attribute
+//	- other types (bools, enums, strings...) are snapped: they take the value from `a` if t < 0.5, and from `b` otherwise
+//	- attributes with "no_interp" metadata (any value) are snapped
+//	- floating-point attributes with "angle" metadata are interpolated along the shortest arc. The metadata's value is the period,
+//	  of the same type as the attribute (e.g. 360.f for degrees), and the result is wrapped into [0, period)
+
+namespace putils::reflection {
+	template<typename T>
+	void lerp(const T & a, const T & b, float t, T & out) noexcept;
+
+	// Interpolate each object of `a` with the object at the same position in `b`. Only the first `min(a.size(), b.size(), out.size())` are processed
+	// The batch is processed attribute by attribute, with the interpolation mode of each one resolved at compile-time, so the loops don't branch
+	// `out` may be the same span as `a` or `b`
+	template<typename T>
+	void lerp(std::span<const T> a, std::span<const T> b, float t, std::span<T> out) noexcept;
+}
+
+#include "lerp.inl"
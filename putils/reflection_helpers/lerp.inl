@@ -0,0 +1,111 @@
+#include "lerp.hpp"
+
+// stl
+#include <algorithm>
+#include <cmath>
+
+namespace putils::reflection {
+	namespace detail::lerp {
+		template<typename T>
+		concept object = has_attributes<T>();
+
+		template<typename T>
+		constexpr auto attribute_count = std::tuple_size_v<putils_typeof(get_attributes<T>())>;
+
+		template<typename GetA, typename GetB, typename GetOut>
+		void snap(std::size_t count, float t, GetA && get_a, GetB && get_b, GetOut && get_out) noexcept {
+			// Pick the source once for the whole column
+			if (t < .5f)
+				for (std::size_t i = 0; i < count; ++i)
+					get_out(i) = get_a(i);
+			else
+				for (std::size_t i = 0; i < count; ++i)
+					get_out(i) = get_b(i);
+		}
+
+		template<typename T, typename GetA, typename GetB, typename GetOut>
+		void lerp_attributes(std::size_t count, float t, GetA && get_a, GetB && get_b, GetOut && get_out) noexcept;
+
+		template<typename Member, typename GetA, typename GetB, typename GetOut>
+		void lerp_values(std::size_t count, float t, GetA && get_a, GetB && get_b, GetOut && get_out) noexcept {
+			if constexpr (object<Member>)
+				lerp_attributes<Member>(count, t, get_a, get_b, get_out);
+			else if constexpr (std::is_floating_point_v<Member>) {
+				const auto factor = Member(t);
+				for (std::size_t i = 0; i < count; ++i) {
+					const Member a = get_a(i);
+					const Member b = get_b(i);
+					get_out(i) = a + (b - a) * factor;
+				}
+			}
+			else if constexpr (std::is_integral_v<Member> && !std::is_same_v<Member, bool>) {
+				for (std::size_t i = 0; i < count; ++i) {
+					const Member a = get_a(i);
+					const Member b = get_b(i);
+					// Modular arithmetic, so the result is correct for unsigned types even if b < a
+					// The difference goes through a double, so 64-bit values are only exact while |b - a| < 2^53
+					get_out(i) = Member(a + Member(std::llround((double(b) - double(a)) * t)));
+				}
+			}
+			else
+				snap(count, t, get_a, get_b, get_out);
+		}
+
+		template<typename T, std::size_t I, typename GetA, typename GetB, typename GetOut>
+		void lerp_attribute(std::size_t count, float t, GetA && get_a, GetB && get_b, GetOut && get_out) noexcept {
+			constexpr auto ptr = std::get<I>(get_attributes<T>()).ptr;
+			using member = putils::member_type<putils_typeof(ptr)>;
+			if constexpr (!std::is_const_v<member>) {
+				const auto get_member_a = [&](std::size_t i) noexcept -> const member & { return get_a(i).*ptr; };
+				const auto get_member_b = [&](std::size_t i) noexcept -> const member & { return get_b(i).*ptr; };
+				const auto get_member_out = [&](std::size_t i) noexcept -> member & { return get_out(i).*ptr; };
+
+				if constexpr (attribute_metadata_flags<T, "no_interp">[I])
+					snap(count, t, get_member_a, get_member_b, get_member_out);
+				else if constexpr (attribute_metadata_flags<T, "angle">[I]) {
+					constexpr auto period = attribute_metadata_pointers<member, T, "angle">[I];
+					static_assert(std::is_floating_point_v<member>, "\"angle\" metadata is only supported on floating-point attributes");
+					static_assert(period != nullptr, "\"angle\" metadata should have the same type as the attribute");
+
+					const auto factor = member(t);
+					for (std::size_t i = 0; i < count; ++i) {
+						const member a = get_member_a(i);
+						auto delta = get_member_b(i) - a;
+						delta -= *period * std::round(delta / *period);
+						// Wrap into [0, period)
+						auto angle = std::fmod(a + delta * factor, *period);
+						if (angle < 0)
+							angle += *period;
+						get_member_out(i) = angle < *period ? angle : 0; // Adding the period to a tiny negative angle may round up to it
+					}
+				}
+				else
+					lerp_values<member>(count, t, get_member_a, get_member_b, get_member_out);
+			}
+		}
+
+		template<typename T, typename GetA, typename GetB, typename GetOut>
+		void lerp_attributes(std::size_t count, float t, GetA && get_a, GetB && get_b, GetOut && get_out) noexcept {
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+				(lerp_attribute<T, Is>(count, t, get_a, get_b, get_out), ...);
+			}(std::make_index_sequence<attribute_count<T>>());
+		}
+	}
+
+	template<typename T>
+	void lerp(const T & a, const T & b, float t, T & out) noexcept {
+		lerp(std::span<const T>(&a, 1), std::span<const T>(&b, 1), t, std::span<T>(&out, 1));
+	}
+
+	template<typename T>
+	void lerp(std::span<const T> a, std::span<const T> b, float t, std::span<T> out) noexcept {
+		const auto count = std::min({ a.size(), b.size(), out.size() });
+		detail::lerp::lerp_values<T>(
+			count,
+			t,
+			[&](std::size_t i) noexcept -> const T & { return a[i]; },
+			[&](std::size_t i) noexcept -> const T & { return b[i]; },
+			[&](std::size_t i) noexcept -> T & { return out[i]; }
+		);
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace putils::reflection {
+	// By-name lookups made from a call site, for a given type and name
+	// Lookups are only recorded when PUTILS_REFLECTION_PROFILE_LOOKUPS is defined, for `has_attribute`, `get_attribute`,
+	// `has_attribute_metadata` and `get_attribute_metadata`. Otherwise, they keep their usual signature and cost
+	struct lookup_profile_entry {
+		std::string_view class_name; // empty for types without a class name
+		std::string name;
+		std::string_view function; // lookup function called, e.g. "get_attribute"
+		std::source_location location;
+		std::uint64_t call_count = 0;
+		std::uint64_t scanned_count = 0; // total number of attributes compared to `name`, over all calls
+	};
+
+	// Get the lookups recorded so far, ranked by decreasing scanned_count
+	std::vector<lookup_profile_entry> get_lookup_profile() noexcept;
+
+	// Print the first `max_entries` lookups of get_lookup_profile(), one per line
+	void print_lookup_profile(std::ostream & out, std::size_t max_entries = std::numeric_limits<std::size_t>::max()) noexcept;
+
+	void reset_lookup_profile() noexcept;
+}
+
+#include "lookup_profile.inl"
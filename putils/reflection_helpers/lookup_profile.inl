@@ -0,0 +1,89 @@
+#include "lookup_profile.hpp"
+
+// stl
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+
+namespace putils::reflection {
+	namespace detail::lookup_profile {
+		// type, name, lookup function, file, line, column
+		using key = std::tuple<const void *, std::string, std::string_view, std::string_view, std::uint_least32_t, std::uint_least32_t>;
+
+		struct profile {
+			std::mutex mutex;
+			std::map<key, lookup_profile_entry, std::less<>> entries;
+		};
+
+		inline profile & get_profile() noexcept {
+			static profile instance;
+			return instance;
+		}
+
+		inline void add_lookup(const void * type, const char * class_name, std::string_view function, std::string_view name, std::size_t scanned, const std::source_location & location) noexcept {
+			auto & p = get_profile();
+			const std::lock_guard lock(p.mutex);
+
+			// Heterogeneous lookup, so that existing entries don't need a copy of name
+			const auto lookup_key = std::make_tuple(type, name, function, std::string_view(location.file_name()), location.line(), location.column());
+			auto it = p.entries.find(lookup_key);
+			if (it == p.entries.end()) {
+				const auto entry = lookup_profile_entry{
+					.class_name = class_name ? class_name : "",
+					.name = std::string(name),
+					.function = function,
+					.location = location,
+				};
+				it = p.entries.emplace(key(type, name, function, location.file_name(), location.line(), location.column()), entry).first;
+			}
+
+			++it->second.call_count;
+			it->second.scanned_count += scanned;
+		}
+
+		// Does nothing during constant evaluation
+		constexpr void record(const void * type, const char * class_name, std::string_view function, std::string_view name, std::size_t scanned, const std::source_location & location) noexcept {
+			if (!std::is_constant_evaluated())
+				add_lookup(type, class_name, function, name, scanned, location);
+		}
+	}
+
+	inline std::vector<lookup_profile_entry> get_lookup_profile() noexcept {
+		std::vector<lookup_profile_entry> ret;
+		{
+			auto & p = detail::lookup_profile::get_profile();
+			const std::lock_guard lock(p.mutex);
+			ret.reserve(p.entries.size());
+			for (const auto & [key, entry] : p.entries)
+				ret.push_back(entry);
+		}
+
+		std::stable_sort(ret.begin(), ret.end(), [](const auto & lhs, const auto & rhs) noexcept {
+			if (lhs.scanned_count != rhs.scanned_count)
+				return lhs.scanned_count > rhs.scanned_count;
+			return lhs.call_count > rhs.call_count;
+		});
+		return ret;
+	}
+
+	inline void print_lookup_profile(std::ostream & out, std::size_t max_entries) noexcept {
+		const auto entries = get_lookup_profile();
+		const auto count = std::min(max_entries, entries.size());
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto & entry = entries[i];
+			out << entry.scanned_count << " scanned, " << entry.call_count << " calls: "
+				<< entry.function << '<' << (entry.class_name.empty() ? "?" : entry.class_name) << ">(\"" << entry.name << "\") at "
+				<< entry.location.file_name() << ':' << entry.location.line() << ':' << entry.location.column()
+				<< " in " << entry.location.function_name() << '\n';
+		}
+	}
+
+	inline void reset_lookup_profile() noexcept {
+		auto & p = detail::lookup_profile::get_profile();
+		const std::lock_guard lock(p.mutex);
+		p.entries.clear();
+	}
+}
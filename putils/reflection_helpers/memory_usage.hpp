@@ -0,0 +1,58 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	struct memory_usage_info {
+		std::size_t inline_size = 0; // sizeof the object
+		std::size_t heap_size = 0; // heap memory used by the object's elements, recursively
+		std::size_t slack = 0; // heap memory allocated but unused (e.g. a vector's capacity beyond its size)
+		std::size_t padding = 0; // inline bytes not covered by reflected attributes (padding, or attributes that aren't reflected)
+		std::size_t heap_padding = 0; // same as padding, for the objects stored on the heap (already part of heap_size)
+
+		// inline_size + heap_size + slack
+		std::size_t get_total() const noexcept;
+
+		memory_usage_info & operator+=(const memory_usage_info & rhs) noexcept;
+	};
+
+	// Get the memory used by obj:
+	//	- reflectible types are walked through their attributes
+	//	- strings only count heap memory when they don't fit in the small string buffer
+	//	- contiguous containers (vector...) count their size and capacity
+	//	- node-based containers are estimated with one allocation per element, holding the element and the bookkeeping of the usual implementations:
+	//		- map/set (and multi variants): three pointers and the colour, so four pointers
+	//		- unordered containers: a `next` pointer and the cached hash, so two pointers, plus the bucket array
+	//		- list: two pointers
+	//		- forward_list: one pointer
+	//	- deque is estimated with libstdc++'s 512-byte blocks, the unused part of the last one counting as slack
+	//	- std::unique_ptr counts its pointee, std::optional its value
+	//	- other types only count their inline size
+	template<typename T>
+	memory_usage_info memory_usage(const T & obj) noexcept;
+
+	struct attribute_memory_usage {
+		std::string_view name;
+		memory_usage_info usage;
+	};
+
+	// Memory usage of a collection of objects, in total and for each attribute of T
+	struct memory_usage_breakdown {
+		std::size_t object_count = 0;
+		memory_usage_info total;
+		std::vector<attribute_memory_usage> attributes;
+	};
+
+	// Not noexcept, as it allocates the list of attributes
+	template<typename T>
+	memory_usage_breakdown get_memory_usage_breakdown(std::span<const T> objects);
+}
+
+#include "memory_usage.inl"
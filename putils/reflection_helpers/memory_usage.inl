@@ -0,0 +1,253 @@
+#include "memory_usage.hpp"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace putils::reflection {
+	namespace detail::memory_usage {
+		template<typename T>
+		concept object = has_attributes<T>();
+
+		template<typename T>
+		concept string = requires(const T & obj) {
+			typename T::traits_type;
+			{ obj.data() } -> std::convertible_to<const typename T::value_type *>;
+			obj.capacity();
+		};
+
+		template<typename T>
+		concept bit_vector = std::is_same_v<T, std::vector<bool, typename T::allocator_type>>;
+
+		template<typename T>
+		concept contiguous_container = !string<T> && requires(const T & obj) {
+			obj.data();
+			obj.size();
+			obj.capacity();
+		};
+
+		// Containers that allocate but aren't contiguous. Not all of them have a size(), e.g. std::forward_list
+		template<typename T>
+		concept node_container = !object<T> && !string<T> && !contiguous_container<T> && !bit_vector<T> && requires(const T & obj) {
+			typename T::value_type;
+			typename T::allocator_type; // only containers that allocate, not std::array
+			obj.begin();
+			obj.end();
+		};
+
+		// std::map, std::set and their multi variants
+		template<typename T>
+		concept ordered_container = node_container<T> && requires {
+			typename T::key_compare;
+		};
+
+		// std::unordered_map, std::unordered_set and their multi variants
+		template<typename T>
+		concept hashed_container = node_container<T> && requires(const T & obj) {
+			obj.bucket_count();
+		};
+
+		// std::deque
+		template<typename T>
+		concept block_container = node_container<T> && !ordered_container<T> && !hashed_container<T> && requires(const T & obj) {
+			obj[0];
+		};
+
+		template<typename T>
+		concept forward_list = node_container<T> && requires(const T & obj) {
+			obj.before_begin();
+		};
+
+		// Bookkeeping allocated along with each element of a node container, following the usual implementations (libstdc++, libc++, MSVC)
+		template<typename T>
+		constexpr std::size_t node_overhead = [] {
+			if constexpr (ordered_container<T>)
+				return 4 * sizeof(void *); // red-black tree: parent, left and right pointers, and the colour (padded to a pointer)
+			else if constexpr (hashed_container<T>)
+				return 2 * sizeof(void *); // `next` pointer, and the cached hash (some implementations don't cache it for trivial hashes)
+			else if constexpr (forward_list<T>)
+				return sizeof(void *); // `next` pointer
+			else
+				return 2 * sizeof(void *); // std::list: `next` and `prev` pointers
+		}();
+
+		// std::deque stores its elements in fixed-size blocks (of 512 bytes or one element with libstdc++), referenced by an array of pointers
+		template<typename T>
+		constexpr std::size_t block_elements = std::max<std::size_t>(1, 512 / sizeof(typename T::value_type));
+
+		template<typename T>
+		concept fixed_size_range = !object<T> && !string<T> && !contiguous_container<T> && !bit_vector<T> && !node_container<T> && requires(const T & obj) {
+			std::begin(obj);
+			std::end(obj);
+		};
+
+		template<typename T>
+		struct is_unique_ptr : std::false_type {};
+
+		template<typename T, typename Deleter>
+		struct is_unique_ptr<std::unique_ptr<T, Deleter>> : std::bool_constant<!std::is_array_v<T>> {};
+
+		template<typename T>
+		struct is_optional : std::false_type {};
+
+		template<typename T>
+		struct is_optional<std::optional<T>> : std::true_type {};
+
+		template<typename T>
+		memory_usage_info get_usage(const T & obj) noexcept;
+
+		// Heap usage and padding of an element stored inside a container or object, whose inline size is already accounted for
+		template<typename T>
+		memory_usage_info get_nested_usage(const T & obj) noexcept {
+			auto usage = get_usage(obj);
+			usage.inline_size = 0;
+			return usage;
+		}
+
+		// Same as get_nested_usage, for an element stored on the heap
+		template<typename T>
+		memory_usage_info get_heap_element_usage(const T & obj) noexcept {
+			auto usage = get_nested_usage(obj);
+			usage.heap_padding += std::exchange(usage.padding, 0);
+			return usage;
+		}
+
+		template<typename T>
+		std::size_t get_padding(const T & obj) noexcept {
+			constexpr auto attribute_count = std::tuple_size_v<putils_typeof(get_attributes<T>())>;
+
+			// [begin, end) of each attribute inside obj
+			std::array<std::pair<std::size_t, std::size_t>, attribute_count> ranges;
+			std::size_t index = 0;
+			for_each_attribute(obj, [&](const auto & attr) noexcept {
+				const auto begin = std::size_t((const char *)std::addressof(attr.member) - (const char *)std::addressof(obj));
+				ranges[index++] = { begin, begin + sizeof(attr.member) };
+			});
+			std::sort(ranges.begin(), ranges.end());
+
+			std::size_t covered = 0;
+			std::size_t covered_end = 0;
+			for (const auto & [begin, end] : ranges) {
+				// Overlapping attributes (e.g. an object and its parent's attributes) are only counted once
+				const auto new_begin = std::max(begin, covered_end);
+				if (end > new_begin)
+					covered += end - new_begin;
+				covered_end = std::max(covered_end, end);
+			}
+			return sizeof(T) - std::min(covered, sizeof(T));
+		}
+
+		template<typename T>
+		memory_usage_info get_usage(const T & obj) noexcept {
+			memory_usage_info usage{ .inline_size = sizeof(T) };
+
+			if constexpr (object<T>) {
+				for_each_attribute(obj, [&](const auto & attr) noexcept {
+					usage += get_nested_usage(attr.member);
+				});
+				usage.padding += get_padding(obj);
+			}
+			else if constexpr (string<T>) {
+				using char_type = typename T::value_type;
+				// Short strings are stored inside the object itself
+				const auto data = (const char *)obj.data();
+				const bool is_inline = data >= (const char *)std::addressof(obj) && data < (const char *)(std::addressof(obj) + 1);
+				if (!is_inline) {
+					usage.heap_size += (obj.size() + 1) * sizeof(char_type);
+					usage.slack += (obj.capacity() - obj.size()) * sizeof(char_type);
+				}
+			}
+			else if constexpr (bit_vector<T>) {
+				usage.heap_size += (obj.size() + 7) / 8;
+				usage.slack += (obj.capacity() + 7) / 8 - (obj.size() + 7) / 8;
+			}
+			else if constexpr (contiguous_container<T>) {
+				using element = std::remove_cvref_t<decltype(*obj.data())>;
+				usage.heap_size += obj.size() * sizeof(element);
+				usage.slack += (obj.capacity() - obj.size()) * sizeof(element);
+				for (const auto & e : obj)
+					usage += get_heap_element_usage(e);
+			}
+			else if constexpr (block_container<T>) {
+				using element = typename T::value_type;
+				const auto blocks = obj.size() / block_elements<T> + 1;
+				usage.heap_size += obj.size() * sizeof(element) + blocks * sizeof(void *);
+				usage.slack += blocks * block_elements<T> * sizeof(element) - obj.size() * sizeof(element);
+				for (const auto & e : obj)
+					usage += get_heap_element_usage(e);
+			}
+			else if constexpr (node_container<T>) {
+				if constexpr (hashed_container<T>)
+					usage.heap_size += obj.bucket_count() * sizeof(void *);
+				for (const auto & e : obj) {
+					usage.heap_size += sizeof(typename T::value_type) + node_overhead<T>;
+					usage += get_heap_element_usage(e);
+				}
+			}
+			else if constexpr (fixed_size_range<T>) {
+				for (const auto & e : obj)
+					usage += get_nested_usage(e);
+			}
+			else if constexpr (is_unique_ptr<T>()) {
+				if (obj) {
+					const auto pointee = get_usage(*obj);
+					usage.heap_size += pointee.inline_size + pointee.heap_size;
+					usage.slack += pointee.slack;
+					usage.heap_padding += pointee.padding + pointee.heap_padding;
+				}
+			}
+			else if constexpr (is_optional<T>()) {
+				if (obj)
+					usage += get_nested_usage(*obj);
+			}
+			else if constexpr (requires { obj.first; obj.second; }) { // Elements of maps
+				usage += get_nested_usage(obj.first);
+				usage += get_nested_usage(obj.second);
+			}
+
+			return usage;
+		}
+	}
+
+	inline std::size_t memory_usage_info::get_total() const noexcept {
+		return inline_size + heap_size + slack;
+	}
+
+	inline memory_usage_info & memory_usage_info::operator+=(const memory_usage_info & rhs) noexcept {
+		inline_size += rhs.inline_size;
+		heap_size += rhs.heap_size;
+		slack += rhs.slack;
+		padding += rhs.padding;
+		heap_padding += rhs.heap_padding;
+		return *this;
+	}
+
+	template<typename T>
+	memory_usage_info memory_usage(const T & obj) noexcept {
+		return detail::memory_usage::get_usage(obj);
+	}
+
+	template<typename T>
+	memory_usage_breakdown get_memory_usage_breakdown(std::span<const T> objects) {
+		memory_usage_breakdown ret;
+		ret.object_count = objects.size();
+
+		for_each_attribute<T>([&](const auto & attr) {
+			ret.attributes.push_back({ .name = attr.name, .usage = {} });
+		});
+
+		for (const auto & obj : objects) {
+			ret.total += memory_usage(obj);
+
+			std::size_t index = 0;
+			for_each_attribute(obj, [&](const auto & attr) noexcept {
+				ret.attributes[index++].usage += memory_usage(attr.member);
+			});
+		}
+		return ret;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// stl
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace putils::reflection {
+	// Call count and latency histogram for a reflected method, aggregated over all threads
+	// Calls are only recorded when PUTILS_REFLECTION_INSTRUMENT_METHODS is defined, for the functors returned by
+	// `get_method(obj, name)` and passed by `for_each_method(obj, func)`. Otherwise, they compile to the plain calls
+	struct method_stats {
+		static constexpr std::size_t bucket_count = 64;
+
+		const void * key = nullptr; // identifies the method, as class_name and method_name are only meant for display
+		std::string_view class_name; // empty for types without a class name
+		std::string_view method_name;
+		std::uint64_t call_count = 0;
+		std::uint64_t total_nanoseconds = 0;
+		// buckets[i] counts the calls that took [2^(i-1), 2^i) nanoseconds, with buckets[0] for calls under a nanosecond
+		std::array<std::uint64_t, bucket_count> buckets{};
+
+		// Upper bound of the bucket containing the given percentile (in [0, 1]) of the calls, in nanoseconds
+		std::uint64_t get_percentile_upper_bound(double percentile) const noexcept;
+	};
+
+	// Get the calls recorded so far by all threads, including threads that have exited
+	// Recording threads don't wait for this: each thread only writes to its own counters, which are read atomically
+	std::vector<method_stats> get_method_stats() noexcept;
+}
+
+#include "method_stats.inl"
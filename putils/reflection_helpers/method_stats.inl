@@ -0,0 +1,160 @@
+#include "method_stats.hpp"
+
+// stl
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+namespace putils::reflection {
+	namespace detail::method_stats {
+		// Identifies a reflected method. `key` is the address of its method_info in its type's reflection info
+		struct method_id {
+			const void * key;
+			const char * class_name;
+			const char * method_name;
+		};
+
+		struct counters {
+			method_id id;
+			std::atomic<std::uint64_t> call_count = 0;
+			std::atomic<std::uint64_t> total_nanoseconds = 0;
+			std::array<std::atomic<std::uint64_t>, putils::reflection::method_stats::bucket_count> buckets{};
+		};
+
+		// Only the owning thread writes to its counters, so a relaxed load and store is enough and never contends
+		inline void increment(std::atomic<std::uint64_t> & value, std::uint64_t amount) noexcept {
+			value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		// Entries are matched by key, as types without a class name would otherwise share their methods' stats
+		inline void accumulate(std::vector<putils::reflection::method_stats> & stats, const counters & c) noexcept {
+			auto it = std::find_if(stats.begin(), stats.end(), [&](const auto & s) noexcept {
+				return s.key == c.id.key;
+			});
+			if (it == stats.end()) {
+				stats.push_back({
+					.key = c.id.key,
+					.class_name = c.id.class_name ? c.id.class_name : "",
+					.method_name = c.id.method_name,
+				});
+				it = stats.end() - 1;
+			}
+
+			it->call_count += c.call_count.load(std::memory_order_relaxed);
+			it->total_nanoseconds += c.total_nanoseconds.load(std::memory_order_relaxed);
+			for (std::size_t i = 0; i < c.buckets.size(); ++i)
+				it->buckets[i] += c.buckets[i].load(std::memory_order_relaxed);
+		}
+
+		struct thread_storage;
+
+		struct registry {
+			std::mutex mutex;
+			std::vector<thread_storage *> threads;
+			std::vector<putils::reflection::method_stats> retired; // calls recorded by threads that have exited
+		};
+
+		inline registry & get_registry() noexcept {
+			static registry instance;
+			return instance;
+		}
+
+		struct thread_storage {
+			thread_storage() noexcept {
+				auto & r = get_registry();
+				const std::lock_guard lock(r.mutex);
+				r.threads.push_back(this);
+			}
+
+			~thread_storage() noexcept {
+				auto & r = get_registry();
+				const std::lock_guard lock(r.mutex);
+				for (const auto & c : entries)
+					accumulate(r.retired, c);
+				std::erase(r.threads, this);
+			}
+
+			counters & get_counters(const method_id & id) noexcept {
+				const auto it = index.find(id.key);
+				if (it != index.end())
+					return *it->second;
+
+				const std::lock_guard lock(mutex);
+				auto & c = entries.emplace_back(id);
+				index.emplace(id.key, &c);
+				return c;
+			}
+
+			std::mutex mutex; // held while adding entries, and by get_method_stats while reading them
+			std::deque<counters> entries; // deque, so that entries never move
+			std::unordered_map<const void *, counters *> index; // only accessed by the owning thread
+		};
+
+		inline thread_storage & get_thread_storage() noexcept {
+			thread_local thread_storage storage;
+			return storage;
+		}
+
+		inline void record(const method_id & id, std::uint64_t nanoseconds) noexcept {
+			auto & c = get_thread_storage().get_counters(id);
+			increment(c.call_count, 1);
+			increment(c.total_nanoseconds, nanoseconds);
+			const auto bucket = std::min<std::size_t>(std::bit_width(nanoseconds), c.buckets.size() - 1);
+			increment(c.buckets[bucket], 1);
+		}
+
+		// Records the time spent in its scope. Does nothing during constant evaluation
+		class scoped_timer {
+		public:
+			constexpr scoped_timer(const method_id & id) noexcept
+				: _id(id)
+			{
+				if (!std::is_constant_evaluated())
+					_start = std::chrono::steady_clock::now();
+			}
+
+			constexpr ~scoped_timer() noexcept {
+				if (!std::is_constant_evaluated() && _id.key) {
+					const auto duration = std::chrono::steady_clock::now() - _start;
+					record(_id, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+				}
+			}
+
+			scoped_timer(const scoped_timer &) = delete;
+			scoped_timer & operator=(const scoped_timer &) = delete;
+
+		private:
+			method_id _id;
+			std::chrono::steady_clock::time_point _start{};
+		};
+	}
+
+	inline std::uint64_t method_stats::get_percentile_upper_bound(double percentile) const noexcept {
+		const auto target = std::uint64_t(percentile * double(call_count));
+		std::uint64_t seen = 0;
+		for (std::size_t i = 0; i < buckets.size(); ++i) {
+			seen += buckets[i];
+			if (seen > 0 && seen >= target)
+				return std::uint64_t(1) << i;
+		}
+		return 0;
+	}
+
+	inline std::vector<method_stats> get_method_stats() noexcept {
+		auto & r = detail::method_stats::get_registry();
+		const std::lock_guard lock(r.mutex);
+
+		auto ret = r.retired;
+		for (const auto thread : r.threads) {
+			const std::lock_guard thread_lock(thread->mutex);
+			for (const auto & c : thread->entries)
+				detail::method_stats::accumulate(ret, c);
+		}
+		return ret;
+	}
+}
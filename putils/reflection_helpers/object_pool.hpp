@@ -0,0 +1,56 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	// Pool of default-constructed T objects, recycled by resetting their attributes in place instead of destroying them
+	// Resetting an object sets each of its non-const attributes back to its value in a default-constructed reference instance:
+	//	- trivially copyable attributes of standard-layout types are copied with memcpy runs (see convert)
+	//	- reflectible attributes are reset recursively
+	//	- containers (anything with `clear()` and `empty()`) whose default value is empty are cleared, keeping their capacity
+	//	- other attributes are copy-assigned from the reference
+	//	- attributes that can't be copied (e.g. std::unique_ptr) are cleared if they're containers, or move-assigned a value-initialized
+	//	  value otherwise, regardless of their value in the reference
+	// Attributes that aren't reflected are left untouched
+	template<typename T>
+	class object_pool {
+	public:
+		// Objects are allocated `chunk_size` at a time. Pointers to them stay valid until the pool is destroyed
+		explicit object_pool(std::size_t chunk_size = 64) noexcept;
+
+		// Get an object in its default state
+		T * acquire() noexcept;
+
+		// Reset obj in place and make it available to acquire again
+		void release(T * obj) noexcept;
+
+		// Total number of objects allocated by the pool
+		std::size_t get_allocated_count() const noexcept;
+
+		// Number of objects ready to be acquired
+		std::size_t get_free_count() const noexcept;
+
+		void reserve(std::size_t count) noexcept;
+
+	private:
+		void allocate_chunk(std::size_t size) noexcept;
+
+		std::size_t _chunk_size;
+		T _reference{};
+		std::vector<std::unique_ptr<T[]>> _chunks;
+		std::size_t _allocated_count = 0;
+		std::vector<T *> _free;
+	};
+
+	// Reset obj's attributes to their value in `reference`, following the same rules as object_pool
+	template<typename T>
+	void reset_in_place(T & obj, const T & reference) noexcept;
+}
+
+#include "object_pool.inl"
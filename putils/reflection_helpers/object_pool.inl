@@ -0,0 +1,120 @@
+#include "object_pool.hpp"
+
+// stl
+#include <concepts>
+#include <type_traits>
+
+// reflection
+#include "convert.hpp"
+
+namespace putils::reflection {
+	namespace detail::object_pool {
+		template<typename T>
+		concept clearable = requires(T & obj) {
+			obj.clear();
+			{ obj.empty() } -> std::convertible_to<bool>;
+		};
+
+		// Containers' copy operations exist even when their elements can't be copied, so check the elements too
+		template<typename T>
+		constexpr bool is_copyable() noexcept {
+			if constexpr (!std::is_copy_constructible_v<T>)
+				return false;
+			else if constexpr (requires { typename T::first_type; typename T::second_type; })
+				return is_copyable<typename T::first_type>() && is_copyable<typename T::second_type>();
+			else if constexpr (requires { typename T::value_type; }) {
+				if constexpr (std::is_same_v<typename T::value_type, T>) // e.g. std::filesystem::path
+					return true;
+				else
+					return is_copyable<typename T::value_type>();
+			}
+			else
+				return true;
+		}
+	}
+
+	template<typename T>
+	void reset_in_place(T & obj, const T & reference) noexcept {
+		using namespace detail::convert;
+
+		copy_runs(reference, obj);
+
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) noexcept {
+			([&] {
+				constexpr auto kind = field_kinds<T, T>[Is];
+				if constexpr (kind != field_kind::none && kind != field_kind::copy) {
+					constexpr auto ptr = std::get<Is>(get_attributes<T>()).ptr;
+					using member = putils::member_type<putils_typeof(ptr)>;
+					auto & dst = obj.*ptr;
+					const auto & src = reference.*ptr;
+
+					if constexpr (has_attributes<member>())
+						reset_in_place(dst, src);
+					else if constexpr (std::is_copy_assignable_v<member> && detail::object_pool::is_copyable<member>()) {
+						if constexpr (detail::object_pool::clearable<member>) {
+							if (src.empty()) {
+								dst.clear();
+								return;
+							}
+						}
+						dst = src;
+					}
+					else if constexpr (detail::object_pool::clearable<member>)
+						dst.clear();
+					else {
+						static_assert(std::is_default_constructible_v<member> && std::is_move_assignable_v<member>, "Attribute cannot be reset");
+						dst = member{};
+					}
+				}
+			}(),
+			 ...);
+		}(std::make_index_sequence<attribute_count<T>>());
+	}
+
+	template<typename T>
+	object_pool<T>::object_pool(std::size_t chunk_size) noexcept
+		: _chunk_size(chunk_size > 0 ? chunk_size : 1) {}
+
+	template<typename T>
+	T * object_pool<T>::acquire() noexcept {
+		if (_free.empty())
+			allocate_chunk(_chunk_size);
+
+		const auto ret = _free.back();
+		_free.pop_back();
+		return ret;
+	}
+
+	template<typename T>
+	void object_pool<T>::release(T * obj) noexcept {
+		reset_in_place(*obj, _reference);
+		_free.push_back(obj);
+	}
+
+	template<typename T>
+	std::size_t object_pool<T>::get_allocated_count() const noexcept {
+		return _allocated_count;
+	}
+
+	template<typename T>
+	std::size_t object_pool<T>::get_free_count() const noexcept {
+		return _free.size();
+	}
+
+	template<typename T>
+	void object_pool<T>::reserve(std::size_t count) noexcept {
+		if (count > _allocated_count)
+			allocate_chunk(count - _allocated_count);
+	}
+
+	template<typename T>
+	void object_pool<T>::allocate_chunk(std::size_t size) noexcept {
+		auto & chunk = _chunks.emplace_back(std::make_unique<T[]>(size));
+		_allocated_count += size;
+
+		// Push in reverse so that objects are acquired in address order
+		_free.reserve(_free.size() + size);
+		for (std::size_t i = size; i-- > 0;)
+			_free.push_back(&chunk[i]);
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// stl
+#include <string_view>
+
+// reflection
+#include "putils/reflection.hpp"
+#include "type_id.hpp"
+
+namespace putils::reflection {
+	// Type-erased accessor to a (possibly nested) attribute of T, e.g. "transform.position.x"
+	template<typename T>
+	struct attribute_path {
+		std::string_view path;
+		type_id type; // type of the attribute, without const
+		bool is_const;
+		void * (*get_address)(T & obj) noexcept; // const attributes are returned without their const
+
+		// Get a pointer to the attribute in obj, or nullptr if it isn't a Member. Const attributes require a const Member
+		template<typename Member>
+		Member * get(T & obj) const noexcept;
+
+		template<typename Member>
+		const Member * get(const T & obj) const noexcept;
+	};
+
+	// Get a std::array of the attribute_paths for all attributes of T, and recursively for all attributes of its reflectible attributes
+	template<typename T>
+	consteval const auto & get_attribute_paths() noexcept;
+
+	// Find the attribute_path for `path` with a single hashed lookup, or nullptr
+	template<typename T>
+	constexpr const attribute_path<T> * resolve_path(std::string_view path) noexcept;
+
+	// Get a pointer to the attribute at `path` in obj, or nullptr if there is no such attribute or it isn't a Member
+	template<typename Member, typename T>
+	auto /* [const] Member * */ resolve_path(T && obj, std::string_view path) noexcept;
+}
+
+#include "resolve_path.inl"
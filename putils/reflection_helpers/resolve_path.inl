@@ -0,0 +1,159 @@
+#include "resolve_path.hpp"
+
+// stl
+#include <array>
+#include <string>
+#include <type_traits>
+
+// meta
+#include "putils/meta/fwd.hpp"
+
+namespace putils::reflection {
+	namespace detail::resolve_path {
+		template<typename T, std::size_t I>
+		using member_at = putils::member_type<putils_typeof(std::get<I>(get_attributes<T>()).ptr)>;
+
+		template<typename T>
+		constexpr auto attribute_indices = std::make_index_sequence<std::tuple_size_v<putils_typeof(get_attributes<T>())>>();
+
+		template<typename Member>
+		constexpr bool is_nested = has_attributes<std::remove_const_t<Member>>();
+
+		template<typename T>
+		constexpr std::size_t count_paths() noexcept {
+			return []<std::size_t... Is>(std::index_sequence<Is...>) noexcept {
+				std::size_t ret = 0;
+				([&] {
+					using member = std::remove_const_t<member_at<T, Is>>;
+					++ret;
+					if constexpr (is_nested<member>)
+						ret += count_paths<member>();
+				}(),
+				 ...);
+				return ret;
+			}(attribute_indices<T>);
+		}
+
+		// Walk T's attributes depth-first, calling func(path, member_type, attribute_indices) for each of them
+		// T may be const, in which case all its attributes are reported as const
+		template<typename T, std::size_t... Path, typename Func>
+		constexpr void for_each_path(std::string & prefix, Func && func) noexcept {
+			using type = std::remove_const_t<T>;
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) noexcept {
+				([&] {
+					using member = std::conditional_t<std::is_const_v<T>, const member_at<type, Is>, member_at<type, Is>>;
+					const auto prefix_size = prefix.size();
+					prefix += std::get<Is>(get_attributes<type>()).name;
+					func(std::string_view(prefix), putils::meta::type<member>(), std::index_sequence<Path..., Is>());
+
+					if constexpr (is_nested<member>) {
+						prefix += '.';
+						for_each_path<member, Path..., Is>(prefix, func);
+					}
+					prefix.resize(prefix_size);
+				}(),
+				 ...);
+			}(attribute_indices<type>);
+		}
+
+		template<typename T>
+		constexpr std::size_t count_path_chars() noexcept {
+			std::size_t ret = 0;
+			std::string prefix;
+			for_each_path<T>(prefix, [&](std::string_view path, auto, auto) noexcept {
+				ret += path.size();
+			});
+			return ret;
+		}
+
+		// All paths, concatenated
+		template<typename T>
+		constexpr auto path_chars = [] {
+			std::array<char, count_path_chars<T>()> ret{};
+			std::size_t offset = 0;
+			std::string prefix;
+			for_each_path<T>(prefix, [&](std::string_view path, auto, auto) noexcept {
+				for (const char c : path)
+					ret[offset++] = c;
+			});
+			return ret;
+		}();
+
+		template<typename T, std::size_t I, std::size_t... Is>
+		constexpr auto & get_member(T & obj) noexcept {
+			auto & member = obj.*std::get<I>(get_attributes<std::remove_const_t<T>>()).ptr;
+			if constexpr (sizeof...(Is) == 0)
+				return member;
+			else
+				return get_member<std::remove_reference_t<decltype(member)>, Is...>(member);
+		}
+
+		template<typename T, std::size_t... Is>
+		void * get_address(T & obj) noexcept {
+			return const_cast<void *>(static_cast<const void *>(&get_member<T, Is...>(obj)));
+		}
+
+		template<typename T>
+		constexpr auto paths = [] {
+			std::array<attribute_path<T>, count_paths<T>()> ret{};
+			std::size_t index = 0;
+			std::size_t offset = 0;
+			std::string prefix;
+			for_each_path<T>(prefix, [&]<typename Member, std::size_t... Is>(std::string_view path, putils::meta::type<Member>, std::index_sequence<Is...>) noexcept {
+				ret[index++] = {
+					.path = { path_chars<T>.data() + offset, path.size() },
+					.type = get_type_id<std::remove_const_t<Member>>(),
+					.is_const = std::is_const_v<Member>,
+					.get_address = &get_address<T, Is...>,
+				};
+				offset += path.size();
+			});
+			return ret;
+		}();
+
+		template<typename T>
+		constexpr auto path_index = [] {
+			std::array<std::string_view, paths<T>.size()> names;
+			for (std::size_t i = 0; i < names.size(); ++i)
+				names[i] = paths<T>[i].path;
+			return detail::make_name_index(names);
+		}();
+	}
+
+	template<typename T>
+	template<typename Member>
+	Member * attribute_path<T>::get(T & obj) const noexcept {
+		if (type != get_type_id<std::remove_const_t<Member>>() || (is_const && !std::is_const_v<Member>))
+			return nullptr;
+		return static_cast<Member *>(get_address(obj));
+	}
+
+	template<typename T>
+	template<typename Member>
+	const Member * attribute_path<T>::get(const T & obj) const noexcept {
+		return get<const Member>(const_cast<T &>(obj));
+	}
+
+	template<typename T>
+	consteval const auto & get_attribute_paths() noexcept {
+		return detail::resolve_path::paths<T>;
+	}
+
+	template<typename T>
+	constexpr const attribute_path<T> * resolve_path(std::string_view path) noexcept {
+		const auto index = detail::resolve_path::path_index<T>.find(path);
+		if (!index)
+			return nullptr;
+		return &detail::resolve_path::paths<T>[*index];
+	}
+
+	template<typename Member, typename T>
+	auto resolve_path(T && obj, std::string_view path) noexcept {
+		using return_type = decltype(std::declval<const attribute_path<std::decay_t<T>> &>().template get<Member>(obj));
+
+		const auto attr = resolve_path<std::decay_t<T>>(path);
+		if (!attr)
+			return return_type(nullptr);
+		return attr->template get<Member>(obj);
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+#include "binary_serializer.hpp"
+
+// Binary RPC over the methods of a reflectible type
+// All messages are encoded with to_binary. Client and server exchange:
+//	- a handshake, in which the client sends the names of T's methods and a hash of their signature, and the server replies with its index
+//	  for each of them. Methods whose signature doesn't match the server's are unknown to the server
+//	- call frames, each holding a batch of calls (method index followed by arguments), to which the server replies with a result frame
+//	  holding a status and the encoded return value of each call
+// Messages can be sent over any byte stream by prefixing them with their size, see write_rpc_message and rpc_message_reader
+// Methods taking non-const lvalue references, or whose arguments or return value can't be serialized, can't be called remotely
+
+namespace putils::reflection {
+	enum class rpc_status : std::uint8_t {
+		ok,
+		unknown_method,
+		invalid_arguments,
+		not_executed, // a previous call in the same batch failed
+	};
+
+	static constexpr std::uint32_t rpc_invalid_method_index = ~std::uint32_t(0);
+
+	template<typename T>
+	class rpc_server {
+	public:
+		explicit rpc_server(T & service) noexcept;
+
+		// Reply to a handshake created by rpc_client::make_handshake
+		void handle_handshake(std::span<const char> request, std::vector<char> & reply) const noexcept;
+
+		// Execute all calls in `frame` and append their results to `reply`
+		// Execution stops at the first call with an unknown method or invalid arguments, as the following calls can't be decoded
+		// Returns false if not all calls were executed
+		bool handle_calls(std::span<const char> frame, std::vector<char> & reply) noexcept;
+
+	private:
+		T & _service;
+	};
+
+	// Results of a batch of calls, decoded from a result frame
+	class rpc_results {
+	public:
+		// Returns nullopt if `frame` is not a valid result frame
+		static std::optional<rpc_results> parse(std::span<const char> frame) noexcept;
+
+		std::size_t size() const noexcept;
+		rpc_status get_status(std::size_t call) const noexcept;
+
+		// Get the return value of call `call`, or nullopt if it failed or its return value can't be decoded as a `Ret`
+		template<typename Ret>
+		std::optional<Ret> get(std::size_t call) const noexcept;
+
+	private:
+		struct result {
+			rpc_status status;
+			std::span<const char> value;
+		};
+		std::vector<result> _results;
+	};
+
+	template<typename T>
+	class rpc_client {
+	public:
+		std::vector<char> make_handshake() const noexcept;
+
+		// Store the server's method indices. Returns false if `reply` is invalid
+		bool handle_handshake(std::span<const char> reply) noexcept;
+
+		// Queue a call to `Method` in the current batch, and get its position in the batch's results
+		template<auto Method, typename... Args>
+		std::size_t call(Args &&... args) noexcept;
+
+		// Queue a call to the method called `method`. Returns nullopt if T has no such method that can be called with `args`
+		template<typename... Args>
+		std::optional<std::size_t> call(std::string_view method, Args &&... args) noexcept;
+
+		// Get the call frame for all calls queued since the last flush
+		std::vector<char> flush() noexcept;
+
+	private:
+		template<std::size_t I, typename... Args>
+		void write_call(Args &&... args) noexcept;
+
+		std::vector<std::uint32_t> _server_indices;
+		std::vector<char> _calls;
+		std::uint32_t _call_count = 0;
+	};
+
+	// Append `message` to `stream`, prefixed by its size
+	void write_rpc_message(std::span<const char> message, std::vector<char> & stream) noexcept;
+
+	// Accumulates bytes received from a stream and splits them into the messages written by write_rpc_message
+	class rpc_message_reader {
+	public:
+		void append(std::span<const char> bytes) noexcept;
+
+		// Get the next complete message, or nullopt if more bytes are needed
+		std::optional<std::vector<char>> next_message() noexcept;
+
+	private:
+		std::vector<char> _buffer;
+		std::size_t _read_offset = 0;
+	};
+}
+
+#include "rpc.inl"
@@ -0,0 +1,390 @@
+#include "rpc.hpp"
+
+// stl
+#include <array>
+#include <cstring>
+#include <string>
+#include <tuple>
+
+// meta
+#include "putils/meta/fwd.hpp"
+
+namespace putils::reflection {
+	namespace detail::rpc {
+		// Arguments are decoded into owning types, e.g. std::string for std::string_view parameters
+		template<typename Arg>
+		struct stored_argument {
+			using type = std::decay_t<Arg>;
+		};
+
+		template<typename Arg>
+			requires binary::string_view<std::decay_t<Arg>>
+		struct stored_argument<Arg> {
+			using type = std::basic_string<typename std::decay_t<Arg>::value_type, typename std::decay_t<Arg>::traits_type>;
+		};
+
+		// Arguments decoded by the server can't be sent back, so methods taking non-const lvalue references can't be called remotely
+		template<typename Arg>
+		constexpr bool is_remote_argument = !(std::is_lvalue_reference_v<Arg> && !std::is_const_v<std::remove_reference_t<Arg>>) && binary::is_serializable<typename stored_argument<Arg>::type>();
+
+		template<typename Ret>
+		constexpr bool is_remote_return_type = std::is_void_v<Ret> || binary::string_view<std::decay_t<Ret>> || binary::is_serializable<std::decay_t<Ret>>();
+
+		template<typename Signature>
+		struct signature_traits;
+
+		template<typename Ret, typename... Args>
+		struct signature_traits<Ret(Args...)> {
+			using return_type = Ret;
+			using arguments = std::tuple<typename stored_argument<Args>::type...>;
+
+			static constexpr bool is_remote_callable = is_remote_return_type<Ret> && (is_remote_argument<Args> && ...);
+
+			// Hash of the encoding of the arguments and return value, so that client and server can check they agree on them
+			static constexpr std::uint64_t get_hash() noexcept {
+				if constexpr (!is_remote_callable)
+					return 0;
+				else {
+					auto hash = binary::hash_combine(14695981039346656037ull, sizeof...(Args));
+					((hash = binary::get_encoding_hash<typename stored_argument<Args>::type>(hash)), ...);
+					if constexpr (std::is_void_v<Ret>)
+						return binary::hash_combine(hash, 'v');
+					else
+						return binary::get_encoding_hash<std::decay_t<Ret>>(hash);
+				}
+			}
+		};
+
+		template<typename T, std::size_t I>
+		using method_traits = signature_traits<putils::member_function_signature<putils_typeof(std::get<I>(get_methods<T>()).ptr)>>;
+
+		template<typename T>
+		constexpr auto method_count = std::tuple_size_v<putils_typeof(get_methods<T>())>;
+
+		template<typename Arguments, typename... Args>
+		consteval bool can_call() noexcept {
+			if constexpr (sizeof...(Args) != std::tuple_size_v<Arguments>)
+				return false;
+			else
+				return []<std::size_t... Is>(std::index_sequence<Is...>) {
+					return (std::is_constructible_v<std::tuple_element_t<Is, Arguments>, Args &&> && ...);
+				}(std::index_sequence_for<Args...>());
+		}
+
+		template<typename T, auto Method>
+		consteval std::size_t get_method_index() noexcept {
+			std::size_t ret = method_count<T>;
+			std::size_t index = 0;
+			for_each_method<T>([&](const auto & method) {
+				if constexpr (std::is_same_v<putils_typeof(method.ptr), decltype(Method)>) {
+					if (ret == method_count<T> && method.ptr == Method)
+						ret = index;
+				}
+				++index;
+			});
+			return ret;
+		}
+
+		template<typename T>
+		using method_handler = rpc_status (*)(T & service, std::span<const char> frame, std::size_t & offset, std::vector<char> & result) noexcept;
+
+		// Decode the arguments for method I, call it and encode its return value
+		template<typename T, std::size_t I>
+		rpc_status handle_method(T & service, std::span<const char> frame, std::size_t & offset, std::vector<char> & result) noexcept {
+			constexpr auto ptr = std::get<I>(get_methods<T>()).ptr;
+			using traits = method_traits<T, I>;
+
+			typename traits::arguments args;
+			const bool decoded = std::apply(
+				[&](auto &... arg) noexcept {
+					return (detail::binary::read(frame, offset, arg) && ...);
+				},
+				args
+			);
+			if (!decoded)
+				return rpc_status::invalid_arguments;
+
+			const auto call = [&](auto &... arg) noexcept -> decltype(auto) {
+				return (service.*ptr)(std::move(arg)...);
+			};
+
+			if constexpr (std::is_void_v<typename traits::return_type>)
+				std::apply(call, args);
+			else
+				detail::binary::write(std::apply(call, args), result);
+			return rpc_status::ok;
+		}
+
+		// Methods that can't be called remotely are answered as if they didn't exist
+		template<typename T>
+		rpc_status handle_unknown_method(T &, std::span<const char>, std::size_t &, std::vector<char> &) noexcept {
+			return rpc_status::unknown_method;
+		}
+
+		template<typename T, std::size_t I>
+		consteval method_handler<T> get_method_handler() noexcept {
+			if constexpr (method_traits<T, I>::is_remote_callable)
+				return &handle_method<T, I>;
+			else
+				return &handle_unknown_method<T>;
+		}
+
+		// Jump table mapping method indices to their handler
+		template<typename T, std::size_t... Is>
+		consteval auto make_method_handlers(std::index_sequence<Is...>) noexcept {
+			return std::array<method_handler<T>, sizeof...(Is)>{ get_method_handler<T, Is>()... };
+		}
+
+		template<typename T, std::size_t... Is>
+		consteval auto make_method_hashes(std::index_sequence<Is...>) noexcept {
+			return std::array<std::uint64_t, sizeof...(Is)>{ method_traits<T, Is>::get_hash()... };
+		}
+
+		template<typename T>
+		constexpr auto method_hashes = make_method_hashes<T>(std::make_index_sequence<method_count<T>>());
+
+		template<typename T>
+		constexpr auto method_handlers = make_method_handlers<T>(std::make_index_sequence<method_count<T>>());
+
+		inline void write_at(std::vector<char> & out, std::size_t offset, std::uint32_t value) noexcept {
+			binary::copy_little_endian(out.data() + offset, &value, sizeof(value));
+		}
+	}
+
+	template<typename T>
+	rpc_server<T>::rpc_server(T & service) noexcept
+		: _service(service) {}
+
+	template<typename T>
+	void rpc_server<T>::handle_handshake(std::span<const char> request, std::vector<char> & reply) const noexcept {
+		std::size_t offset = 0;
+		std::uint32_t count = 0;
+		if (!detail::binary::read(request, offset, count))
+			count = 0;
+
+		const auto count_offset = reply.size();
+		detail::binary::write(count, reply);
+
+		std::uint32_t resolved_count = 0;
+		std::string name;
+		std::uint64_t hash;
+		for (; resolved_count < count; ++resolved_count) {
+			if (!detail::binary::read(request, offset, name) || !detail::binary::read(request, offset, hash))
+				break;
+
+			// Methods whose arguments or return value are encoded differently by the client are treated as unknown
+			std::uint32_t index = 0;
+			std::uint32_t server_index = rpc_invalid_method_index;
+			for_each_method<T>([&](const auto & method) noexcept {
+				const auto method_hash = detail::rpc::method_hashes<T>[index];
+				if (server_index == rpc_invalid_method_index && name == method.name && method_hash != 0 && hash == method_hash)
+					server_index = index;
+				++index;
+			});
+			detail::binary::write(server_index, reply);
+		}
+		detail::rpc::write_at(reply, count_offset, resolved_count);
+	}
+
+	template<typename T>
+	bool rpc_server<T>::handle_calls(std::span<const char> frame, std::vector<char> & reply) noexcept {
+		std::size_t offset = 0;
+		std::uint32_t count = 0;
+		if (!detail::binary::read(frame, offset, count))
+			return false;
+
+		const auto count_offset = reply.size();
+		detail::binary::write(count, reply);
+
+		std::uint32_t executed_count = 0;
+		bool ok = true;
+		for (; executed_count < count && ok; ++executed_count) {
+			std::uint32_t method_index;
+			if (!detail::binary::read(frame, offset, method_index))
+				break;
+
+			const auto status_offset = reply.size();
+			detail::binary::write(rpc_status::ok, reply);
+			const auto size_offset = reply.size();
+			detail::binary::write(std::uint32_t(0), reply);
+
+			auto status = rpc_status::unknown_method;
+			if (method_index < detail::rpc::method_count<T>)
+				status = detail::rpc::method_handlers<T>[method_index](_service, frame, offset, reply);
+
+			// We can't know where the next call starts if this one couldn't be decoded
+			if (status != rpc_status::ok) {
+				ok = false;
+				reply.resize(size_offset + sizeof(std::uint32_t));
+			}
+
+			reply[status_offset] = char(status);
+			detail::rpc::write_at(reply, size_offset, std::uint32_t(reply.size() - size_offset - sizeof(std::uint32_t)));
+		}
+
+		detail::rpc::write_at(reply, count_offset, executed_count);
+		return ok && executed_count == count;
+	}
+
+	inline std::optional<rpc_results> rpc_results::parse(std::span<const char> frame) noexcept {
+		std::size_t offset = 0;
+		std::uint32_t count = 0;
+		if (!detail::binary::read(frame, offset, count))
+			return std::nullopt;
+
+		rpc_results ret;
+		ret._results.reserve(count);
+		for (std::uint32_t i = 0; i < count; ++i) {
+			rpc_status status;
+			std::uint32_t size;
+			if (!detail::binary::read(frame, offset, status) || !detail::binary::read(frame, offset, size))
+				return std::nullopt;
+			if (frame.size() - offset < size)
+				return std::nullopt;
+
+			ret._results.push_back({ .status = status, .value = frame.subspan(offset, size) });
+			offset += size;
+		}
+		return ret;
+	}
+
+	inline std::size_t rpc_results::size() const noexcept {
+		return _results.size();
+	}
+
+	inline rpc_status rpc_results::get_status(std::size_t call) const noexcept {
+		if (call >= _results.size())
+			return rpc_status::not_executed;
+		return _results[call].status;
+	}
+
+	template<typename Ret>
+	std::optional<Ret> rpc_results::get(std::size_t call) const noexcept {
+		if (get_status(call) != rpc_status::ok)
+			return std::nullopt;
+
+		const auto value = _results[call].value;
+		Ret ret;
+		if (from_binary(value, ret) != value.size())
+			return std::nullopt;
+		return ret;
+	}
+
+	template<typename T>
+	std::vector<char> rpc_client<T>::make_handshake() const noexcept {
+		std::vector<char> ret;
+		detail::binary::write(std::uint32_t(detail::rpc::method_count<T>), ret);
+		std::size_t index = 0;
+		for_each_method<T>([&](const auto & method) noexcept {
+			detail::binary::write(std::string_view(method.name), ret);
+			detail::binary::write(detail::rpc::method_hashes<T>[index++], ret);
+		});
+		return ret;
+	}
+
+	template<typename T>
+	bool rpc_client<T>::handle_handshake(std::span<const char> reply) noexcept {
+		std::size_t offset = 0;
+		std::uint32_t count = 0;
+		if (!detail::binary::read(reply, offset, count) || count != detail::rpc::method_count<T>)
+			return false;
+
+		std::vector<std::uint32_t> indices(count);
+		for (auto & index : indices)
+			if (!detail::binary::read(reply, offset, index))
+				return false;
+
+		_server_indices = std::move(indices);
+		return true;
+	}
+
+	template<typename T>
+	template<auto Method, typename... Args>
+	std::size_t rpc_client<T>::call(Args &&... args) noexcept {
+		constexpr auto index = detail::rpc::get_method_index<T, Method>();
+		static_assert(index < detail::rpc::method_count<T>, "Method is not reflected");
+		static_assert(detail::rpc::method_traits<T, index>::is_remote_callable, "Method can't be called remotely: its arguments and return value must be serializable, and it can't take non-const lvalue references");
+		static_assert(detail::rpc::can_call<typename detail::rpc::method_traits<T, index>::arguments, Args...>(), "Invalid arguments for method");
+
+		write_call<index>(FWD(args)...);
+		return _call_count - 1;
+	}
+
+	template<typename T>
+	template<typename... Args>
+	std::optional<std::size_t> rpc_client<T>::call(std::string_view method, Args &&... args) noexcept {
+		std::optional<std::size_t> ret;
+		const auto args_tuple = std::forward_as_tuple(FWD(args)...);
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			([&] {
+				using arguments = typename detail::rpc::method_traits<T, Is>::arguments;
+				if constexpr (detail::rpc::method_traits<T, Is>::is_remote_callable && detail::rpc::can_call<arguments, Args...>()) {
+					if (!ret && method == std::get<Is>(get_methods<T>()).name) {
+						std::apply([this](auto &&... arg) noexcept { write_call<Is>(FWD(arg)...); }, args_tuple);
+						ret = _call_count - 1;
+					}
+				}
+			}(),
+			 ...);
+		}(std::make_index_sequence<detail::rpc::method_count<T>>());
+		return ret;
+	}
+
+	template<typename T>
+	template<std::size_t I, typename... Args>
+	void rpc_client<T>::write_call(Args &&... args) noexcept {
+		// Before the handshake, assume the server has the same method indices
+		const auto server_index = _server_indices.empty() ? std::uint32_t(I) : _server_indices[I];
+		detail::binary::write(server_index, _calls);
+
+		// Convert to the parameter types first, so that e.g. string literals are written as strings
+		const typename detail::rpc::method_traits<T, I>::arguments converted{ FWD(args)... };
+		std::apply(
+			[this](const auto &... arg) noexcept {
+				(detail::binary::write(arg, _calls), ...);
+			},
+			converted
+		);
+
+		++_call_count;
+	}
+
+	template<typename T>
+	std::vector<char> rpc_client<T>::flush() noexcept {
+		std::vector<char> ret;
+		ret.reserve(sizeof(_call_count) + _calls.size());
+		detail::binary::write(_call_count, ret);
+		ret.insert(ret.end(), _calls.begin(), _calls.end());
+
+		_calls.clear();
+		_call_count = 0;
+		return ret;
+	}
+
+	inline void write_rpc_message(std::span<const char> message, std::vector<char> & stream) noexcept {
+		detail::binary::write(std::uint32_t(message.size()), stream);
+		stream.insert(stream.end(), message.begin(), message.end());
+	}
+
+	inline void rpc_message_reader::append(std::span<const char> bytes) noexcept {
+		// Drop already consumed messages before growing the buffer
+		if (_read_offset > 0 && _read_offset * 2 >= _buffer.size()) {
+			_buffer.erase(_buffer.begin(), _buffer.begin() + std::ptrdiff_t(_read_offset));
+			_read_offset = 0;
+		}
+		_buffer.insert(_buffer.end(), bytes.begin(), bytes.end());
+	}
+
+	inline std::optional<std::vector<char>> rpc_message_reader::next_message() noexcept {
+		const auto available = std::span<const char>(_buffer).subspan(_read_offset);
+
+		std::size_t offset = 0;
+		std::uint32_t size;
+		if (!detail::binary::read(available, offset, size) || available.size() - offset < size)
+			return std::nullopt;
+
+		std::vector<char> ret(available.begin() + std::ptrdiff_t(offset), available.begin() + std::ptrdiff_t(offset + size));
+		_read_offset += offset + size;
+		return ret;
+	}
+}
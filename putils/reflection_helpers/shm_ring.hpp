@@ -0,0 +1,105 @@
+#pragma once
+
+// stl
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	// Hash of T's class name, size, alignment and attribute names and sizes
+	// Used to check that processes sharing a ring agree on T's layout
+	template<typename T>
+	consteval std::uint64_t get_schema_hash() noexcept;
+
+	// Number of bytes needed for a ring of `capacity` records of type T
+	// Ring capacities are rounded up to a power of two
+	template<typename T>
+	constexpr std::size_t get_shm_ring_size(std::size_t capacity) noexcept;
+
+	// Single producer of a lock-free ring of T records, living in shared memory
+	// T must be trivially copyable: records are stored in their in-memory layout, so that subscribers can read them without deserializing
+	template<typename T>
+	class shm_publisher {
+	public:
+		// Create and map the POSIX shared memory object `name`, which is unlinked when the publisher is destroyed
+		// Always returns nullopt on Windows
+		static std::optional<shm_publisher> create(const char * name, std::size_t capacity) noexcept;
+
+		// Use caller-provided memory of at least `get_shm_ring_size<T>(capacity)` bytes, aligned on 64 bytes
+		shm_publisher(void * memory, std::size_t capacity) noexcept;
+		~shm_publisher() noexcept;
+
+		shm_publisher(shm_publisher && other) noexcept;
+		shm_publisher & operator=(shm_publisher && other) noexcept;
+
+		void publish(const T & obj) noexcept;
+
+		// Call `func(T &)` to fill the next record directly in shared memory
+		template<typename Func>
+		void publish_in_place(Func && func) noexcept;
+
+	private:
+		shm_publisher() noexcept = default;
+		void release() noexcept;
+
+		void * _memory = nullptr;
+		std::size_t _mapped_size = 0; // non-zero if we own a shared memory mapping
+		std::string _name;
+	};
+
+	// One of the consumers of a ring created by a shm_publisher
+	// Each subscriber has its own read position, starting at the publisher's current position
+	// Subscribers that fall more than `capacity` records behind skip the records that were overwritten
+	template<typename T>
+	class shm_subscriber {
+	public:
+		// Map the POSIX shared memory object `name` and validate its schema. Returns nullopt if it doesn't exist or doesn't match T
+		// Always returns nullopt on Windows
+		static std::optional<shm_subscriber> open(const char * name) noexcept;
+
+		// Validate the schema of a ring in caller-provided memory
+		static std::optional<shm_subscriber> attach(const void * memory) noexcept;
+
+		~shm_subscriber() noexcept;
+
+		shm_subscriber(shm_subscriber && other) noexcept;
+		shm_subscriber & operator=(shm_subscriber && other) noexcept;
+
+		// Copy the next record into `out`. Returns false if no new record is available
+		bool try_read(T & out) noexcept;
+
+		// Call `func(const T &)` on the next record, directly in shared memory
+		// Returns false if no record was available, or if the record was overwritten while `func` was reading it
+		// (in which case `func`'s results should be discarded)
+		template<typename Func>
+		bool try_read_in_place(Func && func) noexcept;
+
+		// Number of records that were overwritten before this subscriber could read them
+		std::uint64_t get_dropped_count() const noexcept;
+
+	private:
+		shm_subscriber() noexcept = default;
+		void release() noexcept;
+
+		enum class read_result {
+			read,
+			empty,
+			overwritten,
+		};
+
+		template<typename Func>
+		read_result read_next(Func && func) noexcept;
+
+		const void * _memory = nullptr;
+		std::size_t _mapped_size = 0; // non-zero if we own a shared memory mapping
+		std::uint64_t _read_index = 0;
+		std::uint64_t _dropped_count = 0;
+	};
+}
+
+#include "shm_ring.inl"
@@ -0,0 +1,371 @@
+#include "shm_ring.hpp"
+
+// stl
+#include <bit>
+#include <cstring>
+#include <new>
+#include <string_view>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace putils::reflection {
+	namespace detail::shm_ring {
+		static constexpr std::uint64_t magic = 0x474e495254555050; // "PPUTRING" in little-endian
+
+		struct header {
+			std::atomic<std::uint64_t> magic; // written last by the publisher, once everything else is initialized
+			std::uint64_t schema_hash;
+			std::uint64_t record_size;
+			std::uint64_t capacity;
+			char class_name[64];
+
+			// On its own cache line, as it is written for every record
+			alignas(64) std::atomic<std::uint64_t> write_index;
+		};
+
+		// `sequence` is odd while the record is being written, and `2 * index + 2` once record `index` is written
+		template<typename T>
+		struct alignas(64) slot {
+			std::atomic<std::uint64_t> sequence;
+			alignas(T) unsigned char record[sizeof(T)];
+		};
+
+		static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Lock-free 64-bit atomics are required to share them between processes");
+
+		inline header & get_header(void * memory) noexcept {
+			return *static_cast<header *>(memory);
+		}
+
+		inline const header & get_header(const void * memory) noexcept {
+			return *static_cast<const header *>(memory);
+		}
+
+		template<typename T>
+		slot<T> * get_slots(void * memory) noexcept {
+			return reinterpret_cast<slot<T> *>(static_cast<unsigned char *>(memory) + sizeof(header));
+		}
+
+		template<typename T>
+		const slot<T> * get_slots(const void * memory) noexcept {
+			return reinterpret_cast<const slot<T> *>(static_cast<const unsigned char *>(memory) + sizeof(header));
+		}
+
+		constexpr void hash_bytes(std::uint64_t & hash, std::string_view bytes) noexcept {
+			for (const char c : bytes) {
+				hash ^= std::uint8_t(c);
+				hash *= 1099511628211ull;
+			}
+		}
+
+		constexpr void hash_value(std::uint64_t & hash, std::uint64_t value) noexcept {
+			for (int i = 0; i < 8; ++i) {
+				hash ^= (value >> (i * 8)) & 0xff;
+				hash *= 1099511628211ull;
+			}
+		}
+
+		template<typename Member>
+		constexpr std::uint64_t get_type_kind() noexcept {
+			if constexpr (std::is_floating_point_v<Member>)
+				return 1;
+			else if constexpr (std::is_signed_v<Member>)
+				return 2;
+			else if constexpr (std::is_unsigned_v<Member>)
+				return 3;
+			else
+				return 0;
+		}
+	}
+
+	template<typename T>
+	consteval std::uint64_t get_schema_hash() noexcept {
+		std::uint64_t hash = 14695981039346656037ull;
+		if constexpr (has_class_name<T>())
+			detail::shm_ring::hash_bytes(hash, get_class_name<T>());
+		detail::shm_ring::hash_value(hash, sizeof(T));
+		detail::shm_ring::hash_value(hash, alignof(T));
+
+		for_each_attribute<T>([&](const auto & attr) {
+			using member = std::remove_cv_t<putils::member_type<putils_typeof(attr.ptr)>>;
+			detail::shm_ring::hash_bytes(hash, attr.name);
+			detail::shm_ring::hash_value(hash, sizeof(member));
+			detail::shm_ring::hash_value(hash, detail::shm_ring::get_type_kind<member>());
+		});
+		return hash;
+	}
+
+	template<typename T>
+	constexpr std::size_t get_shm_ring_size(std::size_t capacity) noexcept {
+		return sizeof(detail::shm_ring::header) + std::bit_ceil(capacity) * sizeof(detail::shm_ring::slot<T>);
+	}
+
+	template<typename T>
+	std::optional<shm_publisher<T>> shm_publisher<T>::create(const char * name, std::size_t capacity) noexcept {
+#ifdef _WIN32
+		return std::nullopt;
+#else
+		const auto size = get_shm_ring_size<T>(capacity);
+
+		const int fd = shm_open(name, O_CREAT | O_TRUNC | O_RDWR, 0600);
+		if (fd < 0)
+			return std::nullopt;
+
+		if (ftruncate(fd, off_t(size)) != 0) {
+			close(fd);
+			shm_unlink(name);
+			return std::nullopt;
+		}
+
+		void * const memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (memory == MAP_FAILED) {
+			shm_unlink(name);
+			return std::nullopt;
+		}
+
+		std::optional<shm_publisher> ret = shm_publisher(memory, capacity);
+		ret->_mapped_size = size;
+		ret->_name = name;
+		return ret;
+#endif
+	}
+
+	template<typename T>
+	shm_publisher<T>::shm_publisher(void * memory, std::size_t capacity) noexcept
+		: _memory(memory) {
+		static_assert(std::is_trivially_copyable_v<T>, "shm_ring records must be trivially copyable");
+
+		auto & header = *new (memory) detail::shm_ring::header;
+		header.schema_hash = get_schema_hash<T>();
+		header.record_size = sizeof(T);
+		header.capacity = std::bit_ceil(capacity);
+
+		std::memset(header.class_name, 0, sizeof(header.class_name));
+		if constexpr (has_class_name<T>())
+			std::strncpy(header.class_name, get_class_name<T>(), sizeof(header.class_name) - 1);
+
+		header.write_index.store(0, std::memory_order_relaxed);
+
+		const auto slots = detail::shm_ring::get_slots<T>(memory);
+		for (std::size_t i = 0; i < header.capacity; ++i)
+			new (&slots[i].sequence) std::atomic<std::uint64_t>(0);
+
+		header.magic.store(detail::shm_ring::magic, std::memory_order_release);
+	}
+
+	template<typename T>
+	shm_publisher<T>::~shm_publisher() noexcept {
+		release();
+	}
+
+	template<typename T>
+	shm_publisher<T>::shm_publisher(shm_publisher && other) noexcept
+		: _memory(std::exchange(other._memory, nullptr)),
+		  _mapped_size(std::exchange(other._mapped_size, 0)),
+		  _name(std::move(other._name)) {}
+
+	template<typename T>
+	shm_publisher<T> & shm_publisher<T>::operator=(shm_publisher && other) noexcept {
+		if (this != &other) {
+			release();
+			_memory = std::exchange(other._memory, nullptr);
+			_mapped_size = std::exchange(other._mapped_size, 0);
+			_name = std::move(other._name);
+		}
+		return *this;
+	}
+
+	template<typename T>
+	void shm_publisher<T>::release() noexcept {
+#ifndef _WIN32
+		if (_mapped_size) {
+			munmap(_memory, _mapped_size);
+			shm_unlink(_name.c_str());
+		}
+#endif
+		_memory = nullptr;
+		_mapped_size = 0;
+	}
+
+	template<typename T>
+	void shm_publisher<T>::publish(const T & obj) noexcept {
+		publish_in_place([&](T & record) noexcept {
+			std::memcpy(&record, &obj, sizeof(T));
+		});
+	}
+
+	template<typename T>
+	template<typename Func>
+	void shm_publisher<T>::publish_in_place(Func && func) noexcept {
+		auto & header = detail::shm_ring::get_header(_memory);
+		const auto index = header.write_index.load(std::memory_order_relaxed);
+		auto & slot = detail::shm_ring::get_slots<T>(_memory)[index & (header.capacity - 1)];
+
+		slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		func(*std::launder(reinterpret_cast<T *>(slot.record)));
+
+		slot.sequence.store(2 * index + 2, std::memory_order_release);
+		header.write_index.store(index + 1, std::memory_order_release);
+	}
+
+	template<typename T>
+	std::optional<shm_subscriber<T>> shm_subscriber<T>::open(const char * name) noexcept {
+#ifdef _WIN32
+		return std::nullopt;
+#else
+		const int fd = shm_open(name, O_RDONLY, 0);
+		if (fd < 0)
+			return std::nullopt;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || std::size_t(info.st_size) < sizeof(detail::shm_ring::header)) {
+			close(fd);
+			return std::nullopt;
+		}
+
+		const auto size = std::size_t(info.st_size);
+		void * const memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (memory == MAP_FAILED)
+			return std::nullopt;
+
+		auto ret = attach(memory);
+		if (!ret || size < get_shm_ring_size<T>(detail::shm_ring::get_header(memory).capacity)) {
+			munmap(memory, size);
+			return std::nullopt;
+		}
+
+		ret->_mapped_size = size;
+		return ret;
+#endif
+	}
+
+	template<typename T>
+	std::optional<shm_subscriber<T>> shm_subscriber<T>::attach(const void * memory) noexcept {
+		static_assert(std::is_trivially_copyable_v<T>, "shm_ring records must be trivially copyable");
+
+		// Validate the schema once, records can then be read as-is
+		const auto & header = detail::shm_ring::get_header(memory);
+		if (header.magic.load(std::memory_order_acquire) != detail::shm_ring::magic)
+			return std::nullopt;
+		if (header.schema_hash != get_schema_hash<T>() || header.record_size != sizeof(T))
+			return std::nullopt;
+		if (!std::has_single_bit(header.capacity))
+			return std::nullopt;
+
+		shm_subscriber ret;
+		ret._memory = memory;
+		ret._read_index = header.write_index.load(std::memory_order_acquire);
+		return ret;
+	}
+
+	template<typename T>
+	shm_subscriber<T>::~shm_subscriber() noexcept {
+		release();
+	}
+
+	template<typename T>
+	shm_subscriber<T>::shm_subscriber(shm_subscriber && other) noexcept
+		: _memory(std::exchange(other._memory, nullptr)),
+		  _mapped_size(std::exchange(other._mapped_size, 0)),
+		  _read_index(other._read_index),
+		  _dropped_count(other._dropped_count) {}
+
+	template<typename T>
+	shm_subscriber<T> & shm_subscriber<T>::operator=(shm_subscriber && other) noexcept {
+		if (this != &other) {
+			release();
+			_memory = std::exchange(other._memory, nullptr);
+			_mapped_size = std::exchange(other._mapped_size, 0);
+			_read_index = other._read_index;
+			_dropped_count = other._dropped_count;
+		}
+		return *this;
+	}
+
+	template<typename T>
+	void shm_subscriber<T>::release() noexcept {
+#ifndef _WIN32
+		if (_mapped_size)
+			munmap(const_cast<void *>(_memory), _mapped_size);
+#endif
+		_memory = nullptr;
+		_mapped_size = 0;
+	}
+
+	template<typename T>
+	bool shm_subscriber<T>::try_read(T & out) noexcept {
+		const auto copy = [&](const T & record) noexcept {
+			std::memcpy(&out, &record, sizeof(T));
+		};
+
+		while (true) {
+			switch (read_next(copy)) {
+				case read_result::read:
+					return true;
+				case read_result::empty:
+					return false;
+				case read_result::overwritten:
+					break;
+			}
+		}
+	}
+
+	template<typename T>
+	template<typename Func>
+	bool shm_subscriber<T>::try_read_in_place(Func && func) noexcept {
+		return read_next(func) == read_result::read;
+	}
+
+	template<typename T>
+	std::uint64_t shm_subscriber<T>::get_dropped_count() const noexcept {
+		return _dropped_count;
+	}
+
+	template<typename T>
+	template<typename Func>
+	typename shm_subscriber<T>::read_result shm_subscriber<T>::read_next(Func && func) noexcept {
+		const auto & header = detail::shm_ring::get_header(_memory);
+		const auto slots = detail::shm_ring::get_slots<T>(_memory);
+
+		while (true) {
+			const auto write_index = header.write_index.load(std::memory_order_acquire);
+			if (_read_index == write_index)
+				return read_result::empty;
+
+			// Skip records that have already been overwritten
+			if (write_index - _read_index > header.capacity) {
+				const auto oldest = write_index - header.capacity;
+				_dropped_count += oldest - _read_index;
+				_read_index = oldest;
+			}
+
+			const auto & slot = slots[_read_index & (header.capacity - 1)];
+			const auto expected_sequence = 2 * _read_index + 2;
+			if (slot.sequence.load(std::memory_order_acquire) != expected_sequence) {
+				// Overwritten since we loaded `write_index`
+				++_dropped_count;
+				++_read_index;
+				continue;
+			}
+
+			func(*std::launder(reinterpret_cast<const T *>(slot.record)));
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const bool overwritten = slot.sequence.load(std::memory_order_relaxed) != expected_sequence;
+			++_read_index;
+			if (overwritten) {
+				++_dropped_count;
+				return read_result::overwritten;
+			}
+			return read_result::read;
+		}
+	}
+}
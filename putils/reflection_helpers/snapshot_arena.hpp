@@ -0,0 +1,75 @@
+#pragma once
+
+// stl
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	// Bump allocator storing snapshots of reflectible objects, freed in bulk by rewinding to a marker
+	// A snapshot holds, packed back-to-back:
+	//	- the trivially copyable attributes of standard-layout types, copied with memcpy runs (see convert)
+	//	- the other non-const attributes, deep-copied: containers (vectors, strings, maps, sets...) are stored as their size followed by their
+	//	  elements, optionals as a flag followed by their value, and reflectible attributes are recursed into
+	// Trivially copyable types are copied as a single block
+	// Restoring a snapshot copies it back into the object, reusing its existing container buffers when they're large enough
+	// Rolling back also rewinds the arena, freeing the snapshots saved after the ones restored (e.g. the frames being re-simulated)
+	class snapshot_arena {
+	public:
+		struct marker {
+			std::size_t block;
+			std::size_t offset;
+			std::size_t used_size;
+		};
+
+		template<typename T>
+		struct snapshot {
+			const char * data;
+			marker end; // position of the arena after this snapshot
+		};
+
+		// Memory is allocated in blocks of `block_size` bytes, or larger for snapshots that don't fit in a block
+		explicit snapshot_arena(std::size_t block_size = 1024 * 1024) noexcept;
+
+		template<typename T>
+		snapshot<T> save(const T & obj) noexcept;
+
+		template<typename T>
+		static void restore(snapshot<T> snap, T & obj) noexcept;
+
+		// Restore objects from their snapshots, then rewind to the end of the last snapshot
+		// Snapshots must be given in the order they were saved in
+		template<typename T>
+		void rollback(snapshot<T> snap, T & obj) noexcept;
+		template<typename T>
+		void rollback(std::span<const snapshot<T>> snapshots, std::span<T> objects) noexcept;
+
+		// Free all snapshots saved after `m` was taken. Memory is kept for future snapshots
+		marker get_marker() const noexcept;
+		void rewind(marker m) noexcept;
+		void clear() noexcept;
+
+		// Number of bytes used by snapshots, not counting space lost at the end of blocks
+		std::size_t get_used_size() const noexcept;
+
+	private:
+		char * allocate(std::size_t size) noexcept;
+
+		struct block {
+			std::unique_ptr<char[]> data;
+			std::size_t size;
+		};
+
+		std::size_t _block_size;
+		std::vector<block> _blocks;
+		std::size_t _current_block = 0;
+		std::size_t _offset = 0;
+		std::size_t _used_size = 0;
+	};
+}
+
+#include "snapshot_arena.inl"
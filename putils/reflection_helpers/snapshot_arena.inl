@@ -0,0 +1,361 @@
+#include "snapshot_arena.hpp"
+
+// stl
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// reflection
+#include "convert.hpp"
+
+namespace putils::reflection {
+	namespace detail::snapshot {
+		template<typename T>
+		concept object = has_attributes<T>();
+
+		template<typename T>
+		concept raw = !object<T> && std::is_trivially_copyable_v<T> && std::is_trivially_copy_assignable_v<T>;
+
+		template<typename T>
+		concept resizable = !object<T> && !raw<T> && requires(T & obj) {
+			obj.begin();
+			obj.end();
+			obj.size();
+			obj.resize(std::size_t());
+		};
+
+		template<typename T>
+		concept contiguous_block = resizable<T> && std::is_trivially_copyable_v<typename T::value_type> && requires(T & obj) {
+			{ obj.data() } -> std::same_as<typename T::value_type *>;
+		};
+
+		// Containers that can't be resized, e.g. std::map or std::set
+		template<typename T>
+		concept insertable = !object<T> && !raw<T> && !resizable<T> && requires(T & obj) {
+			obj.begin();
+			obj.end();
+			obj.size();
+			obj.clear();
+			obj.insert(obj.end(), *obj.begin());
+		};
+
+		template<typename T>
+		concept optional = !object<T> && !raw<T> && requires(T & obj) {
+			{ obj.has_value() } -> std::convertible_to<bool>;
+			*obj;
+			obj.emplace();
+			obj.reset();
+		};
+
+		// Includes the elements of maps
+		template<typename T>
+		concept pair = !object<T> && !raw<T> && requires(T & obj) {
+			typename T::first_type;
+			typename T::second_type;
+			obj.first;
+			obj.second;
+		};
+
+		// Elements of insertable containers are read into a T before being inserted, as the keys of maps are const
+		template<typename T>
+		struct readable_element {
+			using type = T;
+		};
+
+		template<typename First, typename Second>
+		struct readable_element<std::pair<First, Second>> {
+			using type = std::pair<std::remove_const_t<First>, Second>;
+		};
+
+		// Attributes that are saved by memcpy runs
+		template<typename T, std::size_t I>
+		constexpr bool is_copied = detail::convert::field_kinds<T, T>[I] == detail::convert::field_kind::copy;
+
+		// Attributes that are deep-copied
+		template<typename T, std::size_t I>
+		constexpr bool is_deep_copied = detail::convert::field_kinds<T, T>[I] != detail::convert::field_kind::none && !is_copied<T, I>;
+
+		// Elements of containers with proxy references (e.g. std::vector<bool>) are converted to their value_type
+		template<typename T, typename Element>
+		decltype(auto) get_element(const Element & element) noexcept {
+			if constexpr (std::is_same_v<Element, typename T::value_type>)
+				return (element);
+			else
+				return typename T::value_type(element);
+		}
+
+		template<typename T>
+		std::size_t get_deep_size(const T & obj) noexcept;
+
+		template<typename T>
+		void write_deep(const T & obj, char *& out) noexcept;
+
+		template<typename T>
+		void read_deep(T & obj, const char *& in) noexcept;
+
+		template<typename T>
+		constexpr std::size_t copied_size = [] {
+			std::size_t ret = 0;
+			constexpr auto & plan = detail::convert::copy_plan_for<T, T>;
+			for (std::size_t i = 0; i < plan.run_count; ++i)
+				ret += plan.runs[i].size;
+			return ret;
+		}();
+
+		template<typename T, typename Func>
+		void for_each_deep_copied(Func && func) noexcept {
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) noexcept {
+				([&] {
+					if constexpr (is_deep_copied<T, Is>)
+						func(std::get<Is>(get_attributes<T>()).ptr);
+				}(),
+				 ...);
+			}(std::make_index_sequence<detail::convert::attribute_count<T>>());
+		}
+
+		// Size taken by an object: its memcpy runs, followed by its deep-copied attributes
+		template<typename T>
+		std::size_t get_object_size(const T & obj) noexcept {
+			std::size_t ret = copied_size<T>;
+			for_each_deep_copied<T>([&](auto ptr) noexcept {
+				ret += get_deep_size(obj.*ptr);
+			});
+			return ret;
+		}
+
+		template<typename T>
+		void write_object(const T & obj, char *& out) noexcept {
+			if constexpr (detail::convert::copy_count<T, T> > 0) {
+				constexpr auto & plan = detail::convert::copy_plan_for<T, T>;
+				for (std::size_t i = 0; i < plan.run_count; ++i) {
+					const auto & run = plan.runs[i];
+					std::memcpy(out, (const char *)&obj + run.src_offset, run.size);
+					out += run.size;
+				}
+			}
+			for_each_deep_copied<T>([&](auto ptr) noexcept {
+				write_deep(obj.*ptr, out);
+			});
+		}
+
+		template<typename T>
+		void read_object(T & obj, const char *& in) noexcept {
+			if constexpr (detail::convert::copy_count<T, T> > 0) {
+				constexpr auto & plan = detail::convert::copy_plan_for<T, T>;
+				for (std::size_t i = 0; i < plan.run_count; ++i) {
+					const auto & run = plan.runs[i];
+					std::memcpy((char *)&obj + run.dst_offset, in, run.size);
+					in += run.size;
+				}
+			}
+			for_each_deep_copied<T>([&](auto ptr) noexcept {
+				read_deep(obj.*ptr, in);
+			});
+		}
+
+		template<typename T>
+		std::size_t get_deep_size(const T & obj) noexcept {
+			if constexpr (raw<T>)
+				return sizeof(T);
+			else if constexpr (object<T>)
+				return get_object_size(obj);
+			else if constexpr (contiguous_block<T>)
+				return sizeof(std::size_t) + obj.size() * sizeof(typename T::value_type);
+			else if constexpr (resizable<T> || insertable<T>) {
+				std::size_t ret = sizeof(std::size_t);
+				for (const auto & element : obj)
+					ret += get_deep_size(get_element<T>(element));
+				return ret;
+			}
+			else if constexpr (optional<T>)
+				return sizeof(bool) + (obj.has_value() ? get_deep_size(*obj) : 0);
+			else if constexpr (pair<T>)
+				return get_deep_size(obj.first) + get_deep_size(obj.second);
+			else
+				static_assert(std::is_void_v<T>, "Type cannot be saved in a snapshot_arena");
+		}
+
+		template<typename T>
+		void write_deep(const T & obj, char *& out) noexcept {
+			if constexpr (raw<T>) {
+				std::memcpy(out, &obj, sizeof(T));
+				out += sizeof(T);
+			}
+			else if constexpr (object<T>)
+				write_object(obj, out);
+			else if constexpr (optional<T>) {
+				const bool has_value = obj.has_value();
+				std::memcpy(out, &has_value, sizeof(has_value));
+				out += sizeof(has_value);
+				if (has_value)
+					write_deep(*obj, out);
+			}
+			else if constexpr (pair<T>) {
+				write_deep(obj.first, out);
+				write_deep(obj.second, out);
+			}
+			else {
+				const std::size_t size = obj.size();
+				std::memcpy(out, &size, sizeof(size));
+				out += sizeof(size);
+
+				if constexpr (contiguous_block<T>) {
+					const auto bytes = size * sizeof(typename T::value_type);
+					std::memcpy(out, obj.data(), bytes);
+					out += bytes;
+				}
+				else {
+					for (const auto & element : obj)
+						write_deep(get_element<T>(element), out);
+				}
+			}
+		}
+
+		template<typename T>
+		void read_deep(T & obj, const char *& in) noexcept {
+			if constexpr (raw<T>) {
+				std::memcpy(&obj, in, sizeof(T));
+				in += sizeof(T);
+			}
+			else if constexpr (object<T>)
+				read_object(obj, in);
+			else if constexpr (optional<T>) {
+				bool has_value;
+				std::memcpy(&has_value, in, sizeof(has_value));
+				in += sizeof(has_value);
+				if (!has_value)
+					obj.reset();
+				else {
+					if (!obj.has_value())
+						obj.emplace();
+					read_deep(*obj, in);
+				}
+			}
+			else if constexpr (pair<T>) {
+				read_deep(obj.first, in);
+				read_deep(obj.second, in);
+			}
+			else if constexpr (insertable<T>) {
+				std::size_t size;
+				std::memcpy(&size, in, sizeof(size));
+				in += sizeof(size);
+
+				// Elements were saved in iteration order, so inserting at the end is cheap for ordered containers
+				obj.clear();
+				for (std::size_t i = 0; i < size; ++i) {
+					typename readable_element<typename T::value_type>::type element;
+					read_deep(element, in);
+					obj.insert(obj.end(), std::move(element));
+				}
+			}
+			else {
+				std::size_t size;
+				std::memcpy(&size, in, sizeof(size));
+				in += sizeof(size);
+				obj.resize(size);
+
+				if constexpr (contiguous_block<T>) {
+					const auto bytes = size * sizeof(typename T::value_type);
+					std::memcpy(obj.data(), in, bytes);
+					in += bytes;
+				}
+				else {
+					for (auto && element : obj) {
+						if constexpr (std::is_reference_v<decltype(*obj.begin())>)
+							read_deep(element, in);
+						else { // Proxy references, e.g. std::vector<bool>
+							typename T::value_type value;
+							read_deep(value, in);
+							element = value;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	inline snapshot_arena::snapshot_arena(std::size_t block_size) noexcept
+		: _block_size(block_size) {}
+
+	template<typename T>
+	snapshot_arena::snapshot<T> snapshot_arena::save(const T & obj) noexcept {
+		if constexpr (detail::snapshot::raw<T>) {
+			const auto data = allocate(sizeof(T));
+			std::memcpy(data, &obj, sizeof(T));
+			return { .data = data, .end = get_marker() };
+		}
+		else {
+			const auto data = allocate(detail::snapshot::get_object_size(obj));
+			auto out = data;
+			detail::snapshot::write_object(obj, out);
+			return { .data = data, .end = get_marker() };
+		}
+	}
+
+	template<typename T>
+	void snapshot_arena::restore(snapshot<T> snap, T & obj) noexcept {
+		if constexpr (detail::snapshot::raw<T>)
+			std::memcpy(&obj, snap.data, sizeof(T));
+		else {
+			auto in = snap.data;
+			detail::snapshot::read_object(obj, in);
+		}
+	}
+
+	template<typename T>
+	void snapshot_arena::rollback(snapshot<T> snap, T & obj) noexcept {
+		rollback(std::span<const snapshot<T>>(&snap, 1), std::span<T>(&obj, 1));
+	}
+
+	template<typename T>
+	void snapshot_arena::rollback(std::span<const snapshot<T>> snapshots, std::span<T> objects) noexcept {
+		const auto count = std::min(snapshots.size(), objects.size());
+		if (count == 0)
+			return;
+
+		for (std::size_t i = 0; i < count; ++i)
+			restore(snapshots[i], objects[i]);
+		rewind(snapshots[count - 1].end);
+	}
+
+	inline snapshot_arena::marker snapshot_arena::get_marker() const noexcept {
+		return { .block = _current_block, .offset = _offset, .used_size = _used_size };
+	}
+
+	inline void snapshot_arena::rewind(marker m) noexcept {
+		_current_block = m.block;
+		_offset = m.offset;
+		_used_size = m.used_size;
+	}
+
+	inline void snapshot_arena::clear() noexcept {
+		rewind({ .block = 0, .offset = 0, .used_size = 0 });
+	}
+
+	inline std::size_t snapshot_arena::get_used_size() const noexcept {
+		return _used_size;
+	}
+
+	inline char * snapshot_arena::allocate(std::size_t size) noexcept {
+		// Snapshots are only accessed through memcpy, so they don't need to be aligned
+		if (_current_block >= _blocks.size() || _blocks[_current_block].size - _offset < size) {
+			if (_current_block < _blocks.size() && _offset > 0)
+				++_current_block;
+			_offset = 0;
+
+			// Reuse the next block if it's large enough, or insert a new one before it so that it can be reused later
+			if (_current_block >= _blocks.size() || _blocks[_current_block].size < size) {
+				const auto block_size = std::max(_block_size, size);
+				_blocks.insert(_blocks.begin() + std::ptrdiff_t(_current_block), block{ std::make_unique<char[]>(block_size), block_size });
+			}
+		}
+
+		const auto ret = _blocks[_current_block].data.get() + _offset;
+		_offset += size;
+		_used_size += size;
+		return ret;
+	}
+}
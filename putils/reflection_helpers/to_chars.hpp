@@ -0,0 +1,49 @@
+#pragma once
+
+// stl
+#include <charconv>
+#include <string>
+#include <version>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace putils::reflection {
+	namespace detail::to_chars {
+		template<typename T>
+		constexpr bool is_writable() noexcept;
+	}
+
+	// Types to_chars can write: arithmetic types, enums, strings, reflectible objects and ranges of these
+	template<typename T>
+	concept writable = detail::to_chars::is_writable<T>();
+
+	// Write `obj` as `class_name{attribute: value, ...}` into [first, last), without allocating
+	// The static text (class name, attribute names and separators) is built at compile-time, only values are formatted at runtime
+	// Arithmetic values are written with std::to_chars, ranges are written as `[a, b]` and reflectible attributes are recursed into
+	// Strings and chars are quoted, with quotes, backslashes and control characters escaped as in C++ literals (`\"`, `\\`, `\n`, `\001`...)
+	// Enums are written by name if they're reflectible, or as their underlying value otherwise
+	// Returns `{ last, std::errc::value_too_large }` if the buffer is too small
+	template<writable T>
+	std::to_chars_result to_chars(char * first, char * last, const T & obj) noexcept;
+
+	// Get the number of characters to_chars will write for `obj`
+	template<writable T>
+	std::size_t formatted_size(const T & obj) noexcept;
+
+	// Allocating convenience wrapper around to_chars, for reflectible objects
+	template<typename T>
+		requires (has_attributes<T>() && writable<T>)
+	std::string to_string(const T & obj) noexcept;
+
+	// Wrapper to format a reflectible object through std::format, e.g. `std::format("{}", putils::reflection::formatted(obj))`
+	template<typename T>
+	struct formatted {
+		const T & obj;
+	};
+
+	template<typename T>
+	formatted(const T &) -> formatted<T>;
+}
+
+#include "to_chars.inl"
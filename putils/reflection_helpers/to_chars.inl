@@ -0,0 +1,271 @@
+#include "to_chars.hpp"
+
+// stl
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#ifdef __cpp_lib_format
+#include <format>
+#endif
+
+namespace putils::reflection {
+	namespace detail::to_chars {
+		// Static text for a type, split in one segment before each attribute and a final one
+		template<std::size_t Size, std::size_t SegmentCount>
+		struct static_text {
+			std::array<char, Size> chars{};
+			std::array<std::size_t, SegmentCount + 1> offsets{};
+
+			constexpr std::string_view segment(std::size_t index) const noexcept {
+				return { chars.data() + offsets[index], offsets[index + 1] - offsets[index] };
+			}
+		};
+
+		template<typename T>
+		constexpr std::string_view get_class_name_view() noexcept {
+			if constexpr (has_class_name<T>())
+				return get_class_name<T>();
+			else
+				return {};
+		}
+
+		template<typename T>
+		consteval auto make_static_text() noexcept {
+			constexpr auto attribute_count = std::tuple_size_v<putils_typeof(get_attributes<T>())>;
+			constexpr auto size = [] {
+				std::size_t ret = get_class_name_view<T>().size() + 2; // "{}"
+				for_each_attribute<T>([&](const auto & attr) {
+					ret += std::string_view(attr.name).size() + 2; // ": "
+				});
+				if (attribute_count > 1)
+					ret += 2 * (attribute_count - 1); // ", "
+				return ret;
+			}();
+
+			static_text<size, attribute_count + 1> ret;
+			std::size_t pos = 0;
+			const auto append = [&](std::string_view str) {
+				for (const char c : str)
+					ret.chars[pos++] = c;
+			};
+
+			append(get_class_name_view<T>());
+			append("{");
+
+			std::size_t index = 0;
+			for_each_attribute<T>([&](const auto & attr) {
+				if (index > 0) {
+					ret.offsets[index] = pos;
+					append(", ");
+				}
+				append(attr.name);
+				append(": ");
+				++index;
+			});
+
+			if (attribute_count > 0)
+				ret.offsets[attribute_count] = pos;
+			append("}");
+			ret.offsets[attribute_count + 1] = pos;
+			return ret;
+		}
+
+		template<typename T>
+		constexpr auto static_text_v = make_static_text<T>();
+
+		// Copies into [first, last) as long as there is room, and keeps track of the total size requested
+		class writer {
+		public:
+			writer(char * first, char * last) noexcept
+				: _current(first), _last(last) {}
+
+			void write(std::string_view str) noexcept {
+				_size += str.size();
+				if (_overflow || str.size() > std::size_t(_last - _current)) {
+					_overflow = true;
+					return;
+				}
+				std::memcpy(_current, str.data(), str.size());
+				_current += str.size();
+			}
+
+			std::to_chars_result result() const noexcept {
+				if (_overflow)
+					return { _last, std::errc::value_too_large };
+				return { _current, std::errc() };
+			}
+
+			std::size_t size() const noexcept { return _size; }
+
+			// Write `str` between `quote`s, escaping them along with backslashes and control characters
+			void write_quoted(std::string_view str, char quote) noexcept {
+				write(std::string_view(&quote, 1));
+
+				std::size_t begin = 0;
+				for (std::size_t i = 0; i < str.size(); ++i) {
+					const auto c = static_cast<unsigned char>(str[i]);
+					if (c != static_cast<unsigned char>(quote) && c != '\\' && c >= 0x20 && c != 0x7f)
+						continue;
+
+					write(str.substr(begin, i - begin));
+					begin = i + 1;
+					switch (c) {
+						case '\n':
+							write("\\n");
+							break;
+						case '\r':
+							write("\\r");
+							break;
+						case '\t':
+							write("\\t");
+							break;
+						case '\\':
+						case '"':
+						case '\'':
+							write("\\");
+							write(std::string_view(&str[i], 1));
+							break;
+						default: {
+							// Always 3 octal digits, so that following digits aren't read as part of the escape
+							const char escaped[] = { '\\', char('0' + (c >> 6)), char('0' + ((c >> 3) & 7)), char('0' + (c & 7)) };
+							write(std::string_view(escaped, sizeof(escaped)));
+							break;
+						}
+					}
+				}
+				write(str.substr(begin));
+
+				write(std::string_view(&quote, 1));
+			}
+
+		private:
+			char * _current;
+			char * _last;
+			std::size_t _size = 0;
+			bool _overflow = false;
+		};
+
+		template<typename T>
+		void write_object(writer & out, const T & obj) noexcept;
+
+		template<typename T>
+		constexpr bool is_writable() noexcept {
+			if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_convertible_v<const T &, std::string_view>)
+				return true;
+			else if constexpr (has_attributes<T>()) {
+				bool ret = true;
+				for_each_attribute<T>([&](const auto & attr) noexcept {
+					ret = ret && is_writable<std::remove_cvref_t<decltype(std::declval<const T &>().*attr.ptr)>>();
+				});
+				return ret;
+			}
+			else if constexpr (requires(const T & obj) { std::begin(obj); std::end(obj); })
+				return is_writable<std::remove_cvref_t<decltype(*std::begin(std::declval<const T &>()))>>();
+			else
+				return false;
+		}
+
+		template<typename V>
+		void write_value(writer & out, const V & value) noexcept {
+			if constexpr (std::is_same_v<V, bool>)
+				out.write(value ? "true" : "false");
+			else if constexpr (std::is_same_v<V, char>)
+				out.write_quoted(std::string_view(&value, 1), '\'');
+			else if constexpr (std::is_arithmetic_v<V>) {
+				char buffer[64];
+				const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+				out.write(std::string_view(buffer, result.ptr));
+			}
+			else if constexpr (std::is_enum_v<V>) {
+				if constexpr (has_values<V>()) {
+					const auto name = enum_to_string(value);
+					if (!name.empty()) {
+						out.write(name);
+						return;
+					}
+				}
+				write_value(out, std::underlying_type_t<V>(value));
+			}
+			else if constexpr (std::is_convertible_v<const V &, std::string_view>) {
+				if constexpr (std::is_pointer_v<V>) {
+					if (value == nullptr) {
+						out.write("null");
+						return;
+					}
+				}
+				out.write_quoted(std::string_view(value), '"');
+			}
+			else if constexpr (has_attributes<V>())
+				write_object(out, value);
+			else if constexpr (requires { std::begin(value); std::end(value); }) {
+				out.write("[");
+				bool first = true;
+				for (const auto & element : value) {
+					if (!first)
+						out.write(", ");
+					first = false;
+					write_value(out, element);
+				}
+				out.write("]");
+			}
+			else
+				static_assert(std::is_void_v<V>, "Type cannot be written by to_chars");
+		}
+
+		template<typename T>
+		void write_object(writer & out, const T & obj) noexcept {
+			constexpr auto & text = static_text_v<T>;
+			constexpr auto & attributes = get_attributes<T>();
+
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+				((out.write(text.segment(Is)), write_value(out, obj.*std::get<Is>(attributes).ptr)), ...);
+				out.write(text.segment(sizeof...(Is)));
+			}(std::make_index_sequence<std::tuple_size_v<putils_typeof(attributes)>>());
+		}
+	}
+
+	template<writable T>
+	std::to_chars_result to_chars(char * first, char * last, const T & obj) noexcept {
+		detail::to_chars::writer out(first, last);
+		detail::to_chars::write_value(out, obj);
+		return out.result();
+	}
+
+	template<writable T>
+	std::size_t formatted_size(const T & obj) noexcept {
+		detail::to_chars::writer out(nullptr, nullptr);
+		detail::to_chars::write_value(out, obj);
+		return out.size();
+	}
+
+	template<typename T>
+		requires (has_attributes<T>() && writable<T>)
+	std::string to_string(const T & obj) noexcept {
+		std::string ret(formatted_size(obj), '\0');
+		to_chars(ret.data(), ret.data() + ret.size(), obj);
+		return ret;
+	}
+}
+
+#ifdef __cpp_lib_format
+template<typename T>
+struct std::formatter<putils::reflection::formatted<T>, char> {
+	constexpr auto parse(std::format_parse_context & ctx) {
+		return ctx.begin();
+	}
+
+	auto format(const putils::reflection::formatted<T> & value, std::format_context & ctx) const {
+		// Format into a stack buffer first, and only allocate for large objects
+		char buffer[512];
+		const auto result = putils::reflection::to_chars(buffer, buffer + sizeof(buffer), value.obj);
+		if (result.ec == std::errc())
+			return std::copy(buffer, result.ptr, ctx.out());
+
+		std::string str(putils::reflection::formatted_size(value.obj), '\0');
+		putils::reflection::to_chars(str.data(), str.data() + str.size(), value.obj);
+		return std::copy(str.begin(), str.end(), ctx.out());
+	}
+};
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace putils::reflection {
+	// Unique identifier for a type, usable at compile-time and without RTTI
+	using type_id = const void *;
+
+	template<typename T>
+	constexpr type_id get_type_id() noexcept;
+}
+
+#include "type_id.inl"
@@ -0,0 +1,16 @@
+#include "type_id.hpp"
+
+namespace putils::reflection {
+	namespace detail {
+		template<typename T>
+		struct type_tag {
+			// Inline variable, so its address is the same in all translation units
+			static constexpr char id = 0;
+		};
+	}
+
+	template<typename T>
+	constexpr type_id get_type_id() noexcept {
+		return &detail::type_tag<T>::id;
+	}
+}
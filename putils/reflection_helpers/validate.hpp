@@ -0,0 +1,52 @@
+#pragma once
+
+// stl
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// reflection
+#include "putils/reflection.hpp"
+
+// Validation of reflectible objects from their attributes' metadata:
+//	- "min" / "max": bounds for the attribute, of the same type as the attribute
+//	- "non_empty" (any value): the attribute, e.g. a string or container, must not be empty
+//	- "max_length": maximum size() for the attribute, as a std::size_t or an int
+// The checks are generated at compile-time from the metadata, and each attribute is checked for the whole batch at once
+
+namespace putils::reflection {
+	enum class validation_rule : std::uint8_t {
+		below_min,
+		above_max,
+		empty,
+		too_long,
+	};
+
+	struct validation_error {
+		std::size_t index; // position of the object in the batch
+		std::string_view attribute;
+		validation_rule rule;
+	};
+
+	// Append an error to `errors` for each failed check, grouped by attribute and rule
+	// Returns true if all objects are valid
+	template<typename T>
+	bool validate(std::span<const T> objects, std::vector<validation_error> & errors) noexcept;
+
+	template<typename T>
+	bool validate(const T & obj, std::vector<validation_error> & errors) noexcept;
+}
+
+#define refltype putils::reflection::validation_rule
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(below_min),
+		putils_reflection_value(above_max),
+		putils_reflection_value(empty),
+		putils_reflection_value(too_long)
+	);
+};
+#undef refltype
+
+#include "validate.inl"
@@ -0,0 +1,78 @@
+#include "validate.hpp"
+
+namespace putils::reflection {
+	namespace detail::validate {
+		template<typename T>
+		constexpr auto attribute_count = std::tuple_size_v<putils_typeof(get_attributes<T>())>;
+
+		// Count failures without branching first, so the common case (no failures) is a simple reduction over the batch,
+		// and only look for the failing objects if there are any
+		template<typename T, typename Failed>
+		bool check(std::span<const T> objects, std::string_view attribute, validation_rule rule, Failed && failed, std::vector<validation_error> & errors) noexcept {
+			std::size_t failure_count = 0;
+			for (const auto & obj : objects)
+				failure_count += failed(obj) ? 1 : 0;
+			if (failure_count == 0)
+				return true;
+
+			errors.reserve(errors.size() + failure_count);
+			for (std::size_t i = 0; i < objects.size(); ++i)
+				if (failed(objects[i]))
+					errors.push_back({ .index = i, .attribute = attribute, .rule = rule });
+			return false;
+		}
+
+		template<typename T, std::size_t I>
+		bool check_attribute(std::span<const T> objects, std::vector<validation_error> & errors) noexcept {
+			constexpr auto & attr = std::get<I>(get_attributes<T>());
+			constexpr auto ptr = attr.ptr;
+			using member = std::remove_const_t<putils::member_type<putils_typeof(ptr)>>;
+
+			bool ok = true;
+
+			if constexpr (attribute_metadata_flags<T, "min">[I]) {
+				constexpr auto min = attribute_metadata_pointers<member, T, "min">[I];
+				static_assert(min != nullptr, "\"min\" metadata should have the same type as the attribute");
+				ok &= check(objects, attr.name, validation_rule::below_min, [](const T & obj) noexcept { return obj.*ptr < *min; }, errors);
+			}
+
+			if constexpr (attribute_metadata_flags<T, "max">[I]) {
+				constexpr auto max = attribute_metadata_pointers<member, T, "max">[I];
+				static_assert(max != nullptr, "\"max\" metadata should have the same type as the attribute");
+				ok &= check(objects, attr.name, validation_rule::above_max, [](const T & obj) noexcept { return *max < obj.*ptr; }, errors);
+			}
+
+			if constexpr (attribute_metadata_flags<T, "non_empty">[I])
+				ok &= check(objects, attr.name, validation_rule::empty, [](const T & obj) noexcept { return (obj.*ptr).empty(); }, errors);
+
+			if constexpr (attribute_metadata_flags<T, "max_length">[I]) {
+				constexpr auto max_length = [] {
+					if constexpr (attribute_metadata_pointers<std::size_t, T, "max_length">[I] != nullptr)
+						return *attribute_metadata_pointers<std::size_t, T, "max_length">[I];
+					else if constexpr (attribute_metadata_pointers<int, T, "max_length">[I] != nullptr)
+						return std::size_t(*attribute_metadata_pointers<int, T, "max_length">[I]);
+					else {
+						static_assert(I != I, "\"max_length\" metadata should be a std::size_t or an int");
+						return std::size_t(0);
+					}
+				}();
+				ok &= check(objects, attr.name, validation_rule::too_long, [](const T & obj) noexcept { return (obj.*ptr).size() > max_length; }, errors);
+			}
+
+			return ok;
+		}
+	}
+
+	template<typename T>
+	bool validate(std::span<const T> objects, std::vector<validation_error> & errors) noexcept {
+		return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			// Not short-circuiting, so that all attributes are checked
+			return (detail::validate::check_attribute<T, Is>(objects, errors) & ... & true);
+		}(std::make_index_sequence<detail::validate::attribute_count<T>>());
+	}
+
+	template<typename T>
+	bool validate(const T & obj, std::vector<validation_error> & errors) noexcept {
+		return validate(std::span<const T>(&obj, 1), errors);
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+// Macros used to declare reflection info. They're split from the rest of the library so that they can be used along with the
+// putils.reflection module, which can't export macros
+
+// stl
+#include <string_view>
+#include <tuple>
+
+// meta
+#include "putils/meta/nameof.hpp"
+
+// Define a type_info for a templated type, like C in the example above
+#define putils_reflection_info_template struct putils::reflection::type_info<refltype>
+
+// Define a type_info for a given type
+#define putils_reflection_info \
+	template<> \
+	putils_reflection_info_template
+
+// Place inside classes that need to have reflectible private fields
+#define putils_reflection_friend(T) friend struct putils::reflection::type_info<T>;
+
+// implementation detail
+#define putils_impl_reflection_static_tuple(NAME, FUNCTION, ...) static constexpr auto NAME = FUNCTION(__VA_ARGS__);
+
+// Lets you define a custom class name
+#define putils_reflection_custom_class_name(custom_class_name) static constexpr auto class_name = putils_nameof(custom_class_name) + (std::string_view(putils_nameof(custom_class_name)).rfind("::") != std::string_view::npos ? std::string_view(putils_nameof(custom_class_name)).rfind("::") + 2 : 0);
+
+// Uses refltype as class name
+#define putils_reflection_class_name putils_reflection_custom_class_name(refltype)
+
+#define putils_reflection_attributes(...) putils_impl_reflection_static_tuple(attributes, std::make_tuple, __VA_ARGS__)
+#define putils_reflection_methods(...) putils_impl_reflection_static_tuple(methods, std::make_tuple, __VA_ARGS__)
+#define putils_reflection_parents(...) putils_impl_reflection_static_tuple(parents, std::make_tuple, __VA_ARGS__)
+#define putils_reflection_used_types(...) putils_impl_reflection_static_tuple(used_types, std::make_tuple, __VA_ARGS__)
+#define putils_reflection_type_metadata(...) putils_impl_reflection_static_tuple(metadata, putils::make_table, __VA_ARGS__)
+
+#define putils_reflection_attribute(member, ...) \
+	putils::reflection::attribute_info { .name = #member, .ptr = &refltype::member, .metadata = putils::make_table(__VA_ARGS__) }
+#define putils_reflection_metadata(key, value) key, value
+#define putils_reflection_attribute_private(member, ...) \
+	putils::reflection::attribute_info { .name = #member + 1, .ptr = &refltype::member, .metadata = putils::make_table(__VA_ARGS__) }
+#define putils_reflection_type(T, ...) \
+	putils::reflection::used_type_info { .type = putils::meta::type<T>(), .metadata = putils::make_table(__VA_ARGS__) }
+
+#define putils_reflection_values(...) putils_impl_reflection_static_tuple(values, std::make_tuple, __VA_ARGS__)
+#define putils_reflection_value(enum_value, ...) \
+	putils::reflection::enum_value_info { .name = #enum_value, .value = refltype::enum_value, .metadata = putils::make_table(__VA_ARGS__) }
@@ -0,0 +1,145 @@
+// stl
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/attribute_ref.hpp"
+
+namespace {
+	struct light {
+		float intensity = 1.f;
+		std::string name = "sun";
+		const int id = 42;
+	};
+
+	struct owner {
+		std::unique_ptr<int> resource;
+	};
+}
+
+#define refltype light
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(intensity),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(id)
+	);
+};
+#undef refltype
+
+#define refltype owner
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(resource)
+	);
+};
+#undef refltype
+
+static_assert(std::is_trivially_copyable_v<putils::reflection::attribute_ref>);
+
+TEST(attribute_ref, get_by_name) {
+	light obj;
+	const auto ref = putils::reflection::get_attribute_ref(obj, "intensity");
+	ASSERT_TRUE(ref);
+	EXPECT_EQ(ref.get_name(), "intensity");
+	EXPECT_EQ(ref.get_type(), putils::reflection::get_type_id<float>());
+	EXPECT_FALSE(ref.is_const());
+	EXPECT_EQ(ref.get<float>(), &obj.intensity);
+	EXPECT_EQ(ref.get<int>(), nullptr);
+}
+
+TEST(attribute_ref, get_unknown) {
+	light obj;
+	const auto ref = putils::reflection::get_attribute_ref(obj, "unknown");
+	EXPECT_FALSE(ref);
+	EXPECT_EQ(ref.get<float>(), nullptr);
+	EXPECT_FALSE(ref.set(1.f));
+	EXPECT_EQ(ref.formatted_size(), 0u);
+}
+
+TEST(attribute_ref, set) {
+	light obj;
+	const auto ref = putils::reflection::get_attribute_ref(obj, "name");
+	EXPECT_TRUE(ref.set(std::string("moon")));
+	EXPECT_EQ(obj.name, "moon");
+	EXPECT_FALSE(ref.set(42));
+}
+
+TEST(attribute_ref, set_converts) {
+	light obj;
+	const auto name = putils::reflection::get_attribute_ref(obj, "name");
+	EXPECT_TRUE(name.set("moon"));
+	EXPECT_EQ(obj.name, "moon");
+	EXPECT_TRUE(name.set(std::string_view("star")));
+	EXPECT_EQ(obj.name, "star");
+
+	const auto intensity = putils::reflection::get_attribute_ref(obj, "intensity");
+	EXPECT_TRUE(intensity.set(2));
+	EXPECT_EQ(obj.intensity, 2.f);
+	EXPECT_TRUE(intensity.set(0.5));
+	EXPECT_EQ(obj.intensity, .5f);
+	EXPECT_FALSE(intensity.set("1"));
+	EXPECT_FALSE(intensity.set(std::vector<float>{}));
+
+	EXPECT_FALSE(putils::reflection::get_attribute_ref(obj, "id").set(1.f));
+}
+
+TEST(attribute_ref, const_attribute) {
+	light obj;
+	const auto ref = putils::reflection::get_attribute_ref(obj, "id");
+	EXPECT_TRUE(ref.is_const());
+	EXPECT_EQ(ref.get<int>(), nullptr);
+	EXPECT_EQ(ref.get<const int>(), &obj.id);
+	EXPECT_FALSE(ref.set(0));
+}
+
+TEST(attribute_ref, const_object) {
+	const light obj;
+	const auto ref = putils::reflection::get_attribute_ref(obj, "intensity");
+	EXPECT_TRUE(ref.is_const());
+	EXPECT_EQ(ref.get<float>(), nullptr);
+	EXPECT_EQ(ref.get<const float>(), &obj.intensity);
+}
+
+TEST(attribute_ref, to_chars) {
+	light obj;
+	const auto ref = putils::reflection::get_attribute_ref(obj, "name");
+
+	char buffer[16];
+	const auto result = ref.to_chars(buffer, buffer + sizeof(buffer));
+	EXPECT_EQ(result.ec, std::errc());
+	EXPECT_EQ(std::string_view(buffer, result.ptr), "\"sun\"");
+	EXPECT_EQ(ref.formatted_size(), 5u);
+}
+
+TEST(attribute_ref, to_chars_not_supported) {
+	owner obj;
+	const auto ref = putils::reflection::get_attribute_ref(obj, "resource");
+
+	char buffer[16];
+	const auto result = ref.to_chars(buffer, buffer + sizeof(buffer));
+	EXPECT_EQ(result.ec, std::errc::not_supported);
+	EXPECT_EQ(result.ptr, buffer);
+	EXPECT_EQ(ref.formatted_size(), 0u);
+}
+
+TEST(attribute_ref, for_each) {
+	light obj;
+	std::vector<putils::reflection::attribute_ref> refs;
+	putils::reflection::for_each_attribute_ref(obj, [&](putils::reflection::attribute_ref ref) {
+		refs.push_back(ref);
+	});
+
+	ASSERT_EQ(refs.size(), 3u);
+	EXPECT_EQ(refs[0].get_name(), "intensity");
+	EXPECT_EQ(refs[1].get_name(), "name");
+	EXPECT_EQ(refs[2].get_name(), "id");
+
+	*refs[0].get<float>() = 2.f;
+	EXPECT_EQ(obj.intensity, 2.f);
+}
@@ -0,0 +1,133 @@
+// stl
+#include <array>
+#include <string_view>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/bake.hpp"
+
+namespace {
+	enum class rarity {
+		common,
+		rare,
+	};
+
+	struct item {
+		std::string_view name;
+		const char * icon = nullptr;
+		rarity quality = rarity::common;
+		int price = 0;
+	};
+
+	struct position {
+		int x = 0;
+		int y = 0;
+	};
+
+	// Attributes reflected under a different name, or private
+	class monster {
+	public:
+		constexpr int get_level() const noexcept { return _level; }
+
+		std::string_view code;
+		float hp = 0;
+		bool boss = false;
+		position spawn;
+		std::array<int, 2> loot{};
+
+	private:
+		int _level = 0;
+		putils_reflection_friend(monster);
+	};
+}
+
+#define refltype rarity
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(common),
+		putils_reflection_value(rare)
+	);
+};
+#undef refltype
+
+#define refltype position
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y)
+	);
+};
+#undef refltype
+
+#define refltype monster
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(code),
+		putils::reflection::attribute_info{ .name = "health", .ptr = &monster::hp, .metadata = putils::make_table() },
+		putils_reflection_attribute(boss),
+		putils_reflection_attribute(spawn),
+		putils_reflection_attribute(loot),
+		putils_reflection_attribute_private(_level)
+	);
+};
+#undef refltype
+
+// bake_value, which bake_attribute uses for string attributes
+namespace {
+	inline constexpr auto items = [] {
+		std::array<item, 2> ret{};
+		putils::reflection::bake_value(ret[0].name, "sword");
+		putils::reflection::bake_value(ret[0].icon, "sword.png");
+		putils::reflection::bake_value(ret[0].quality, "rare");
+		ret[0].price = 100;
+		putils::reflection::bake_value(ret[1].name, "stick");
+		ret[1].price = 1;
+		return ret;
+	}();
+}
+
+TEST(bake, constexpr_table) {
+	static_assert(items[0].name == "sword");
+	static_assert(std::string_view(items[0].icon) == "sword.png");
+	static_assert(items[0].quality == rarity::rare);
+	static_assert(items[0].price == 100);
+	static_assert(items[1].name == "stick");
+	static_assert(items[1].icon == nullptr);
+	static_assert(items[1].quality == rarity::common);
+	SUCCEED();
+}
+
+// Same shape as the tables generated by scripts/bake_tables.py
+namespace {
+	inline constexpr auto monsters = [] {
+		std::array<monster, 1> ret{};
+		putils::reflection::bake_attribute(ret[0], "code", "007", 7);
+		putils::reflection::bake_attribute(ret[0], "health", "1e3", 1000.0);
+		putils::reflection::bake_attribute(ret[0], "boss", "true", true);
+		putils::reflection::bake_attribute(ret[0], "spawn.y", "2", 2);
+		putils::reflection::bake_attribute(ret[0], "loot.1", "42", 42);
+		putils::reflection::bake_attribute(ret[0], "level", "3", 3);
+		return ret;
+	}();
+}
+
+TEST(bake, attribute_paths) {
+	static_assert(monsters[0].code == "007");
+	static_assert(monsters[0].hp == 1000.f);
+	static_assert(monsters[0].boss);
+	static_assert(monsters[0].spawn.y == 2);
+	static_assert(monsters[0].loot[1] == 42);
+	static_assert(monsters[0].get_level() == 3);
+
+	static_assert(putils::reflection::has_attribute_path<monster>("health"));
+	static_assert(putils::reflection::has_attribute_path<monster>("spawn.x"));
+	static_assert(putils::reflection::has_attribute_path<monster>("loot.1"));
+	static_assert(putils::reflection::has_attribute_path<monster>("level"));
+	static_assert(!putils::reflection::has_attribute_path<monster>("hp"));
+	static_assert(!putils::reflection::has_attribute_path<monster>("spawn.z"));
+	static_assert(!putils::reflection::has_attribute_path<monster>("loot.2"));
+	static_assert(!putils::reflection::has_attribute_path<monster>("code.0"));
+	SUCCEED();
+}
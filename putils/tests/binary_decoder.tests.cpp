@@ -0,0 +1,193 @@
+// stl
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/binary_decoder.hpp"
+
+namespace {
+	enum class channel : std::uint8_t {
+		audio,
+		video,
+	};
+
+	struct header {
+		std::uint32_t id = 0;
+		channel type = channel::audio;
+		const int version = 1;
+	};
+
+	struct entry {
+		int id = 0;
+		std::string name;
+	};
+
+	struct packet {
+		header head;
+		double timestamp = 0;
+		std::string label;
+		std::vector<std::uint16_t> samples;
+		std::vector<header> children;
+		std::vector<bool> flags;
+		std::array<float, 3> position{};
+
+		bool operator==(const packet & rhs) const noexcept {
+			const auto same_header = [](const header & lhs, const header & rhs) noexcept {
+				return lhs.id == rhs.id && lhs.type == rhs.type;
+			};
+			return same_header(head, rhs.head) && timestamp == rhs.timestamp && label == rhs.label && samples == rhs.samples &&
+				   std::equal(children.begin(), children.end(), rhs.children.begin(), rhs.children.end(), same_header) &&
+				   flags == rhs.flags && position == rhs.position;
+		}
+	};
+}
+
+#define refltype header
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(type),
+		putils_reflection_attribute(version)
+	);
+};
+#undef refltype
+
+#define refltype entry
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(name)
+	);
+};
+#undef refltype
+
+#define refltype packet
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(head),
+		putils_reflection_attribute(timestamp),
+		putils_reflection_attribute(label),
+		putils_reflection_attribute(samples),
+		putils_reflection_attribute(children),
+		putils_reflection_attribute(flags),
+		putils_reflection_attribute(position)
+	);
+};
+#undef refltype
+
+namespace {
+	packet make_packet() noexcept {
+		packet ret;
+		ret.head.id = 42;
+		ret.head.type = channel::video;
+		ret.timestamp = 12.5;
+		ret.label = "a label long enough to span several chunks";
+		for (std::uint16_t i = 0; i < 100; ++i)
+			ret.samples.push_back(std::uint16_t(i * 3));
+		ret.children.resize(3);
+		ret.children[1].id = 7;
+		ret.flags = { true, false, true };
+		ret.position = { 1.f, 2.f, 3.f };
+		return ret;
+	}
+}
+
+TEST(binary_decoder, single_chunk) {
+	const auto expected = make_packet();
+	std::vector<char> buffer;
+	putils::reflection::to_binary(expected, buffer);
+
+	packet obj;
+	putils::reflection::binary_decoder decoder(obj);
+	EXPECT_FALSE(decoder.is_done());
+	EXPECT_EQ(decoder.feed(buffer), buffer.size());
+	EXPECT_TRUE(decoder.is_done());
+	EXPECT_EQ(obj, expected);
+}
+
+TEST(binary_decoder, all_chunk_sizes) {
+	const auto expected = make_packet();
+	std::vector<char> buffer;
+	putils::reflection::to_binary(expected, buffer);
+
+	for (std::size_t chunk_size = 1; chunk_size < 20; ++chunk_size) {
+		packet obj;
+		putils::reflection::binary_decoder decoder(obj);
+
+		std::size_t offset = 0;
+		while (offset < buffer.size()) {
+			EXPECT_FALSE(decoder.is_done());
+			// Copy the chunk, to check the decoder doesn't keep pointers into previous chunks
+			const std::vector<char> chunk(buffer.begin() + std::ptrdiff_t(offset), buffer.begin() + std::ptrdiff_t(std::min(offset + chunk_size, buffer.size())));
+			EXPECT_EQ(decoder.feed(chunk), chunk.size());
+			offset += chunk.size();
+		}
+
+		EXPECT_TRUE(decoder.is_done());
+		EXPECT_EQ(obj, expected);
+	}
+}
+
+TEST(binary_decoder, trailing_bytes) {
+	std::vector<char> buffer;
+	putils::reflection::to_binary(std::uint32_t(42), buffer);
+	putils::reflection::to_binary(std::uint32_t(43), buffer);
+
+	std::uint32_t value = 0;
+	putils::reflection::binary_decoder decoder(value);
+	EXPECT_EQ(decoder.feed(std::span<const char>(buffer).subspan(0, 2)), 2u);
+	EXPECT_EQ(decoder.feed(std::span<const char>(buffer).subspan(2)), 2u);
+	EXPECT_TRUE(decoder.is_done());
+	EXPECT_EQ(value, 42u);
+	EXPECT_EQ(decoder.feed(buffer), 0u);
+}
+
+TEST(binary_decoder, destroyed_while_decoding) {
+	const auto expected = make_packet();
+	std::vector<char> buffer;
+	putils::reflection::to_binary(expected, buffer);
+
+	packet obj;
+	{
+		putils::reflection::binary_decoder decoder(obj);
+		decoder.feed(std::span<const char>(buffer).subspan(0, buffer.size() / 2));
+		EXPECT_FALSE(decoder.is_done());
+	}
+}
+
+TEST(binary_decoder, corrupted_size) {
+	std::vector<char> buffer;
+	putils::reflection::to_binary(std::uint32_t(1'000'000'000), buffer);
+	buffer.push_back('a');
+
+	std::string str;
+	putils::reflection::binary_decoder decoder(str);
+	decoder.feed(buffer);
+	EXPECT_FALSE(decoder.is_done());
+	EXPECT_LE(str.size(), 2u);
+}
+
+TEST(binary_decoder, large_vector_single_chunk) {
+	// Each element completes several tasks within the same feed, which mustn't nest stack frames, even without optimizations
+	std::vector<entry> expected(100'000);
+	for (std::size_t i = 0; i < expected.size(); ++i) {
+		expected[i].id = int(i);
+		expected[i].name = std::to_string(i);
+	}
+	std::vector<char> buffer;
+	putils::reflection::to_binary(expected, buffer);
+
+	std::vector<entry> obj;
+	putils::reflection::binary_decoder decoder(obj);
+	EXPECT_EQ(decoder.feed(buffer), buffer.size());
+	EXPECT_TRUE(decoder.is_done());
+	ASSERT_EQ(obj.size(), expected.size());
+	EXPECT_EQ(obj.back().id, 99'999);
+	EXPECT_EQ(obj.back().name, "99999");
+}
@@ -0,0 +1,167 @@
+// stl
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/binary_serializer.hpp"
+
+namespace {
+	struct vec2 {
+		float x = 0;
+		float y = 0;
+	};
+
+	// Padding between tag and value isn't encoded
+	struct padded_point {
+		std::uint8_t tag = 0;
+		std::uint32_t value = 0;
+	};
+
+	// Only reflected attributes are encoded
+	struct partial_point {
+		int x = 0;
+		int unreflected = 0;
+	};
+
+	enum class color : std::uint8_t {
+		red,
+		blue,
+	};
+
+	struct nested {
+		int id = 0;
+		const int constant = 42;
+		std::string name;
+		std::vector<vec2> points;
+		std::vector<std::string> tags;
+		std::vector<bool> flags;
+		std::array<int, 3> triple = {};
+		vec2 position;
+		color tint = color::red;
+
+		bool operator==(const nested & other) const {
+			return id == other.id && name == other.name && points.size() == other.points.size() && tags == other.tags && flags == other.flags && triple == other.triple && position.x == other.position.x && position.y == other.position.y && tint == other.tint;
+		}
+	};
+}
+
+#define refltype padded_point
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(tag),
+		putils_reflection_attribute(value)
+	);
+};
+#undef refltype
+
+#define refltype partial_point
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x)
+	);
+};
+#undef refltype
+
+#define refltype nested
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(constant),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(points),
+		putils_reflection_attribute(tags),
+		putils_reflection_attribute(flags),
+		putils_reflection_attribute(triple),
+		putils_reflection_attribute(position),
+		putils_reflection_attribute(tint)
+	);
+};
+#undef refltype
+
+TEST(binary_serializer, scalar) {
+	std::vector<char> buffer;
+	putils::reflection::to_binary(std::uint32_t(0x01020304), buffer);
+	ASSERT_EQ(buffer.size(), 4u);
+	EXPECT_EQ(buffer[0], 4);
+	EXPECT_EQ(buffer[3], 1);
+
+	std::uint32_t value = 0;
+	EXPECT_EQ(putils::reflection::from_binary(buffer, value), 4u);
+	EXPECT_EQ(value, 0x01020304u);
+}
+
+TEST(binary_serializer, round_trip) {
+	const nested obj{
+		.id = 1,
+		.name = "foo",
+		.points = { { 1, 2 }, { 3, 4 } },
+		.tags = { "a", "bc" },
+		.flags = { true, false, true },
+		.triple = { 1, 2, 3 },
+		.position = { 5, 6 },
+		.tint = color::blue,
+	};
+
+	std::vector<char> buffer;
+	putils::reflection::to_binary(obj, buffer);
+
+	nested result;
+	const auto read = putils::reflection::from_binary(buffer, result);
+	ASSERT_TRUE(read);
+	EXPECT_EQ(*read, buffer.size());
+	EXPECT_EQ(result, obj);
+	EXPECT_EQ(result.points[1].y, 4);
+}
+
+TEST(binary_serializer, truncated) {
+	nested obj;
+	obj.name = "foo";
+	std::vector<char> buffer;
+	putils::reflection::to_binary(obj, buffer);
+
+	for (std::size_t size = 0; size < buffer.size(); ++size) {
+		nested result;
+		EXPECT_FALSE(putils::reflection::from_binary(std::span(buffer).first(size), result));
+	}
+}
+
+TEST(binary_serializer, vectors_of_reflected_types) {
+	const std::vector<padded_point> padded{ { 1, 2 }, { 3, 4 } };
+	std::vector<char> buffer;
+	putils::reflection::to_binary(padded, buffer);
+	EXPECT_EQ(buffer.size(), 4 + 2 * (sizeof(std::uint8_t) + sizeof(std::uint32_t)));
+
+	std::vector<padded_point> padded_result;
+	EXPECT_EQ(putils::reflection::from_binary(buffer, padded_result), buffer.size());
+	ASSERT_EQ(padded_result.size(), 2u);
+	EXPECT_EQ(padded_result[1].tag, 3);
+	EXPECT_EQ(padded_result[1].value, 4u);
+
+	const std::vector<partial_point> partial{ { 1, 2 }, { 3, 4 } };
+	buffer.clear();
+	putils::reflection::to_binary(partial, buffer);
+	EXPECT_EQ(buffer.size(), 4 + 2 * sizeof(int));
+
+	std::vector<partial_point> partial_result;
+	EXPECT_EQ(putils::reflection::from_binary(buffer, partial_result), buffer.size());
+	ASSERT_EQ(partial_result.size(), 2u);
+	EXPECT_EQ(partial_result[1].x, 3);
+	EXPECT_EQ(partial_result[1].unreflected, 0);
+}
+
+TEST(binary_serializer, string_view) {
+	std::vector<char> from_view;
+	putils::reflection::to_binary(std::string_view("hello"), from_view);
+	std::vector<char> from_string;
+	putils::reflection::to_binary(std::string("hello"), from_string);
+	EXPECT_EQ(from_view, from_string);
+
+	std::string result;
+	EXPECT_EQ(putils::reflection::from_binary(from_view, result), from_view.size());
+	EXPECT_EQ(result, "hello");
+}
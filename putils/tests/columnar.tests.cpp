@@ -0,0 +1,195 @@
+// stl
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/columnar.hpp"
+
+namespace {
+	enum class sensor_kind : std::uint8_t {
+		temperature,
+		pressure,
+		humidity = 42,
+	};
+
+	struct position {
+		double lat = 0;
+		double lon = 0;
+	};
+
+	struct reading {
+		std::int64_t timestamp = 0;
+		std::uint16_t sensor = 0;
+		float value = 0;
+		bool valid = false;
+		std::string site;
+		sensor_kind kind = sensor_kind::temperature;
+		position where;
+		std::vector<int> raw;
+		const int version = 1;
+
+		bool operator==(const reading & rhs) const noexcept {
+			return timestamp == rhs.timestamp && sensor == rhs.sensor && value == rhs.value && valid == rhs.valid && site == rhs.site && kind == rhs.kind && where.lat == rhs.where.lat && where.lon == rhs.where.lon && raw == rhs.raw;
+		}
+	};
+
+	// Only has const attributes, so rows encode to nothing
+	struct marker {
+		const int version = 1;
+	};
+}
+
+#define refltype position
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(lat),
+		putils_reflection_attribute(lon)
+	);
+};
+#undef refltype
+
+#define refltype marker
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(version)
+	);
+};
+#undef refltype
+
+#define refltype reading
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(timestamp),
+		putils_reflection_attribute(sensor),
+		putils_reflection_attribute(value),
+		putils_reflection_attribute(valid),
+		putils_reflection_attribute(site),
+		putils_reflection_attribute(kind),
+		putils_reflection_attribute(where),
+		putils_reflection_attribute(raw),
+		putils_reflection_attribute(version)
+	);
+};
+#undef refltype
+
+namespace {
+	std::vector<reading> make_readings(std::size_t count) noexcept {
+		static const char * sites[] = { "north", "south", "east" };
+
+		std::vector<reading> ret(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto & r = ret[i];
+			r.timestamp = 1'700'000'000'000 + std::int64_t(i) * 1000;
+			r.sensor = std::uint16_t(i % 4);
+			r.value = 20.f + float(i % 8) * .5f;
+			r.valid = i % 3 != 0;
+			r.site = sites[i % 3];
+			r.kind = i % 2 ? sensor_kind::humidity : sensor_kind::pressure;
+			r.where.lat = 48.85;
+			r.where.lon = 2.35 - double(i) * .001;
+			r.raw = { int(i), -int(i) };
+		}
+		return ret;
+	}
+}
+
+TEST(columnar, round_trip) {
+	const auto readings = make_readings(100);
+
+	std::vector<char> buffer;
+	putils::reflection::encode_columns(std::span<const reading>(readings), buffer);
+
+	std::vector<reading> decoded;
+	EXPECT_EQ(putils::reflection::decode_columns(buffer, decoded), buffer.size());
+	EXPECT_EQ(decoded, readings);
+}
+
+TEST(columnar, smaller_than_rows) {
+	const auto readings = make_readings(100);
+
+	std::vector<char> columns;
+	putils::reflection::encode_columns(std::span<const reading>(readings), columns);
+
+	std::vector<char> rows;
+	for (const auto & r : readings)
+		putils::reflection::to_binary(r, rows);
+
+	EXPECT_LT(columns.size(), rows.size());
+}
+
+TEST(columnar, extreme_values) {
+	std::vector<reading> readings(3);
+	readings[0].timestamp = std::numeric_limits<std::int64_t>::min();
+	readings[1].timestamp = std::numeric_limits<std::int64_t>::max();
+	readings[1].sensor = std::numeric_limits<std::uint16_t>::max();
+	readings[1].value = -std::numeric_limits<float>::infinity();
+	readings[2].value = std::numeric_limits<float>::denorm_min();
+	readings[2].site = std::string("with\0nul", 8);
+
+	std::vector<char> buffer;
+	putils::reflection::encode_columns(std::span<const reading>(readings), buffer);
+
+	std::vector<reading> decoded;
+	EXPECT_EQ(putils::reflection::decode_columns(buffer, decoded), buffer.size());
+	EXPECT_EQ(decoded, readings);
+}
+
+TEST(columnar, appends) {
+	const auto readings = make_readings(4);
+
+	std::vector<char> buffer;
+	putils::reflection::encode_columns(std::span<const reading>(readings), buffer);
+
+	std::vector<reading> decoded(1);
+	EXPECT_TRUE(putils::reflection::decode_columns(buffer, decoded));
+	EXPECT_EQ(decoded.size(), 5u);
+	EXPECT_EQ(decoded[1], readings[0]);
+}
+
+TEST(columnar, empty) {
+	std::vector<char> buffer;
+	putils::reflection::encode_columns(std::span<const reading>(), buffer);
+
+	std::vector<reading> decoded;
+	EXPECT_EQ(putils::reflection::decode_columns(buffer, decoded), buffer.size());
+	EXPECT_TRUE(decoded.empty());
+}
+
+TEST(columnar, truncated) {
+	const auto readings = make_readings(10);
+
+	std::vector<char> buffer;
+	putils::reflection::encode_columns(std::span<const reading>(readings), buffer);
+
+	for (std::size_t size = 0; size < buffer.size(); ++size) {
+		std::vector<reading> decoded;
+		EXPECT_FALSE(putils::reflection::decode_columns(std::span<const char>(buffer.data(), size), decoded));
+		EXPECT_TRUE(decoded.empty());
+	}
+}
+
+TEST(columnar, zero_width_rows) {
+	const std::vector<marker> markers(100);
+	std::vector<char> buffer;
+	putils::reflection::encode_columns(std::span<const marker>(markers), buffer);
+	EXPECT_EQ(buffer.size(), 1u);
+
+	std::vector<marker> decoded;
+	EXPECT_EQ(putils::reflection::decode_columns(buffer, decoded), buffer.size());
+	EXPECT_EQ(decoded.size(), markers.size());
+}
+
+TEST(columnar, corrupted_count) {
+	std::vector<char> buffer;
+	putils::reflection::encode_columns(std::span<const reading>(make_readings(2)), buffer);
+	buffer[0] = char(0xff); // Continue the row count varint into the payload
+
+	std::vector<reading> decoded;
+	EXPECT_FALSE(putils::reflection::decode_columns(buffer, decoded));
+	EXPECT_TRUE(decoded.empty());
+}
@@ -0,0 +1,156 @@
+// stl
+#include <cstddef>
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/convert.hpp"
+
+namespace {
+	struct net_vec3 {
+		float x = 0;
+		float y = 0;
+		float z = 0;
+	};
+
+	struct vec3 {
+		float x = 0;
+		float y = 0;
+		float z = 0;
+	};
+
+	struct net_entity {
+		int id = 0;
+		int health = 0;
+		int mana = 0;
+		double speed = 0;
+		net_vec3 pos;
+		std::string name;
+	};
+
+	struct entity {
+		int id = 0;
+		int health = 0;
+		int mana = 0;
+		float speed = 0;
+		vec3 position;
+		std::string name;
+		const int version = 1;
+		int local_only = 42;
+	};
+}
+
+#define refltype net_vec3
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y),
+		putils_reflection_attribute(z)
+	);
+};
+#undef refltype
+
+#define refltype vec3
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y),
+		putils_reflection_attribute(z)
+	);
+};
+#undef refltype
+
+#define refltype net_entity
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(health),
+		putils_reflection_attribute(mana),
+		putils_reflection_attribute(speed),
+		putils_reflection_attribute(pos),
+		putils_reflection_attribute(name)
+	);
+};
+#undef refltype
+
+#define refltype entity
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(health),
+		putils_reflection_attribute(mana),
+		putils_reflection_attribute(speed),
+		putils_reflection_attribute(position, putils_reflection_metadata("convert_from", "pos")),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(version),
+		putils_reflection_attribute(local_only)
+	);
+};
+#undef refltype
+
+TEST(convert, same_layout) {
+	const net_vec3 src{ 1, 2, 3 };
+	const auto dst = putils::reflection::convert<vec3>(src);
+	EXPECT_EQ(dst.x, 1);
+	EXPECT_EQ(dst.y, 2);
+	EXPECT_EQ(dst.z, 3);
+
+	// x, y and z are contiguous in both types
+	constexpr auto & plan = putils::reflection::detail::convert::copy_plan_for<vec3, net_vec3>;
+	static_assert(plan.run_count == 1);
+	static_assert(plan.runs[0].size == sizeof(float) * 3);
+}
+
+TEST(convert, by_name) {
+	net_entity src;
+	src.id = 1;
+	src.health = 2;
+	src.mana = 3;
+	src.speed = 4.5;
+	src.pos = { 5, 6, 7 };
+	src.name = "foo";
+
+	const auto dst = putils::reflection::convert<entity>(src);
+	EXPECT_EQ(dst.id, 1);
+	EXPECT_EQ(dst.health, 2);
+	EXPECT_EQ(dst.mana, 3);
+	EXPECT_EQ(dst.speed, 4.5f);
+	EXPECT_EQ(dst.position.x, 5);
+	EXPECT_EQ(dst.position.z, 7);
+	EXPECT_EQ(dst.name, "foo");
+	EXPECT_EQ(dst.version, 1);
+	EXPECT_EQ(dst.local_only, 42);
+
+	// id, health and mana are copied together, speed has a different type
+	constexpr auto & plan = putils::reflection::detail::convert::copy_plan_for<entity, net_entity>;
+	static_assert(plan.run_count == 1);
+	static_assert(plan.runs[0].src_offset == offsetof(net_entity, id));
+	static_assert(plan.runs[0].dst_offset == offsetof(entity, id));
+	static_assert(plan.runs[0].size == sizeof(int) * 3);
+}
+
+TEST(convert, back_and_forth) {
+	entity src;
+	src.id = 1;
+	src.speed = 2;
+	src.position = { 3, 4, 5 };
+	src.name = "foo";
+
+	net_entity dst;
+	putils::reflection::convert(src, dst);
+	// entity::position is converted from net_entity::pos, but net_entity::pos has no equivalent in entity
+	EXPECT_EQ(dst.pos.x, 0);
+
+	entity round_trip;
+	putils::reflection::convert(dst, round_trip);
+	EXPECT_EQ(round_trip.id, 1);
+	EXPECT_EQ(round_trip.speed, 2);
+	EXPECT_EQ(round_trip.name, "foo");
+
+	// The memcpy runs computed during the first conversion are reused
+	src.id = 2;
+	putils::reflection::convert(src, dst);
+	EXPECT_EQ(dst.id, 2);
+}
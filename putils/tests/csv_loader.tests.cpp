@@ -0,0 +1,155 @@
+// stl
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/csv_loader.hpp"
+
+namespace {
+	enum class kind {
+		a,
+		b,
+	};
+
+	struct row {
+		int id = 0;
+		float value = 0.f;
+		bool flag = false;
+		kind type = kind::a;
+		std::string name;
+	};
+}
+
+#define refltype row
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(value),
+		putils_reflection_attribute(flag),
+		putils_reflection_attribute(type),
+		putils_reflection_attribute(name)
+	);
+};
+#undef refltype
+
+TEST(csv_loader, load_csv) {
+	const auto result = putils::reflection::load_csv<row>(
+		"name,id,value,flag,type\n"
+		"foo,1,0.5,true,1\r\n"
+		"\"bar, \"\"baz\"\"\",2,-1.25,0,0\n"
+	);
+	ASSERT_FALSE(result.error);
+	ASSERT_EQ(result.objects.size(), 2u);
+
+	EXPECT_EQ(result.objects[0].id, 1);
+	EXPECT_EQ(result.objects[0].value, 0.5f);
+	EXPECT_TRUE(result.objects[0].flag);
+	EXPECT_EQ(result.objects[0].type, kind::b);
+	EXPECT_EQ(result.objects[0].name, "foo");
+
+	EXPECT_EQ(result.objects[1].id, 2);
+	EXPECT_EQ(result.objects[1].value, -1.25f);
+	EXPECT_FALSE(result.objects[1].flag);
+	EXPECT_EQ(result.objects[1].type, kind::a);
+	EXPECT_EQ(result.objects[1].name, "bar, \"baz\"");
+}
+
+TEST(csv_loader, load_tsv) {
+	const auto result = putils::reflection::load_csv<row>("id\tname\n42\thello world\n", { .separator = '\t' });
+	ASSERT_FALSE(result.error);
+	ASSERT_EQ(result.objects.size(), 1u);
+	EXPECT_EQ(result.objects[0].id, 42);
+	EXPECT_EQ(result.objects[0].name, "hello world");
+}
+
+TEST(csv_loader, empty) {
+	const auto result = putils::reflection::load_csv<row>("");
+	EXPECT_FALSE(result.error);
+	EXPECT_TRUE(result.objects.empty());
+}
+
+TEST(csv_loader, unknown_column_error) {
+	const auto result = putils::reflection::load_csv<row>("id,unknown\n1,2\n");
+	ASSERT_TRUE(result.error);
+	EXPECT_EQ(result.error->line, 1u);
+	EXPECT_TRUE(result.objects.empty());
+}
+
+TEST(csv_loader, unknown_column_skip) {
+	const auto result = putils::reflection::load_csv<row>("id,unknown\n1,2\n", { .unknown_columns = putils::reflection::csv_options::unknown_column_policy::skip });
+	ASSERT_FALSE(result.error);
+	ASSERT_EQ(result.objects.size(), 1u);
+	EXPECT_EQ(result.objects[0].id, 1);
+}
+
+TEST(csv_loader, invalid_value) {
+	const auto result = putils::reflection::load_csv<row>("id,value\n1,2\n3,foo\n");
+	ASSERT_TRUE(result.error);
+	EXPECT_EQ(result.error->line, 3u);
+}
+
+TEST(csv_loader, missing_value) {
+	const auto result = putils::reflection::load_csv<row>("id,value\n1\n");
+	ASSERT_TRUE(result.error);
+	EXPECT_EQ(result.error->line, 2u);
+}
+
+TEST(csv_loader, unclosed_quote) {
+	const auto result = putils::reflection::load_csv<row>("id,name\n1,\"a\"\n2,\"b, c\n3,c\n");
+	ASSERT_TRUE(result.error);
+	EXPECT_EQ(result.error->line, 3u);
+	EXPECT_EQ(result.error->message, "Unclosed quote in column 'name'");
+	EXPECT_TRUE(result.objects.empty());
+
+	const auto header = putils::reflection::load_csv<row>("id,\"name\n1,a\n");
+	ASSERT_TRUE(header.error);
+	EXPECT_EQ(header.error->line, 1u);
+}
+
+TEST(csv_loader, parallel_chunks) {
+	std::string data = "id,name\n";
+	for (int i = 0; i < 10000; ++i)
+		data += std::to_string(i) + ",name" + std::to_string(i) + '\n';
+
+	const auto result = putils::reflection::load_csv<row>(data, { .thread_count = 4, .min_chunk_size = 1024 });
+	ASSERT_FALSE(result.error);
+	ASSERT_EQ(result.objects.size(), 10000u);
+	for (int i = 0; i < 10000; ++i) {
+		EXPECT_EQ(result.objects[i].id, i);
+		EXPECT_EQ(result.objects[i].name, "name" + std::to_string(i));
+	}
+}
+
+TEST(csv_loader, parallel_chunks_error_line) {
+	std::string data = "id\n";
+	for (int i = 0; i < 10000; ++i)
+		data += (i == 9000 ? std::string("x") : std::to_string(i)) + '\n';
+
+	const auto result = putils::reflection::load_csv<row>(data, { .thread_count = 4, .min_chunk_size = 1024 });
+	ASSERT_TRUE(result.error);
+	EXPECT_EQ(result.error->line, 9002u);
+}
+
+TEST(csv_loader, load_csv_file) {
+	const auto path = std::filesystem::temp_directory_path() / "putils_reflection_csv_loader_test.csv";
+	{
+		std::ofstream file(path);
+		file << "id,name\n1,foo\n2,bar\n";
+	}
+
+	const auto result = putils::reflection::load_csv_file<row>(path.string().c_str());
+	std::filesystem::remove(path);
+
+	ASSERT_FALSE(result.error);
+	ASSERT_EQ(result.objects.size(), 2u);
+	EXPECT_EQ(result.objects[1].name, "bar");
+}
+
+TEST(csv_loader, load_csv_file_missing) {
+	const auto result = putils::reflection::load_csv_file<row>("this/file/does/not/exist.csv");
+	EXPECT_TRUE(result.error);
+}
@@ -0,0 +1,229 @@
+// stl
+#include <algorithm>
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/indexed_vector.hpp"
+
+namespace {
+	struct entity {
+		int owner_id = 0;
+		std::string name;
+		float health = 100.f;
+	};
+}
+
+#define refltype entity
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(owner_id),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(health)
+	);
+};
+#undef refltype
+
+namespace {
+	using entity_vector = putils::reflection::indexed_vector<entity, &entity::owner_id, &entity::name>;
+
+	std::vector<std::size_t> sorted(std::span<const std::size_t> positions) {
+		std::vector<std::size_t> ret(positions.begin(), positions.end());
+		std::sort(ret.begin(), ret.end());
+		return ret;
+	}
+}
+
+TEST(indexed_vector, find) {
+	entity_vector entities;
+	entities.push_back({ .owner_id = 1, .name = "a" });
+	entities.push_back({ .owner_id = 2, .name = "b" });
+	entities.push_back({ .owner_id = 1, .name = "c" });
+
+	EXPECT_EQ(sorted(entities.find<&entity::owner_id>(1)), (std::vector<std::size_t>{ 0, 2 }));
+	EXPECT_EQ(sorted(entities.find<&entity::owner_id>(2)), (std::vector<std::size_t>{ 1 }));
+	EXPECT_TRUE(entities.find<&entity::owner_id>(3).empty());
+	EXPECT_EQ(sorted(entities.find<&entity::name>("c")), (std::vector<std::size_t>{ 2 }));
+}
+
+TEST(indexed_vector, find_by_name) {
+	entity_vector entities;
+	entities.push_back({ .owner_id = 1, .name = "a" });
+	entities.push_back({ .owner_id = 1, .name = "b" });
+
+	EXPECT_EQ(entities.find("owner_id", 1).size(), 2u);
+	EXPECT_EQ(entities.find("name", "b").size(), 1u);
+	EXPECT_TRUE(entities.find("health", 100.f).empty());
+	EXPECT_TRUE(entities.find("unknown", 1).empty());
+}
+
+TEST(indexed_vector, is_indexed) {
+	static_assert(entity_vector::is_indexed("owner_id"));
+	static_assert(entity_vector::is_indexed("name"));
+	static_assert(!entity_vector::is_indexed("health"));
+	SUCCEED();
+}
+
+TEST(indexed_vector, set) {
+	entity_vector entities;
+	entities.push_back({ .owner_id = 1, .name = "a" });
+
+	entities.set<&entity::owner_id>(0, 2);
+	EXPECT_TRUE(entities.find<&entity::owner_id>(1).empty());
+	EXPECT_EQ(entities.find<&entity::owner_id>(2).size(), 1u);
+
+	entities.set<&entity::health>(0, 42.f);
+	EXPECT_EQ(entities[0].health, 42.f);
+}
+
+TEST(indexed_vector, set_by_name) {
+	entity_vector entities;
+	entities.push_back({ .owner_id = 1, .name = "a" });
+
+	EXPECT_TRUE(entities.set(0, "name", std::string("b")));
+	EXPECT_TRUE(entities.find("name", "a").empty());
+	EXPECT_EQ(entities.find("name", "b").size(), 1u);
+
+	EXPECT_TRUE(entities.set(0, "health", 0.f));
+	EXPECT_EQ(entities[0].health, 0.f);
+
+	EXPECT_FALSE(entities.set(0, "unknown", 0));
+}
+
+TEST(indexed_vector, modify) {
+	entity_vector entities;
+	entities.push_back({ .owner_id = 1, .name = "a" });
+
+	entities.modify(0, [](entity & e) {
+		e.owner_id = 3;
+		e.name = "b";
+	});
+	EXPECT_TRUE(entities.find<&entity::owner_id>(1).empty());
+	EXPECT_EQ(entities.find<&entity::owner_id>(3).size(), 1u);
+	EXPECT_EQ(entities.find<&entity::name>("b").size(), 1u);
+}
+
+TEST(indexed_vector, erase) {
+	entity_vector entities;
+	entities.push_back({ .owner_id = 1, .name = "a" });
+	entities.push_back({ .owner_id = 2, .name = "b" });
+	entities.push_back({ .owner_id = 3, .name = "c" });
+
+	entities.erase(0);
+	ASSERT_EQ(entities.size(), 2u);
+	EXPECT_TRUE(entities.find<&entity::owner_id>(1).empty());
+
+	// Last element was moved to position 0
+	EXPECT_EQ(sorted(entities.find<&entity::owner_id>(3)), (std::vector<std::size_t>{ 0 }));
+	EXPECT_EQ(entities[0].name, "c");
+
+	entities.erase(1);
+	EXPECT_EQ(entities.size(), 1u);
+	EXPECT_TRUE(entities.find<&entity::owner_id>(2).empty());
+}
+
+TEST(indexed_vector, index_memory_usage) {
+	entity_vector entities;
+	const auto empty_usage = entities.index_memory_usage();
+
+	for (int i = 0; i < 100; ++i)
+		entities.push_back({ .owner_id = i % 10, .name = std::to_string(i) });
+	const auto usage = entities.index_memory_usage();
+	EXPECT_GT(usage, empty_usage);
+
+	entities.clear();
+	EXPECT_LT(entities.index_memory_usage(), usage);
+}
+
+TEST(indexed_vector, erase_keeps_buckets_consistent) {
+	entity_vector entities;
+	for (int i = 0; i < 20; ++i)
+		entities.push_back({ .owner_id = i % 2, .name = std::to_string(i) });
+
+	while (entities.size() > 3)
+		entities.erase(entities.size() % 3);
+
+	for (int owner_id = 0; owner_id < 2; ++owner_id)
+		for (const auto position : entities.find<&entity::owner_id>(owner_id))
+			EXPECT_EQ(entities[position].owner_id, owner_id);
+	EXPECT_EQ(entities.find<&entity::owner_id>(0).size() + entities.find<&entity::owner_id>(1).size(), 3u);
+}
+
+namespace {
+	using sorted_entity_vector = putils::reflection::indexed_vector<entity, &entity::owner_id, putils::reflection::sorted_index<&entity::health>>;
+
+	std::vector<float> get_health_in_range(const sorted_entity_vector & entities, float min, float max) {
+		std::vector<float> ret;
+		entities.for_each_in_range<&entity::health>(min, max, [&](std::size_t position) { ret.push_back(entities[position].health); });
+		return ret;
+	}
+}
+
+TEST(indexed_vector, sorted_index) {
+	sorted_entity_vector entities;
+	for (int i = 0; i < 10; ++i)
+		entities.push_back({ .owner_id = i, .name = "", .health = float(10 - i) });
+
+	EXPECT_EQ(get_health_in_range(entities, 3, 5), (std::vector<float>{ 3, 4, 5 }));
+	EXPECT_EQ(entities.find<&entity::health>(7.f).size(), 1u);
+	EXPECT_TRUE(get_health_in_range(entities, 20, 30).empty());
+
+	entities.set<&entity::health>(0, 4.5f);
+	entities.erase(1);
+	EXPECT_EQ(get_health_in_range(entities, 3, 5), (std::vector<float>{ 3, 4, 4.5f, 5 }));
+
+	std::size_t count = 0;
+	EXPECT_TRUE(entities.for_each_in_range("health", 0, 100, [&](std::size_t) { ++count; }));
+	EXPECT_EQ(count, entities.size());
+	EXPECT_FALSE(entities.for_each_in_range("owner_id", 0, 100, [&](std::size_t) {}));
+	EXPECT_TRUE(sorted_entity_vector::is_indexed("health"));
+}
+
+TEST(runtime_indexed_vector, add_index) {
+	putils::reflection::runtime_indexed_vector<entity> entities;
+	entities.push_back({ .owner_id = 1, .name = "a" });
+	entities.push_back({ .owner_id = 2, .name = "b" });
+
+	EXPECT_FALSE(entities.is_indexed("owner_id"));
+	EXPECT_TRUE(entities.find("owner_id", 1).empty());
+
+	// Existing elements are indexed
+	EXPECT_TRUE(entities.add_index("owner_id"));
+	EXPECT_TRUE(entities.is_indexed("owner_id"));
+	EXPECT_EQ(sorted(entities.find("owner_id", 1)), (std::vector<std::size_t>{ 0 }));
+
+	entities.push_back({ .owner_id = 1, .name = "c" });
+	EXPECT_EQ(sorted(entities.find("owner_id", 1)), (std::vector<std::size_t>{ 0, 2 }));
+
+	EXPECT_FALSE(entities.add_index("unknown"));
+	EXPECT_TRUE(entities.remove_index("owner_id"));
+	EXPECT_FALSE(entities.remove_index("owner_id"));
+	EXPECT_TRUE(entities.find("owner_id", 1).empty());
+	EXPECT_EQ(entities.index_memory_usage(), 0u);
+}
+
+TEST(runtime_indexed_vector, set_modify_erase) {
+	putils::reflection::runtime_indexed_vector<entity> entities;
+	EXPECT_TRUE(entities.add_index("name"));
+	EXPECT_TRUE(entities.add_index("health", putils::reflection::index_kind::sorted));
+	for (int i = 0; i < 5; ++i)
+		entities.push_back({ .owner_id = i, .name = std::to_string(i), .health = float(i) });
+
+	EXPECT_TRUE(entities.set(0, "name", std::string("x")));
+	EXPECT_TRUE(entities.find("name", "0").empty());
+	EXPECT_EQ(entities.find("name", "x").size(), 1u);
+
+	entities.modify(1, [](entity & e) { e.health = 10.f; });
+	entities.erase(2);
+
+	std::vector<float> health;
+	EXPECT_TRUE(entities.for_each_in_range("health", 0.f, 3.5f, [&](std::size_t position) { health.push_back(entities[position].health); }));
+	EXPECT_EQ(health, (std::vector<float>{ 0, 3 }));
+	EXPECT_FALSE(entities.for_each_in_range("name", "a", "z", [](std::size_t) {}));
+
+	ASSERT_EQ(entities.find("name", "4").size(), 1u);
+	EXPECT_EQ(entities[entities.find("name", "4")[0]].owner_id, 4);
+	EXPECT_GT(entities.index_memory_usage(), 0u);
+}
@@ -0,0 +1,175 @@
+// stl
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/lerp.hpp"
+
+namespace {
+	enum class state {
+		idle,
+		running,
+	};
+
+	struct vec2 {
+		float x = 0;
+		float y = 0;
+	};
+
+	struct entity {
+		vec2 position;
+		double speed = 0;
+		float heading = 0;
+		float radians = 0;
+		int health = 0;
+		std::uint8_t ammo = 0;
+		int frame = 0;
+		bool visible = false;
+		state current_state = state::idle;
+		std::string name;
+		const int id = 0;
+	};
+}
+
+#define refltype vec2
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y)
+	);
+};
+#undef refltype
+
+#define refltype entity
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(position),
+		putils_reflection_attribute(speed),
+		putils_reflection_attribute(heading, putils_reflection_metadata("angle", 360.f)),
+		putils_reflection_attribute(radians, putils_reflection_metadata("angle", 6.2831853f)),
+		putils_reflection_attribute(health),
+		putils_reflection_attribute(ammo),
+		putils_reflection_attribute(frame, putils_reflection_metadata("no_interp", true)),
+		putils_reflection_attribute(visible),
+		putils_reflection_attribute(current_state),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(id)
+	);
+};
+#undef refltype
+
+namespace {
+	entity make_a() noexcept {
+		entity ret;
+		ret.position = { 0.f, 10.f };
+		ret.speed = 1.0;
+		ret.heading = 350.f;
+		ret.radians = .1f;
+		ret.health = 100;
+		ret.ammo = 10;
+		ret.frame = 1;
+		ret.visible = false;
+		ret.current_state = state::idle;
+		ret.name = "a";
+		return ret;
+	}
+
+	entity make_b() noexcept {
+		entity ret;
+		ret.position = { 10.f, 20.f };
+		ret.speed = 3.0;
+		ret.heading = 10.f;
+		ret.radians = 6.1831853f;
+		ret.health = 60;
+		ret.ammo = 2;
+		ret.frame = 2;
+		ret.visible = true;
+		ret.current_state = state::running;
+		ret.name = "b";
+		return ret;
+	}
+}
+
+TEST(lerp, numbers) {
+	const auto a = make_a();
+	const auto b = make_b();
+	entity out;
+	putils::reflection::lerp(a, b, .25f, out);
+
+	EXPECT_FLOAT_EQ(out.position.x, 2.5f);
+	EXPECT_FLOAT_EQ(out.position.y, 12.5f);
+	EXPECT_DOUBLE_EQ(out.speed, 1.5);
+	EXPECT_EQ(out.health, 90);
+	EXPECT_EQ(out.ammo, 8);
+}
+
+TEST(lerp, angles) {
+	const auto a = make_a();
+	const auto b = make_b();
+	entity out;
+
+	putils::reflection::lerp(a, b, 0.f, out);
+	EXPECT_FLOAT_EQ(out.heading, 350.f);
+
+	putils::reflection::lerp(a, b, .25f, out);
+	EXPECT_FLOAT_EQ(out.heading, 355.f);
+
+	putils::reflection::lerp(a, b, .5f, out);
+	EXPECT_FLOAT_EQ(out.heading, 0.f);
+	EXPECT_NEAR(out.radians, 0.f, 1e-5f);
+
+	putils::reflection::lerp(a, b, 1.f, out);
+	EXPECT_FLOAT_EQ(out.heading, 10.f);
+}
+
+TEST(lerp, angles_backwards) {
+	// Shortest arc going through 0 the other way
+	const auto a = make_b();
+	const auto b = make_a();
+	entity out;
+
+	putils::reflection::lerp(a, b, .25f, out);
+	EXPECT_FLOAT_EQ(out.heading, 5.f);
+
+	putils::reflection::lerp(a, b, .75f, out);
+	EXPECT_FLOAT_EQ(out.heading, 355.f);
+
+	putils::reflection::lerp(a, b, 1.f, out);
+	EXPECT_FLOAT_EQ(out.heading, 350.f);
+}
+
+TEST(lerp, snapped) {
+	const auto a = make_a();
+	const auto b = make_b();
+	entity out;
+
+	putils::reflection::lerp(a, b, .4f, out);
+	EXPECT_EQ(out.frame, 1);
+	EXPECT_FALSE(out.visible);
+	EXPECT_EQ(out.current_state, state::idle);
+	EXPECT_EQ(out.name, "a");
+
+	putils::reflection::lerp(a, b, .6f, out);
+	EXPECT_EQ(out.frame, 2);
+	EXPECT_TRUE(out.visible);
+	EXPECT_EQ(out.current_state, state::running);
+	EXPECT_EQ(out.name, "b");
+}
+
+TEST(lerp, batch) {
+	std::vector<entity> a(100, make_a());
+	const std::vector<entity> b(100, make_b());
+	for (std::size_t i = 0; i < a.size(); ++i)
+		a[i].position.x = float(i);
+
+	putils::reflection::lerp(std::span<const entity>(a), std::span<const entity>(b), .5f, std::span<entity>(a));
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		EXPECT_FLOAT_EQ(a[i].position.x, (float(i) + 10.f) / 2.f);
+		EXPECT_EQ(a[i].health, 80);
+		EXPECT_EQ(a[i].name, "b");
+	}
+}
@@ -0,0 +1,94 @@
+// Profiling is normally enabled for the whole program. The types profiled here are local to this file
+#ifndef PUTILS_REFLECTION_PROFILE_LOOKUPS
+#define PUTILS_REFLECTION_PROFILE_LOOKUPS
+#endif
+
+// stl
+#include <source_location>
+#include <sstream>
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection.hpp"
+#include "putils/reflection_helpers/lookup_profile.hpp"
+
+namespace {
+	struct profiled {
+		int a = 0;
+		int b = 0;
+		int c = 0;
+	};
+}
+
+#define refltype profiled
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes(
+		putils_reflection_attribute(a),
+		putils_reflection_attribute(b),
+		putils_reflection_attribute(c, putils_reflection_metadata("range", 10))
+	);
+};
+#undef refltype
+
+TEST(lookup_profile, get_attribute) {
+	putils::reflection::reset_lookup_profile();
+
+	profiled obj;
+	std::uint_least32_t line = 0;
+	for (int i = 0; i < 5; ++i) {
+		line = std::source_location::current().line() + 1;
+		++*putils::reflection::get_attribute<int>(obj, "c");
+	}
+	EXPECT_EQ(obj.c, 5);
+
+	const auto profile = putils::reflection::get_lookup_profile();
+	ASSERT_EQ(profile.size(), 1u);
+	EXPECT_EQ(profile[0].class_name, "profiled");
+	EXPECT_EQ(profile[0].name, "c");
+	EXPECT_EQ(profile[0].function, "get_attribute");
+	EXPECT_EQ(profile[0].location.line(), line);
+	EXPECT_EQ(profile[0].call_count, 5u);
+	EXPECT_EQ(profile[0].scanned_count, 15u);
+}
+
+TEST(lookup_profile, ranking) {
+	putils::reflection::reset_lookup_profile();
+
+	for (int i = 0; i < 3; ++i)
+		EXPECT_TRUE(putils::reflection::has_attribute<profiled>("a"));
+	EXPECT_FALSE(putils::reflection::has_attribute<profiled>("unknown"));
+	EXPECT_EQ((*putils::reflection::get_attribute_metadata<int, profiled>("c", "range")), 10);
+	EXPECT_EQ((*putils::reflection::get_attribute_metadata<int, profiled, "range">("c")), 10);
+
+	const auto profile = putils::reflection::get_lookup_profile();
+	ASSERT_EQ(profile.size(), 4u);
+	// Ties on scanned_count are ranked by call_count
+	EXPECT_EQ(profile[0].name, "a");
+	EXPECT_EQ(profile[0].call_count, 3u);
+	EXPECT_EQ(profile[0].scanned_count, 3u);
+	EXPECT_EQ(profile[1].scanned_count, 3u);
+	EXPECT_EQ(profile[2].scanned_count, 3u);
+	EXPECT_EQ(profile[3].function, "get_attribute_metadata");
+	EXPECT_EQ(profile[3].scanned_count, 1u);
+}
+
+TEST(lookup_profile, print) {
+	putils::reflection::reset_lookup_profile();
+	EXPECT_TRUE(putils::reflection::has_attribute<profiled>("b"));
+
+	std::stringstream out;
+	putils::reflection::print_lookup_profile(out);
+	const auto report = out.str();
+	EXPECT_NE(report.find("2 scanned, 1 calls: has_attribute<profiled>(\"b\")"), std::string::npos);
+	EXPECT_NE(report.find("lookup_profile.tests.cpp"), std::string::npos);
+}
+
+TEST(lookup_profile, constexpr_lookups) {
+	putils::reflection::reset_lookup_profile();
+	static_assert(putils::reflection::has_attribute<profiled>("a"));
+	EXPECT_TRUE(putils::reflection::get_lookup_profile().empty());
+}
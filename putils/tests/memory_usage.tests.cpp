@@ -0,0 +1,166 @@
+// stl
+#include <cstdint>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/memory_usage.hpp"
+
+namespace {
+	struct padded {
+		std::uint8_t small = 0;
+		std::uint64_t large = 0;
+	};
+
+	struct cache_entry {
+		int id = 0;
+		std::string key;
+		std::vector<int> values;
+		padded header;
+		std::unique_ptr<padded> extra;
+		std::map<int, std::string> tags;
+	};
+}
+
+#define refltype padded
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(small),
+		putils_reflection_attribute(large)
+	);
+};
+#undef refltype
+
+#define refltype cache_entry
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(key),
+		putils_reflection_attribute(values),
+		putils_reflection_attribute(header),
+		putils_reflection_attribute(extra),
+		putils_reflection_attribute(tags)
+	);
+};
+#undef refltype
+
+TEST(memory_usage, scalar) {
+	const auto usage = putils::reflection::memory_usage(42);
+	EXPECT_EQ(usage.inline_size, sizeof(int));
+	EXPECT_EQ(usage.heap_size, 0u);
+	EXPECT_EQ(usage.get_total(), sizeof(int));
+}
+
+TEST(memory_usage, padding) {
+	const auto usage = putils::reflection::memory_usage(padded{});
+	EXPECT_EQ(usage.inline_size, sizeof(padded));
+	EXPECT_EQ(usage.padding, sizeof(padded) - sizeof(std::uint8_t) - sizeof(std::uint64_t));
+}
+
+TEST(memory_usage, short_string) {
+	const std::string str = "a";
+	EXPECT_EQ(putils::reflection::memory_usage(str).heap_size, 0u);
+}
+
+TEST(memory_usage, long_string) {
+	const std::string str(100, 'a');
+	const auto usage = putils::reflection::memory_usage(str);
+	EXPECT_EQ(usage.heap_size, 101u);
+	EXPECT_EQ(usage.slack, str.capacity() - str.size());
+}
+
+TEST(memory_usage, vector) {
+	std::vector<int> values;
+	values.reserve(10);
+	values.push_back(1);
+	values.push_back(2);
+
+	const auto usage = putils::reflection::memory_usage(values);
+	EXPECT_EQ(usage.heap_size, 2 * sizeof(int));
+	EXPECT_EQ(usage.slack, 8 * sizeof(int));
+}
+
+TEST(memory_usage, node_containers) {
+	constexpr auto pointer = sizeof(void *);
+
+	const std::map<int, int> map{ { 1, 1 }, { 2, 2 }, { 3, 3 } };
+	EXPECT_EQ(putils::reflection::memory_usage(map).heap_size, 3 * (sizeof(std::pair<const int, int>) + 4 * pointer));
+
+	const std::list<int> list{ 1, 2 };
+	EXPECT_EQ(putils::reflection::memory_usage(list).heap_size, 2 * (sizeof(int) + 2 * pointer));
+
+	const std::forward_list<int> forward_list{ 1, 2, 3 };
+	EXPECT_EQ(putils::reflection::memory_usage(forward_list).heap_size, 3 * (sizeof(int) + pointer));
+
+	const std::unordered_set<int> set{ 1, 2 };
+	EXPECT_EQ(putils::reflection::memory_usage(set).heap_size, set.bucket_count() * pointer + 2 * (sizeof(int) + 2 * pointer));
+
+	const std::deque<int> deque(10);
+	const auto deque_usage = putils::reflection::memory_usage(deque);
+	EXPECT_EQ(deque_usage.heap_size, 10 * sizeof(int) + pointer);
+	EXPECT_EQ(deque_usage.slack, 512 - 10 * sizeof(int));
+}
+
+TEST(memory_usage, object) {
+	cache_entry entry;
+	entry.key = std::string(50, 'k');
+	entry.values = { 1, 2, 3 };
+	entry.values.shrink_to_fit();
+	entry.extra = std::make_unique<padded>();
+
+	const auto usage = putils::reflection::memory_usage(entry);
+	EXPECT_EQ(usage.inline_size, sizeof(cache_entry));
+	EXPECT_EQ(usage.heap_size, 51 + 3 * sizeof(int) + sizeof(padded));
+	EXPECT_EQ(usage.slack, entry.key.capacity() - entry.key.size());
+
+	// cache_entry's own padding, plus header's
+	constexpr auto padded_padding = sizeof(padded) - sizeof(std::uint8_t) - sizeof(std::uint64_t);
+	constexpr auto attributes_size = sizeof(int) + sizeof(std::string) + sizeof(std::vector<int>) + sizeof(padded) + sizeof(std::unique_ptr<padded>) + sizeof(std::map<int, std::string>);
+	EXPECT_EQ(usage.padding, sizeof(cache_entry) - attributes_size + padded_padding);
+	// extra's pointee is on the heap
+	EXPECT_EQ(usage.heap_padding, padded_padding);
+}
+
+TEST(memory_usage, heap_padding) {
+	std::vector<padded> values(4);
+	const auto usage = putils::reflection::memory_usage(values);
+	EXPECT_EQ(usage.padding, 0u);
+	EXPECT_EQ(usage.heap_padding, 4 * (sizeof(padded) - sizeof(std::uint8_t) - sizeof(std::uint64_t)));
+}
+
+TEST(memory_usage, breakdown) {
+	std::vector<cache_entry> entries(10);
+	for (auto & entry : entries) {
+		entry.values.resize(100);
+		entry.values.shrink_to_fit();
+		entry.tags[0] = "tag";
+	}
+
+	const auto breakdown = putils::reflection::get_memory_usage_breakdown(std::span<const cache_entry>(entries));
+	EXPECT_EQ(breakdown.object_count, 10u);
+	ASSERT_EQ(breakdown.attributes.size(), 6u);
+
+	EXPECT_EQ(breakdown.attributes[0].name, "id");
+	EXPECT_EQ(breakdown.attributes[0].usage.inline_size, 10 * sizeof(int));
+
+	EXPECT_EQ(breakdown.attributes[2].name, "values");
+	EXPECT_EQ(breakdown.attributes[2].usage.heap_size, 10 * 100 * sizeof(int));
+
+	EXPECT_EQ(breakdown.attributes[5].name, "tags");
+	EXPECT_GT(breakdown.attributes[5].usage.heap_size, 10 * sizeof(std::pair<const int, std::string>));
+
+	std::size_t attributes_heap = 0;
+	for (const auto & attr : breakdown.attributes)
+		attributes_heap += attr.usage.heap_size;
+	EXPECT_EQ(breakdown.total.heap_size, attributes_heap);
+	EXPECT_EQ(breakdown.total.inline_size, 10 * sizeof(cache_entry));
+}
@@ -0,0 +1,188 @@
+// Instrumentation is normally enabled for the whole program. The types instrumented here are local to this file
+#ifndef PUTILS_REFLECTION_INSTRUMENT_METHODS
+#define PUTILS_REFLECTION_INSTRUMENT_METHODS
+#endif
+
+// stl
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection.hpp"
+#include "putils/reflection_helpers/method_stats.hpp"
+
+namespace {
+	struct service {
+		int value = 0;
+
+		int add(int i) noexcept { return value += i; }
+		constexpr int get() const noexcept { return value; }
+	};
+
+	struct worker {
+		void work() noexcept {}
+	};
+
+	struct ticker {
+		int ticks = 0;
+		void tick() noexcept { ++ticks; }
+	};
+
+	struct constant {
+		constexpr int get() const noexcept { return 42; }
+	};
+
+	struct first_unnamed {
+		int value() const noexcept { return 1; }
+	};
+
+	struct second_unnamed {
+		int value() const noexcept { return 2; }
+	};
+}
+
+#define refltype service
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_methods(
+		putils_reflection_attribute(add),
+		putils_reflection_attribute(get)
+	);
+};
+#undef refltype
+
+#define refltype worker
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_methods(
+		putils_reflection_attribute(work)
+	);
+};
+#undef refltype
+
+#define refltype ticker
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_methods(
+		putils_reflection_attribute(tick)
+	);
+};
+#undef refltype
+
+#define refltype constant
+putils_reflection_info {
+	putils_reflection_methods(
+		putils_reflection_attribute(get)
+	);
+};
+#undef refltype
+
+#define refltype first_unnamed
+putils_reflection_info {
+	putils_reflection_methods(
+		putils_reflection_attribute(value)
+	);
+};
+#undef refltype
+
+#define refltype second_unnamed
+putils_reflection_info {
+	putils_reflection_methods(
+		putils_reflection_attribute(value)
+	);
+};
+#undef refltype
+
+namespace {
+	putils::reflection::method_stats find_stats(std::string_view class_name, std::string_view method_name) noexcept {
+		for (const auto & stats : putils::reflection::get_method_stats())
+			if (stats.class_name == class_name && stats.method_name == method_name)
+				return stats;
+		return {};
+	}
+
+	// Types without a class name can't be told apart by find_stats
+	std::vector<std::uint64_t> get_unnamed_call_counts(std::string_view method_name) noexcept {
+		std::vector<std::uint64_t> ret;
+		for (const auto & stats : putils::reflection::get_method_stats())
+			if (stats.class_name.empty() && stats.method_name == method_name)
+				ret.push_back(stats.call_count);
+		std::sort(ret.begin(), ret.end());
+		return ret;
+	}
+
+	std::uint64_t sum_buckets(const putils::reflection::method_stats & stats) noexcept {
+		std::uint64_t ret = 0;
+		for (const auto count : stats.buckets)
+			ret += count;
+		return ret;
+	}
+}
+
+TEST(method_stats, get_method) {
+	service obj;
+	const auto add = putils::reflection::get_method<int(int)>(obj, "add");
+	ASSERT_TRUE(add);
+	for (int i = 0; i < 10; ++i)
+		(*add)(1);
+	EXPECT_EQ(obj.value, 10);
+
+	const auto stats = find_stats("service", "add");
+	EXPECT_EQ(stats.call_count, 10u);
+	EXPECT_EQ(sum_buckets(stats), 10u);
+	EXPECT_GT(stats.get_percentile_upper_bound(0.5), 0u);
+	EXPECT_EQ(find_stats("service", "get").call_count, 0u);
+}
+
+TEST(method_stats, for_each_method) {
+	ticker obj;
+	for (int i = 0; i < 3; ++i)
+		putils::reflection::for_each_method(obj, [](const auto & method) {
+			method.method();
+		});
+	EXPECT_EQ(obj.ticks, 3);
+	EXPECT_EQ(find_stats("ticker", "tick").call_count, 3u);
+}
+
+TEST(method_stats, exited_threads) {
+	std::thread t([] {
+		worker obj;
+		const auto work = putils::reflection::get_method<void()>(obj, "work");
+		(*work)();
+		(*work)();
+	});
+	t.join();
+	EXPECT_EQ(find_stats("worker", "work").call_count, 2u);
+}
+
+TEST(method_stats, constexpr_calls) {
+	static constexpr constant obj;
+	static constexpr auto get = putils::reflection::get_method<int (constant::*)() const noexcept>(obj, "get");
+	static_assert((*get)() == 42);
+
+	EXPECT_EQ((*get)(), 42);
+	const auto stats = find_stats("", "get");
+	EXPECT_EQ(stats.call_count, 1u);
+	EXPECT_EQ(stats.method_name, "get");
+}
+
+TEST(method_stats, unnamed_types) {
+	const first_unnamed first;
+	const auto first_value = putils::reflection::get_method<int()>(first, "value");
+	const second_unnamed second;
+	const auto second_value = putils::reflection::get_method<int()>(second, "value");
+	ASSERT_TRUE(first_value && second_value);
+
+	for (int i = 0; i < 5; ++i)
+		EXPECT_EQ((*first_value)(), 1);
+	for (int i = 0; i < 3; ++i)
+		EXPECT_EQ((*second_value)(), 2);
+
+	// One entry per method, even though neither type has a class name
+	EXPECT_EQ(get_unnamed_call_counts("value"), (std::vector<std::uint64_t>{ 3, 5 }));
+}
@@ -0,0 +1,92 @@
+// Built only with PUTILS_REFLECTION_MODULE, as it consumes the library through `import putils.reflection;`
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+// Headers are included before the import, as some compilers can't merge declarations included after it with the module's
+#include "putils/reflection_macros.hpp"
+import putils.reflection;
+
+namespace {
+	enum class shape {
+		circle,
+		square,
+	};
+
+	struct parent {
+		int iparent = 1;
+	};
+
+	struct reflectible : parent {
+		int i = 2;
+		float f = 3.f;
+		shape s = shape::square;
+
+		int get() const noexcept { return i; }
+	};
+}
+
+#define refltype shape
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_values(
+		putils_reflection_value(circle),
+		putils_reflection_value(square)
+	);
+};
+#undef refltype
+
+#define refltype parent
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(iparent)
+	);
+};
+#undef refltype
+
+#define refltype reflectible
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes(
+		putils_reflection_attribute(i, putils_reflection_metadata("max", 10)),
+		putils_reflection_attribute(f),
+		putils_reflection_attribute(s)
+	);
+	putils_reflection_methods(
+		putils_reflection_attribute(get)
+	);
+	putils_reflection_parents(
+		putils_reflection_type(parent)
+	);
+};
+#undef refltype
+
+TEST(reflection_module, type_info) {
+	static_assert(putils::reflection::is_reflectible<reflectible>());
+	EXPECT_STREQ(putils::reflection::get_class_name<reflectible>(), "reflectible");
+	static_assert(putils::reflection::has_parent<reflectible, parent>());
+}
+
+TEST(reflection_module, attributes) {
+	reflectible obj;
+	int count = 0;
+	putils::reflection::for_each_attribute(obj, [&](const auto &) { ++count; });
+	EXPECT_EQ(count, 4);
+
+	EXPECT_EQ(putils::reflection::get_attribute<int>(obj, "iparent"), &obj.iparent);
+	EXPECT_EQ((*putils::reflection::get_attribute_metadata<int, reflectible>("i", "max")), 10);
+	EXPECT_EQ((*putils::reflection::get_attribute_metadata<int, reflectible, "max">("i")), 10);
+}
+
+TEST(reflection_module, methods) {
+	const reflectible obj;
+	const auto get = putils::reflection::get_method<int()>(obj, "get");
+	ASSERT_TRUE(get);
+	EXPECT_EQ((*get)(), 2);
+}
+
+TEST(reflection_module, enums) {
+	EXPECT_EQ(putils::reflection::enum_to_string(shape::square), "square");
+	EXPECT_EQ(putils::reflection::enum_from_string<shape>("circle"), shape::circle);
+}
@@ -0,0 +1,143 @@
+// stl
+#include <memory>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/object_pool.hpp"
+
+namespace {
+	struct header {
+		int status = 200;
+		std::string content_type = "text/plain";
+	};
+
+	struct request {
+		int id = 0;
+		int retries = 3;
+		float timeout = 1.5f;
+		std::string body;
+		std::vector<int> values;
+		std::vector<int> defaults = { 1, 2 };
+		header head;
+	};
+
+	struct connection {
+		int port = 80;
+		std::unique_ptr<std::string> buffer;
+		std::vector<std::unique_ptr<int>> pending;
+	};
+}
+
+#define refltype header
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(status),
+		putils_reflection_attribute(content_type)
+	);
+};
+#undef refltype
+
+#define refltype request
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(retries),
+		putils_reflection_attribute(timeout),
+		putils_reflection_attribute(body),
+		putils_reflection_attribute(values),
+		putils_reflection_attribute(defaults),
+		putils_reflection_attribute(head)
+	);
+};
+#undef refltype
+
+#define refltype connection
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(port),
+		putils_reflection_attribute(buffer),
+		putils_reflection_attribute(pending)
+	);
+};
+#undef refltype
+
+TEST(object_pool, acquire) {
+	putils::reflection::object_pool<request> pool(4);
+	EXPECT_EQ(pool.get_allocated_count(), 0u);
+
+	const auto obj = pool.acquire();
+	EXPECT_EQ(obj->retries, 3);
+	EXPECT_EQ(pool.get_allocated_count(), 4u);
+	EXPECT_EQ(pool.get_free_count(), 3u);
+
+	for (int i = 0; i < 4; ++i)
+		pool.acquire();
+	EXPECT_EQ(pool.get_allocated_count(), 8u);
+	EXPECT_EQ(pool.get_free_count(), 3u);
+}
+
+TEST(object_pool, release_resets_in_place) {
+	putils::reflection::object_pool<request> pool(1);
+
+	const auto obj = pool.acquire();
+	obj->id = 42;
+	obj->retries = 0;
+	obj->timeout = 0;
+	obj->body = std::string(1000, 'a');
+	obj->values.assign(1000, 1);
+	obj->defaults.clear();
+	obj->head.status = 404;
+	obj->head.content_type = "application/json";
+
+	const auto body_capacity = obj->body.capacity();
+	const auto values_data = obj->values.data();
+	pool.release(obj);
+
+	const auto recycled = pool.acquire();
+	EXPECT_EQ(recycled, obj);
+	EXPECT_EQ(pool.get_allocated_count(), 1u);
+
+	EXPECT_EQ(recycled->id, 0);
+	EXPECT_EQ(recycled->retries, 3);
+	EXPECT_EQ(recycled->timeout, 1.5f);
+	EXPECT_TRUE(recycled->body.empty());
+	EXPECT_TRUE(recycled->values.empty());
+	EXPECT_EQ(recycled->defaults, (std::vector<int>{ 1, 2 }));
+	EXPECT_EQ(recycled->head.status, 200);
+	EXPECT_EQ(recycled->head.content_type, "text/plain");
+
+	// Buffers are kept
+	EXPECT_EQ(recycled->body.capacity(), body_capacity);
+	EXPECT_EQ(recycled->values.data(), values_data);
+}
+
+TEST(object_pool, reserve) {
+	putils::reflection::object_pool<request> pool;
+	pool.reserve(10);
+	EXPECT_EQ(pool.get_allocated_count(), 10u);
+	EXPECT_EQ(pool.get_free_count(), 10u);
+	pool.reserve(5);
+	EXPECT_EQ(pool.get_allocated_count(), 10u);
+}
+
+TEST(object_pool, move_only_attributes) {
+	putils::reflection::object_pool<connection> pool(1);
+
+	const auto obj = pool.acquire();
+	obj->port = 443;
+	obj->buffer = std::make_unique<std::string>("data");
+	obj->pending.push_back(std::make_unique<int>(1));
+	const auto pending_capacity = obj->pending.capacity();
+	pool.release(obj);
+
+	const auto recycled = pool.acquire();
+	EXPECT_EQ(recycled, obj);
+	EXPECT_EQ(recycled->port, 80);
+	EXPECT_EQ(recycled->buffer, nullptr);
+	EXPECT_TRUE(recycled->pending.empty());
+	EXPECT_EQ(recycled->pending.capacity(), pending_capacity);
+}
@@ -1,5 +1,9 @@
 // stl
+#include <optional>
+#include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 // gtest
 #include <gtest/gtest.h>
@@ -204,6 +208,47 @@ TEST(reflection, for_each_attribute_references) {
 	SUCCEED();
 }
 
+TEST(reflection, for_each_attribute_zip) {
+	const auto test = []() consteval {
+		const reflectible a;
+		const reflectible b;
+		const reflectible c;
+		int ret = 0;
+		putils::reflection::for_each_attribute_zip(a, b, c, [&](const auto & attr, const auto & ma, const auto & mb, const auto & mc) {
+			if (&ma == &(a.*attr.ptr) && &mb == &(b.*attr.ptr) && &mc == &(c.*attr.ptr))
+				++ret;
+		});
+		return ret;
+	};
+	static_assert(test() == 6);
+	SUCCEED();
+}
+
+TEST(reflection, for_each_attribute_zip_copy) {
+	reflectible src;
+	src.i = 1;
+	src.iparent = 2;
+	reflectible dst;
+	putils::reflection::for_each_attribute_zip(dst, std::as_const(src), [](const auto &, auto & d, const auto & s) {
+		if constexpr (!std::is_const_v<std::remove_reference_t<decltype(d)>>)
+			d = s;
+	});
+	EXPECT_EQ(dst.i, 1);
+	EXPECT_EQ(dst.iparent, 2);
+}
+
+TEST(reflection, for_each_attribute_zip_early_return) {
+	reflectible a;
+	reflectible b;
+	b.i = 0;
+	const auto first_diff = putils::reflection::for_each_attribute_zip(a, b, [](const auto & attr, const auto & ma, const auto & mb) -> std::optional<std::string_view> {
+		if (ma != mb)
+			return attr.name;
+		return std::nullopt;
+	});
+	EXPECT_EQ(first_diff, "i");
+}
+
 TEST(reflection, has_attribute) {
 	static_assert(putils::reflection::has_attribute<parent>("iparent"));
 	static_assert(putils::reflection::has_attribute<reflectible>("iparent"));
@@ -279,6 +324,47 @@ TEST(reflection, get_attribute_reference_missing) {
 	static_assert(attr == nullptr);
 }
 
+TEST(reflection, visit_attribute) {
+	constexpr auto get_name = [](std::size_t index) {
+		std::string_view ret;
+		putils::reflection::visit_attribute<reflectible>(index, [&](const auto & attr) {
+			ret = attr.name;
+		});
+		return ret;
+	};
+	static_assert(get_name(0) == "i");
+	static_assert(get_name(3) == "cs");
+	static_assert(get_name(5) == "ciparent");
+	static_assert(!putils::reflection::visit_attribute<reflectible>(6, [](const auto &) {}));
+
+	reflectible obj;
+	for (std::size_t i = 0; i < 6; ++i) {
+		const void * visited = nullptr;
+		EXPECT_TRUE(putils::reflection::visit_attribute(obj, i, [&](const auto & attr) {
+			visited = &attr.member;
+		}));
+		EXPECT_EQ(visited, putils::reflection::for_each_attribute(obj, [&, j = std::size_t(0)](const auto & attr) mutable -> std::optional<const void *> {
+			if (j++ == i)
+				return &attr.member;
+			return std::nullopt;
+		}));
+	}
+	EXPECT_FALSE(putils::reflection::visit_attribute(obj, 6, [](const auto &) {}));
+}
+
+TEST(reflection, get_attribute_by_index) {
+	static constexpr reflectible obj;
+	static_assert(putils::reflection::get_attribute_by_index<int>(obj, 0) == &obj.i);
+	static_assert(putils::reflection::get_attribute_by_index<const int>(obj, 1) == &obj.ci);
+	static_assert(putils::reflection::get_attribute_by_index<int>(obj, 4) == &obj.iparent);
+	static_assert(putils::reflection::get_attribute_by_index<int>(obj, 1) == nullptr);
+	static_assert(putils::reflection::get_attribute_by_index<int>(obj, 6) == nullptr);
+
+	reflectible obj2;
+	*putils::reflection::get_attribute_by_index<int>(obj2, 4) = -1;
+	EXPECT_EQ(obj2.iparent, -1);
+}
+
 /*
  * Methods
  */
@@ -520,6 +606,90 @@ TEST(reflection, has_parent) {
 	static_assert(!putils::reflection::has_parent<parent, parent>());
 }
 
+namespace {
+	struct diamond_base {
+		int base = 0;
+	};
+
+	struct diamond_left : virtual diamond_base {
+		int left = 1;
+	};
+
+	struct diamond_right : virtual diamond_base {
+		int right = 2;
+	};
+
+	struct diamond : diamond_left, diamond_right {
+		int bottom = 3;
+	};
+}
+
+#define refltype diamond_base
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(base)
+	);
+};
+#undef refltype
+
+#define refltype diamond_left
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(left)
+	);
+	putils_reflection_parents(
+		putils_reflection_type(diamond_base)
+	);
+};
+#undef refltype
+
+#define refltype diamond_right
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(right)
+	);
+	putils_reflection_parents(
+		putils_reflection_type(diamond_base)
+	);
+};
+#undef refltype
+
+#define refltype diamond
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(bottom)
+	);
+	putils_reflection_parents(
+		putils_reflection_type(diamond_left),
+		putils_reflection_type(diamond_right)
+	);
+};
+#undef refltype
+
+TEST(reflection, diamond_parents) {
+	constexpr auto & parents = putils::reflection::get_parents<diamond>();
+	static_assert(std::tuple_size<putils_typeof(parents)>() == 3);
+	static_assert(std::is_same_v<putils_wrapped_type(std::get<0>(parents).type), diamond_left>);
+	static_assert(std::is_same_v<putils_wrapped_type(std::get<1>(parents).type), diamond_right>);
+	static_assert(std::is_same_v<putils_wrapped_type(std::get<2>(parents).type), diamond_base>);
+	static_assert(putils::reflection::has_parent<diamond, diamond_base>());
+}
+
+TEST(reflection, diamond_attributes) {
+	constexpr auto & attributes = putils::reflection::get_attributes<diamond>();
+	static_assert(std::tuple_size<putils_typeof(attributes)>() == 4);
+
+	diamond obj;
+	std::vector<std::string_view> names;
+	int sum = 0;
+	putils::reflection::for_each_attribute(obj, [&](const auto & attr) {
+		names.push_back(attr.name);
+		sum += attr.member;
+	});
+	EXPECT_EQ(names, (std::vector<std::string_view>{ "bottom", "left", "right", "base" }));
+	EXPECT_EQ(sum, 6);
+}
+
 /*
  * Used types
  */
@@ -620,3 +790,229 @@ TEST(reflection, get_method_metadata) {
 	static_assert(putils::reflection::get_method_metadata<const char *, reflectible>("fparent", "bad_key") == nullptr);
 	static_assert(putils::reflection::get_method_metadata<const char *, reflectible>("f", "meta_key") == nullptr);
 }
+
+namespace {
+	struct with_key_metadata {
+		float x = 0;
+		float y = 0;
+		int id = 0;
+
+		void update() noexcept {}
+	};
+}
+
+#define refltype with_key_metadata
+putils_reflection_info {
+	putils_reflection_type_metadata(
+		putils_reflection_metadata("category", "physics")
+	);
+	putils_reflection_attributes(
+		putils_reflection_attribute(x, putils_reflection_metadata("editor_range", 10.f), putils_reflection_metadata("net_priority", 1)),
+		putils_reflection_attribute(y, putils_reflection_metadata("net_priority", 2)),
+		putils_reflection_attribute(id)
+	);
+	putils_reflection_methods(
+		putils_reflection_attribute(update, putils_reflection_metadata("net_priority", 3))
+	);
+};
+#undef refltype
+
+TEST(reflection, has_metadata_key) {
+	static_assert(putils::reflection::has_metadata<with_key_metadata, "category">());
+	static_assert(!putils::reflection::has_metadata<with_key_metadata, "bad_key">());
+	SUCCEED();
+}
+
+TEST(reflection, get_metadata_key) {
+	static_assert(*putils::reflection::get_metadata<const char *, with_key_metadata, "category">() == std::string_view("physics"));
+	static_assert(putils::reflection::get_metadata<const char *, with_key_metadata, "bad_key">() == nullptr);
+	SUCCEED();
+}
+
+TEST(reflection, has_attribute_metadata_key) {
+	static_assert(putils::reflection::has_attribute_metadata<reflectible, "meta_key">("iparent"));
+	static_assert(!putils::reflection::has_attribute_metadata<reflectible, "bad_key">("iparent"));
+	static_assert(!putils::reflection::has_attribute_metadata<reflectible, "meta_key">("i"));
+	static_assert(!putils::reflection::has_attribute_metadata<reflectible, "meta_key">("unknown"));
+	SUCCEED();
+}
+
+TEST(reflection, get_attribute_metadata_key) {
+	static_assert(*putils::reflection::get_attribute_metadata<float, with_key_metadata, "editor_range">("x") == 10.f);
+	static_assert(putils::reflection::get_attribute_metadata<float, with_key_metadata, "editor_range">("y") == nullptr);
+	static_assert(putils::reflection::get_attribute_metadata<int, with_key_metadata, "editor_range">("x") == nullptr);
+	static_assert(*putils::reflection::get_attribute_metadata<const char *, reflectible, "meta_key">("iparent") == std::string_view("meta_value"));
+
+	// Runtime names
+	for (const auto name : { "x", "y", "id", "unknown" }) {
+		const auto expected = putils::reflection::get_attribute_metadata<int, with_key_metadata>(name, "net_priority");
+		EXPECT_EQ((putils::reflection::get_attribute_metadata<int, with_key_metadata, "net_priority">(name)), expected);
+	}
+}
+
+TEST(reflection, get_method_metadata_key) {
+	static_assert(putils::reflection::has_method_metadata<with_key_metadata, "net_priority">("update"));
+	static_assert(*putils::reflection::get_method_metadata<int, with_key_metadata, "net_priority">("update") == 3);
+	static_assert(*putils::reflection::get_method_metadata<const char *, reflectible, "meta_key">("fparent") == std::string_view("meta_value"));
+	static_assert(putils::reflection::get_method_metadata<const char *, reflectible, "meta_key">("f") == nullptr);
+	SUCCEED();
+}
+
+TEST(reflection, get_attributes_with_metadata) {
+	constexpr auto & indices = putils::reflection::get_attributes_with_metadata<with_key_metadata, "net_priority">();
+	static_assert(indices.size() == 2);
+	static_assert(indices[0] == 0 && indices[1] == 1);
+	static_assert(putils::reflection::get_attributes_with_metadata<with_key_metadata, "bad_key">().empty());
+	SUCCEED();
+}
+
+TEST(reflection, for_each_attribute_with_metadata) {
+	std::vector<std::string_view> names;
+	putils::reflection::for_each_attribute_with_metadata<with_key_metadata, "net_priority">([&](const auto & attr) {
+		names.push_back(attr.name);
+	});
+	EXPECT_EQ(names, (std::vector<std::string_view>{ "x", "y" }));
+}
+
+/*
+ * Enums
+ */
+
+namespace {
+	enum class color {
+		red,
+		green,
+		blue,
+		crimson = red,
+	};
+
+	enum sparse : std::int64_t {
+		negative = -1000,
+		zero = 0,
+		big = 1ll << 40,
+	};
+
+	enum class empty_enum {};
+
+	enum class large_enum {
+		v0, v1, v2, v3, v4, v5, v6, v7, v8, v9,
+		v10, v11, v12, v13, v14, v15, v16, v17, v18, v19,
+		v20, v21, v22, v23, v24, v25, v26, v27, v28, v29,
+		v30, v31, v32, v33, v34, v35, v36, v37, v38, v39,
+	};
+
+	// Same length, first, middle and last characters
+	enum class equipment_slot {
+		head_slot,
+		hand_slot,
+		feet_slot,
+	};
+}
+
+#define refltype color
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_values(
+		putils_reflection_value(red),
+		putils_reflection_value(green, putils_reflection_metadata("key", "value")),
+		putils_reflection_value(blue),
+		putils_reflection_value(crimson)
+	);
+};
+#undef refltype
+
+#define refltype sparse
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(negative),
+		putils_reflection_value(zero),
+		putils_reflection_value(big)
+	);
+};
+#undef refltype
+
+#define refltype empty_enum
+putils_reflection_info {
+	putils_reflection_values();
+};
+#undef refltype
+
+#define refltype large_enum
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(v0), putils_reflection_value(v1), putils_reflection_value(v2), putils_reflection_value(v3), putils_reflection_value(v4),
+		putils_reflection_value(v5), putils_reflection_value(v6), putils_reflection_value(v7), putils_reflection_value(v8), putils_reflection_value(v9),
+		putils_reflection_value(v10), putils_reflection_value(v11), putils_reflection_value(v12), putils_reflection_value(v13), putils_reflection_value(v14),
+		putils_reflection_value(v15), putils_reflection_value(v16), putils_reflection_value(v17), putils_reflection_value(v18), putils_reflection_value(v19),
+		putils_reflection_value(v20), putils_reflection_value(v21), putils_reflection_value(v22), putils_reflection_value(v23), putils_reflection_value(v24),
+		putils_reflection_value(v25), putils_reflection_value(v26), putils_reflection_value(v27), putils_reflection_value(v28), putils_reflection_value(v29),
+		putils_reflection_value(v30), putils_reflection_value(v31), putils_reflection_value(v32), putils_reflection_value(v33), putils_reflection_value(v34),
+		putils_reflection_value(v35), putils_reflection_value(v36), putils_reflection_value(v37), putils_reflection_value(v38), putils_reflection_value(v39)
+	);
+};
+#undef refltype
+
+#define refltype equipment_slot
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(head_slot),
+		putils_reflection_value(hand_slot),
+		putils_reflection_value(feet_slot)
+	);
+};
+#undef refltype
+
+TEST(reflection, has_values) {
+	static_assert(putils::reflection::has_values<color>());
+	static_assert(!putils::reflection::has_values<reflectible>());
+	static_assert(putils::reflection::get_class_name<color>() == std::string_view("color"));
+	SUCCEED();
+}
+
+TEST(reflection, for_each_value) {
+	constexpr auto count = [] {
+		int ret = 0;
+		putils::reflection::for_each_value<color>([&](const auto &) {
+			++ret;
+		});
+		return ret;
+	}();
+	static_assert(count == 4);
+	static_assert(*putils::reflection::get_metadata<const char *>(std::get<1>(putils::reflection::get_values<color>()).metadata, "key") == std::string_view("value"));
+	SUCCEED();
+}
+
+TEST(reflection, enum_to_string) {
+	static_assert(putils::reflection::enum_to_string(color::red) == "red");
+	static_assert(putils::reflection::enum_to_string(color::blue) == "blue");
+	static_assert(putils::reflection::enum_to_string(color(42)) == "");
+	static_assert(putils::reflection::enum_to_string(color(-1)) == "");
+
+	static_assert(putils::reflection::enum_to_string(negative) == "negative");
+	static_assert(putils::reflection::enum_to_string(big) == "big");
+	static_assert(putils::reflection::enum_to_string(sparse(1)) == "");
+
+	static_assert(putils::reflection::enum_to_string(empty_enum()) == "");
+	static_assert(putils::reflection::enum_to_string(large_enum::v39) == "v39");
+
+	volatile int runtime_value = 2;
+	EXPECT_EQ(putils::reflection::enum_to_string(color(runtime_value)), "blue");
+}
+
+TEST(reflection, enum_from_string) {
+	static_assert(putils::reflection::enum_from_string<color>("green") == color::green);
+	static_assert(putils::reflection::enum_from_string<color>("crimson") == color::red);
+	static_assert(putils::reflection::enum_from_string<color>("purple") == std::nullopt);
+	static_assert(putils::reflection::enum_from_string<color>("") == std::nullopt);
+	static_assert(putils::reflection::enum_from_string<sparse>("big") == big);
+	static_assert(putils::reflection::enum_from_string<empty_enum>("red") == std::nullopt);
+
+	for (int i = 0; i < 40; ++i)
+		EXPECT_EQ(putils::reflection::enum_from_string<large_enum>("v" + std::to_string(i)), large_enum(i));
+	EXPECT_EQ(putils::reflection::enum_from_string<large_enum>("v40"), std::nullopt);
+
+	static_assert(putils::reflection::enum_from_string<equipment_slot>("head_slot") == equipment_slot::head_slot);
+	static_assert(putils::reflection::enum_from_string<equipment_slot>("hand_slot") == equipment_slot::hand_slot);
+	static_assert(putils::reflection::enum_from_string<equipment_slot>("feet_slot") == equipment_slot::feet_slot);
+	static_assert(putils::reflection::enum_from_string<equipment_slot>("horn_slot") == std::nullopt);
+}
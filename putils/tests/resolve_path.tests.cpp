@@ -0,0 +1,128 @@
+// stl
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/resolve_path.hpp"
+
+namespace {
+	struct vec3 {
+		float x = 1;
+		float y = 2;
+		float z = 3;
+	};
+
+	struct transform_data {
+		vec3 position;
+		const vec3 scale;
+	};
+
+	struct named {
+		std::string name = "foo";
+	};
+
+	struct entity : named {
+		int id = 42;
+		transform_data transform;
+	};
+}
+
+#define refltype vec3
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y),
+		putils_reflection_attribute(z)
+	);
+};
+#undef refltype
+
+#define refltype transform_data
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(position),
+		putils_reflection_attribute(scale)
+	);
+};
+#undef refltype
+
+#define refltype named
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(name)
+	);
+};
+#undef refltype
+
+#define refltype entity
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(transform)
+	);
+	putils_reflection_parents(
+		putils_reflection_type(named)
+	);
+};
+#undef refltype
+
+TEST(resolve_path, get_attribute_paths) {
+	constexpr auto & paths = putils::reflection::get_attribute_paths<entity>();
+	static_assert(paths.size() == 11);
+	static_assert(paths[0].path == "id");
+	static_assert(paths[1].path == "transform");
+	static_assert(paths[2].path == "transform.position");
+	static_assert(paths[3].path == "transform.position.x");
+	static_assert(paths[7].path == "transform.scale.x");
+	static_assert(paths[7].is_const);
+	static_assert(paths[10].path == "name");
+	SUCCEED();
+}
+
+TEST(resolve_path, resolve_path) {
+	static_assert(putils::reflection::resolve_path<entity>("transform.position.y")->type == putils::reflection::get_type_id<float>());
+	static_assert(putils::reflection::resolve_path<entity>("transform.position.w") == nullptr);
+	static_assert(putils::reflection::resolve_path<entity>("transform.") == nullptr);
+	static_assert(putils::reflection::resolve_path<entity>("") == nullptr);
+	SUCCEED();
+}
+
+TEST(resolve_path, typed) {
+	entity e;
+	EXPECT_EQ(putils::reflection::resolve_path<int>(e, "id"), &e.id);
+	EXPECT_EQ(putils::reflection::resolve_path<float>(e, "transform.position.z"), &e.transform.position.z);
+	EXPECT_EQ(putils::reflection::resolve_path<vec3>(e, "transform.position"), &e.transform.position);
+	EXPECT_EQ(putils::reflection::resolve_path<std::string>(e, "name"), &e.name);
+
+	const std::string runtime_path = std::string("transform.") + "position.x";
+	*putils::reflection::resolve_path<float>(e, runtime_path) = 42;
+	EXPECT_EQ(e.transform.position.x, 42);
+}
+
+TEST(resolve_path, type_mismatch) {
+	entity e;
+	EXPECT_EQ(putils::reflection::resolve_path<double>(e, "transform.position.x"), nullptr);
+	EXPECT_EQ(putils::reflection::resolve_path<float>(e, "id"), nullptr);
+	EXPECT_EQ(putils::reflection::resolve_path<float>(e, "unknown"), nullptr);
+}
+
+TEST(resolve_path, const_attributes) {
+	entity e;
+	EXPECT_EQ(putils::reflection::resolve_path<float>(e, "transform.scale.y"), nullptr);
+	EXPECT_EQ(putils::reflection::resolve_path<const float>(e, "transform.scale.y"), &e.transform.scale.y);
+
+	const entity & const_e = e;
+	const float * x = putils::reflection::resolve_path<float>(const_e, "transform.position.x");
+	EXPECT_EQ(x, &e.transform.position.x);
+}
+
+TEST(resolve_path, type_erased) {
+	entity e;
+	const auto attr = putils::reflection::resolve_path<entity>("transform.position.y");
+	ASSERT_NE(attr, nullptr);
+	EXPECT_EQ(attr->get_address(e), &e.transform.position.y);
+	EXPECT_EQ(attr->get<float>(e), &e.transform.position.y);
+	EXPECT_EQ(attr->get<int>(e), nullptr);
+}
@@ -0,0 +1,267 @@
+// stl
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/rpc.hpp"
+
+namespace {
+	struct engine {
+		int counter = 0;
+
+		int add(int a, int b) noexcept { return a + b; }
+		void increment() noexcept { ++counter; }
+		std::string greet(const std::string & name) const noexcept { return "hello " + name; }
+		std::vector<int> range(int count) const noexcept {
+			std::vector<int> ret;
+			for (int i = 0; i < count; ++i)
+				ret.push_back(i);
+			return ret;
+		}
+		std::size_t count_names(const std::vector<std::string> & names) const noexcept { return names.size(); }
+		std::size_t length(std::string_view str) const noexcept { return str.size(); }
+		// Can't be called remotely
+		void fill(std::string & out) const noexcept { out = "filled"; }
+		std::size_t length_of(const char * str) const noexcept { return std::strlen(str); }
+	};
+
+	// Same service, with methods declared in a different order
+	struct engine_v2 {
+		int counter = 0;
+
+		void increment() noexcept { ++counter; }
+		int add(int a, int b) noexcept { return a + b; }
+	};
+
+	// Same method names, with different signatures
+	struct engine_v3 {
+		int counter = 0;
+
+		float add(float a, int b) noexcept { return a + float(b); }
+		void increment() noexcept { ++counter; }
+	};
+}
+
+#define refltype engine
+putils_reflection_info {
+	putils_reflection_methods(
+		putils_reflection_attribute(add),
+		putils_reflection_attribute(increment),
+		putils_reflection_attribute(greet),
+		putils_reflection_attribute(range),
+		putils_reflection_attribute(count_names),
+		putils_reflection_attribute(length),
+		putils_reflection_attribute(fill),
+		putils_reflection_attribute(length_of)
+	);
+};
+#undef refltype
+
+#define refltype engine_v2
+putils_reflection_info {
+	putils_reflection_methods(
+		putils_reflection_attribute(increment),
+		putils_reflection_attribute(add)
+	);
+};
+#undef refltype
+
+#define refltype engine_v3
+putils_reflection_info {
+	putils_reflection_methods(
+		putils_reflection_attribute(add),
+		putils_reflection_attribute(increment)
+	);
+};
+#undef refltype
+
+namespace {
+	template<typename Client, typename Server>
+	void handshake(Client & client, const Server & server) {
+		std::vector<char> reply;
+		server.handle_handshake(client.make_handshake(), reply);
+		ASSERT_TRUE(client.handle_handshake(reply));
+	}
+}
+
+TEST(rpc, batched_calls) {
+	engine service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+	handshake(client, server);
+
+	const auto add = client.call<&engine::add>(1, 2);
+	const auto increment = client.call<&engine::increment>();
+	const auto greet = client.call<&engine::greet>("world");
+	const auto range = client.call<&engine::range>(3);
+
+	std::vector<char> reply;
+	EXPECT_TRUE(server.handle_calls(client.flush(), reply));
+	EXPECT_EQ(service.counter, 1);
+
+	const auto results = putils::reflection::rpc_results::parse(reply);
+	ASSERT_TRUE(results);
+	ASSERT_EQ(results->size(), 4u);
+	EXPECT_EQ(results->get<int>(add), 3);
+	EXPECT_EQ(results->get_status(increment), putils::reflection::rpc_status::ok);
+	EXPECT_EQ(results->get<std::string>(greet), "hello world");
+	EXPECT_EQ(results->get<std::vector<int>>(range), (std::vector<int>{ 0, 1, 2 }));
+}
+
+TEST(rpc, call_by_name) {
+	engine service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+	handshake(client, server);
+
+	const auto add = client.call("add", 20, 22);
+	ASSERT_TRUE(add);
+	EXPECT_FALSE(client.call("add", std::string("not an int"), 1));
+	EXPECT_FALSE(client.call("unknown"));
+
+	std::vector<char> reply;
+	EXPECT_TRUE(server.handle_calls(client.flush(), reply));
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get<int>(*add), 42);
+}
+
+TEST(rpc, handshake_remaps_indices) {
+	engine_v2 service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+	handshake(client, server);
+
+	const auto add = client.call<&engine::add>(1, 2);
+	client.call<&engine::increment>();
+
+	std::vector<char> reply;
+	EXPECT_TRUE(server.handle_calls(client.flush(), reply));
+	EXPECT_EQ(service.counter, 1);
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get<int>(add), 3);
+}
+
+TEST(rpc, unknown_method_stops_batch) {
+	engine_v2 service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+	handshake(client, server);
+
+	const auto greet = client.call<&engine::greet>("world"); // Not known by engine_v2
+	const auto increment = client.call<&engine::increment>();
+
+	std::vector<char> reply;
+	EXPECT_FALSE(server.handle_calls(client.flush(), reply));
+	EXPECT_EQ(service.counter, 0);
+
+	const auto results = putils::reflection::rpc_results::parse(reply);
+	ASSERT_TRUE(results);
+	EXPECT_EQ(results->get_status(greet), putils::reflection::rpc_status::unknown_method);
+	EXPECT_EQ(results->get_status(increment), putils::reflection::rpc_status::not_executed);
+}
+
+TEST(rpc, invalid_arguments) {
+	engine service;
+	putils::reflection::rpc_server server(service);
+
+	std::vector<char> frame;
+	putils::reflection::to_binary(std::uint32_t(1), frame); // Call count
+	putils::reflection::to_binary(std::uint32_t(0), frame); // add
+	putils::reflection::to_binary(1, frame);				// Missing second argument
+
+	std::vector<char> reply;
+	EXPECT_FALSE(server.handle_calls(frame, reply));
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get_status(0), putils::reflection::rpc_status::invalid_arguments);
+}
+
+TEST(rpc, invalid_argument_size) {
+	engine service;
+	putils::reflection::rpc_server server(service);
+
+	std::vector<char> frame;
+	putils::reflection::to_binary(std::uint32_t(1), frame);			 // Call count
+	putils::reflection::to_binary(std::uint32_t(4), frame);			 // count_names
+	putils::reflection::to_binary(std::uint32_t(0xFFFFFFFF), frame); // Corrupted vector size
+
+	std::vector<char> reply;
+	EXPECT_FALSE(server.handle_calls(frame, reply));
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get_status(0), putils::reflection::rpc_status::invalid_arguments);
+}
+
+TEST(rpc, string_view_arguments) {
+	engine service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+	handshake(client, server);
+
+	const auto length = client.call<&engine::length>("hello");
+	std::vector<char> reply;
+	EXPECT_TRUE(server.handle_calls(client.flush(), reply));
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get<std::size_t>(length), 5u);
+}
+
+TEST(rpc, methods_not_callable_remotely) {
+	engine service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+	handshake(client, server);
+
+	std::string out;
+	EXPECT_FALSE(client.call("fill", out));
+	EXPECT_FALSE(client.call("length_of", "hello"));
+
+	// Calls sent anyway are rejected by the server
+	std::vector<char> frame;
+	putils::reflection::to_binary(std::uint32_t(1), frame); // Call count
+	putils::reflection::to_binary(std::uint32_t(6), frame); // fill
+	std::vector<char> reply;
+	EXPECT_FALSE(server.handle_calls(frame, reply));
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get_status(0), putils::reflection::rpc_status::unknown_method);
+}
+
+TEST(rpc, handshake_rejects_signature_mismatch) {
+	engine_v3 service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+	handshake(client, server);
+
+	const auto increment = client.call<&engine::increment>();
+	std::vector<char> reply;
+	EXPECT_TRUE(server.handle_calls(client.flush(), reply));
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get_status(increment), putils::reflection::rpc_status::ok);
+	EXPECT_EQ(service.counter, 1);
+
+	// add takes a float on the server, so the client's ints would be decoded as garbage
+	const auto add = client.call<&engine::add>(1, 2);
+	reply.clear();
+	EXPECT_FALSE(server.handle_calls(client.flush(), reply));
+	EXPECT_EQ(putils::reflection::rpc_results::parse(reply)->get_status(add), putils::reflection::rpc_status::unknown_method);
+}
+
+TEST(rpc, message_stream) {
+	engine service;
+	putils::reflection::rpc_server server(service);
+	putils::reflection::rpc_client<engine> client;
+
+	std::vector<char> stream;
+	client.call<&engine::add>(1, 2);
+	putils::reflection::write_rpc_message(client.flush(), stream);
+	client.call<&engine::add>(3, 4);
+	putils::reflection::write_rpc_message(client.flush(), stream);
+
+	// Feed the stream byte by byte, as if received in small chunks
+	putils::reflection::rpc_message_reader reader;
+	std::vector<int> sums;
+	for (const char c : stream) {
+		reader.append({ &c, 1 });
+		while (const auto message = reader.next_message()) {
+			std::vector<char> reply;
+			EXPECT_TRUE(server.handle_calls(*message, reply));
+			sums.push_back(*putils::reflection::rpc_results::parse(reply)->get<int>(0));
+		}
+	}
+	EXPECT_EQ(sums, (std::vector<int>{ 3, 7 }));
+}
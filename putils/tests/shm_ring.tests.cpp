@@ -0,0 +1,167 @@
+// stl
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/shm_ring.hpp"
+
+namespace {
+	struct telemetry {
+		std::uint64_t frame = 0;
+		double x = 0;
+		double y = 0;
+		std::uint64_t checksum = 0;
+	};
+
+	struct other_telemetry {
+		std::uint64_t frame = 0;
+		float x = 0;
+	};
+
+	telemetry make_telemetry(std::uint64_t frame) {
+		return { .frame = frame, .x = double(frame), .y = -double(frame), .checksum = frame * 3 };
+	}
+
+	struct ring_memory {
+		explicit ring_memory(std::size_t size)
+			: data(new (std::align_val_t(64)) unsigned char[size]) {}
+		~ring_memory() { operator delete[](data, std::align_val_t(64)); }
+		unsigned char * data;
+	};
+}
+
+#define refltype telemetry
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes(
+		putils_reflection_attribute(frame),
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y),
+		putils_reflection_attribute(checksum)
+	);
+};
+#undef refltype
+
+#define refltype other_telemetry
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes(
+		putils_reflection_attribute(frame),
+		putils_reflection_attribute(x)
+	);
+};
+#undef refltype
+
+TEST(shm_ring, schema_hash) {
+	static_assert(putils::reflection::get_schema_hash<telemetry>() == putils::reflection::get_schema_hash<telemetry>());
+	static_assert(putils::reflection::get_schema_hash<telemetry>() != putils::reflection::get_schema_hash<other_telemetry>());
+	SUCCEED();
+}
+
+TEST(shm_ring, publish_and_read) {
+	ring_memory memory(putils::reflection::get_shm_ring_size<telemetry>(8));
+	putils::reflection::shm_publisher<telemetry> publisher(memory.data, 8);
+
+	auto subscriber = putils::reflection::shm_subscriber<telemetry>::attach(memory.data);
+	ASSERT_TRUE(subscriber);
+
+	telemetry out;
+	EXPECT_FALSE(subscriber->try_read(out));
+
+	publisher.publish(make_telemetry(1));
+	publisher.publish(make_telemetry(2));
+
+	ASSERT_TRUE(subscriber->try_read(out));
+	EXPECT_EQ(out.frame, 1u);
+	ASSERT_TRUE(subscriber->try_read_in_place([](const telemetry & record) {
+		EXPECT_EQ(record.frame, 2u);
+	}));
+	EXPECT_FALSE(subscriber->try_read(out));
+	EXPECT_EQ(subscriber->get_dropped_count(), 0u);
+}
+
+TEST(shm_ring, schema_mismatch) {
+	ring_memory memory(putils::reflection::get_shm_ring_size<telemetry>(8));
+	putils::reflection::shm_publisher<telemetry> publisher(memory.data, 8);
+	EXPECT_FALSE(putils::reflection::shm_subscriber<other_telemetry>::attach(memory.data));
+}
+
+TEST(shm_ring, lapped_subscriber) {
+	ring_memory memory(putils::reflection::get_shm_ring_size<telemetry>(4));
+	putils::reflection::shm_publisher<telemetry> publisher(memory.data, 4);
+	auto subscriber = putils::reflection::shm_subscriber<telemetry>::attach(memory.data);
+	ASSERT_TRUE(subscriber);
+
+	for (std::uint64_t i = 0; i < 10; ++i)
+		publisher.publish(make_telemetry(i));
+
+	telemetry out;
+	ASSERT_TRUE(subscriber->try_read(out));
+	EXPECT_EQ(out.frame, 6u);
+	EXPECT_EQ(subscriber->get_dropped_count(), 6u);
+}
+
+TEST(shm_ring, concurrent_subscribers) {
+	static constexpr std::uint64_t record_count = 100000;
+	ring_memory memory(putils::reflection::get_shm_ring_size<telemetry>(1024));
+	putils::reflection::shm_publisher<telemetry> publisher(memory.data, 1024);
+
+	std::vector<std::thread> consumers;
+	for (int i = 0; i < 2; ++i) {
+		auto subscriber = putils::reflection::shm_subscriber<telemetry>::attach(memory.data);
+		ASSERT_TRUE(subscriber);
+		consumers.emplace_back([subscriber = std::move(*subscriber)]() mutable {
+			std::uint64_t last_frame = 0;
+			std::uint64_t read_count = 0;
+			telemetry out;
+			while (last_frame + 1 < record_count) {
+				if (!subscriber.try_read(out))
+					continue;
+				// Records are never torn and are read in order
+				EXPECT_EQ(out.checksum, out.frame * 3);
+				EXPECT_EQ(out.x, double(out.frame));
+				if (read_count > 0) {
+					EXPECT_GT(out.frame, last_frame);
+				}
+				last_frame = out.frame;
+				++read_count;
+			}
+			EXPECT_EQ(read_count + subscriber.get_dropped_count(), record_count);
+		});
+	}
+
+	for (std::uint64_t i = 0; i < record_count; ++i)
+		publisher.publish(make_telemetry(i));
+
+	for (auto & consumer : consumers)
+		consumer.join();
+}
+
+#ifndef _WIN32
+TEST(shm_ring, shared_memory) {
+	const std::string name = "/putils_reflection_shm_ring_test_" + std::to_string(getpid());
+
+	auto publisher = putils::reflection::shm_publisher<telemetry>::create(name.c_str(), 16);
+	ASSERT_TRUE(publisher);
+
+	auto subscriber = putils::reflection::shm_subscriber<telemetry>::open(name.c_str());
+	ASSERT_TRUE(subscriber);
+	EXPECT_FALSE(putils::reflection::shm_subscriber<other_telemetry>::open(name.c_str()));
+
+	publisher->publish(make_telemetry(42));
+
+	telemetry out;
+	ASSERT_TRUE(subscriber->try_read(out));
+	EXPECT_EQ(out.frame, 42u);
+	EXPECT_EQ(out.checksum, 126u);
+}
+
+TEST(shm_ring, shared_memory_missing) {
+	EXPECT_FALSE(putils::reflection::shm_subscriber<telemetry>::open("/putils_reflection_shm_ring_test_missing"));
+}
+#endif
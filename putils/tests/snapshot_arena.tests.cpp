@@ -0,0 +1,226 @@
+// stl
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/snapshot_arena.hpp"
+
+namespace {
+	struct vec2 {
+		float x = 0;
+		float y = 0;
+	};
+
+	struct inventory {
+		std::vector<std::string> items;
+		std::vector<bool> equipped;
+	};
+
+	struct component {
+		std::map<std::string, int> counters;
+		std::set<int> tags;
+		std::optional<std::string> target;
+		std::optional<vec2> destination;
+	};
+
+	struct player {
+		int id = 0;
+		int health = 100;
+		vec2 position;
+		const int version = 1;
+		std::string name;
+		std::vector<vec2> path;
+		inventory bag;
+	};
+}
+
+#define refltype vec2
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y)
+	);
+};
+#undef refltype
+
+#define refltype inventory
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(items),
+		putils_reflection_attribute(equipped)
+	);
+};
+#undef refltype
+
+#define refltype component
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(counters),
+		putils_reflection_attribute(tags),
+		putils_reflection_attribute(target),
+		putils_reflection_attribute(destination)
+	);
+};
+#undef refltype
+
+#define refltype player
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(id),
+		putils_reflection_attribute(health),
+		putils_reflection_attribute(position),
+		putils_reflection_attribute(version),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(path),
+		putils_reflection_attribute(bag)
+	);
+};
+#undef refltype
+
+namespace {
+	player make_player(int id) {
+		player ret;
+		ret.id = id;
+		ret.health = 50;
+		ret.position = { 1, 2 };
+		ret.name = "player " + std::to_string(id);
+		ret.path = { { 3, 4 }, { 5, 6 } };
+		ret.bag.items = { "sword", "shield" };
+		ret.bag.equipped = { true, false };
+		return ret;
+	}
+}
+
+TEST(snapshot_arena, save_restore) {
+	putils::reflection::snapshot_arena arena;
+	auto obj = make_player(1);
+	const auto snap = arena.save(obj);
+
+	obj.id = 2;
+	obj.health = 0;
+	obj.position = { 0, 0 };
+	obj.name = "modified";
+	obj.path.clear();
+	obj.bag.items.push_back("bow");
+	obj.bag.equipped.clear();
+
+	putils::reflection::snapshot_arena::restore(snap, obj);
+	const auto expected = make_player(1);
+	EXPECT_EQ(obj.id, expected.id);
+	EXPECT_EQ(obj.health, expected.health);
+	EXPECT_EQ(obj.position.y, expected.position.y);
+	EXPECT_EQ(obj.name, expected.name);
+	ASSERT_EQ(obj.path.size(), 2u);
+	EXPECT_EQ(obj.path[1].x, 5);
+	EXPECT_EQ(obj.bag.items, expected.bag.items);
+	EXPECT_EQ(obj.bag.equipped, expected.bag.equipped);
+}
+
+TEST(snapshot_arena, trivially_copyable) {
+	putils::reflection::snapshot_arena arena;
+	vec2 obj{ 1, 2 };
+	const auto snap = arena.save(obj);
+	EXPECT_EQ(arena.get_used_size(), sizeof(vec2));
+
+	obj = { 3, 4 };
+	putils::reflection::snapshot_arena::restore(snap, obj);
+	EXPECT_EQ(obj.x, 1);
+	EXPECT_EQ(obj.y, 2);
+}
+
+TEST(snapshot_arena, rewind) {
+	putils::reflection::snapshot_arena arena(256);
+	std::vector<player> players;
+	for (int i = 0; i < 10; ++i)
+		players.push_back(make_player(i));
+
+	const auto start = arena.get_marker();
+	for (int frame = 0; frame < 3; ++frame) {
+		const auto marker = arena.get_marker();
+		std::vector<putils::reflection::snapshot_arena::snapshot<player>> snapshots;
+		for (const auto & p : players)
+			snapshots.push_back(arena.save(p));
+		const auto used_size = arena.get_used_size();
+
+		for (auto & p : players)
+			p.name.clear();
+		for (std::size_t i = 0; i < players.size(); ++i)
+			putils::reflection::snapshot_arena::restore(snapshots[i], players[i]);
+		EXPECT_EQ(players[3].name, "player 3");
+
+		arena.rewind(marker);
+		EXPECT_EQ(arena.get_used_size(), 0u);
+		for (const auto & p : players)
+			arena.save(p);
+		EXPECT_EQ(arena.get_used_size(), used_size);
+		arena.rewind(start);
+	}
+}
+
+TEST(snapshot_arena, larger_than_block) {
+	putils::reflection::snapshot_arena arena(16);
+	auto obj = make_player(1);
+	obj.name = std::string(1000, 'a');
+	const auto snap = arena.save(obj);
+	obj.name.clear();
+	putils::reflection::snapshot_arena::restore(snap, obj);
+	EXPECT_EQ(obj.name.size(), 1000u);
+}
+
+TEST(snapshot_arena, maps_and_optionals) {
+	putils::reflection::snapshot_arena arena;
+	component obj;
+	obj.counters = { { "kills", 3 }, { "deaths", 1 } };
+	obj.tags = { 1, 2, 3 };
+	obj.target = "enemy";
+	const auto snap = arena.save(obj);
+
+	obj.counters["kills"] = 4;
+	obj.counters["assists"] = 2;
+	obj.tags.erase(2);
+	obj.target.reset();
+	obj.destination = vec2{ 1, 2 };
+
+	putils::reflection::snapshot_arena::restore(snap, obj);
+	EXPECT_EQ(obj.counters, (std::map<std::string, int>{ { "kills", 3 }, { "deaths", 1 } }));
+	EXPECT_EQ(obj.tags, (std::set<int>{ 1, 2, 3 }));
+	EXPECT_EQ(obj.target, "enemy");
+	EXPECT_FALSE(obj.destination);
+}
+
+TEST(snapshot_arena, rollback) {
+	putils::reflection::snapshot_arena arena;
+	std::vector<player> players;
+	for (int i = 0; i < 3; ++i)
+		players.push_back(make_player(i));
+
+	// Frame 0
+	std::vector<putils::reflection::snapshot_arena::snapshot<player>> frame;
+	for (const auto & p : players)
+		frame.push_back(arena.save(p));
+	const auto frame_size = arena.get_used_size();
+
+	// Frame 1, later found to be wrong
+	for (auto & p : players) {
+		p.health = 0;
+		arena.save(p);
+	}
+	EXPECT_EQ(arena.get_used_size(), 2 * frame_size);
+
+	arena.rollback(std::span<const putils::reflection::snapshot_arena::snapshot<player>>(frame), std::span<player>(players));
+	EXPECT_EQ(players[2].health, 50);
+	EXPECT_EQ(players[2].name, "player 2");
+	EXPECT_EQ(arena.get_used_size(), frame_size);
+
+	players[0].health = 1;
+	arena.rollback(frame[0], players[0]);
+	EXPECT_EQ(players[0].health, 50);
+	// Only frame 0's first snapshot is kept
+	EXPECT_EQ(arena.get_used_size(), frame_size / 3);
+}
@@ -0,0 +1,189 @@
+// stl
+#include <memory>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/to_chars.hpp"
+
+namespace {
+	struct position {
+		int x = 1;
+		int y = -2;
+	};
+
+	enum class state {
+		idle,
+		running,
+	};
+
+	struct log_entry {
+		position pos;
+		float speed = 0.5f;
+		bool active = true;
+		state current_state = state::running;
+		std::string name = "foo";
+		const char * tag = nullptr;
+		std::vector<int> values = { 1, 2 };
+	};
+
+	struct anonymous {
+		int i = 0;
+	};
+
+	struct empty {};
+
+	struct with_unique_ptr {
+		std::unique_ptr<int> value;
+	};
+
+	template<typename T>
+	concept has_to_string = requires(const T & obj) { putils::reflection::to_string(obj); };
+
+	enum class direction {
+		left,
+		right,
+	};
+
+	struct with_reflected_enum {
+		direction dir = direction::right;
+		direction invalid = direction(42);
+	};
+}
+
+#define refltype position
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y)
+	);
+};
+#undef refltype
+
+#define refltype direction
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(left),
+		putils_reflection_value(right)
+	);
+};
+#undef refltype
+
+#define refltype with_reflected_enum
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(dir),
+		putils_reflection_attribute(invalid)
+	);
+};
+#undef refltype
+
+#define refltype log_entry
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes(
+		putils_reflection_attribute(pos),
+		putils_reflection_attribute(speed),
+		putils_reflection_attribute(active),
+		putils_reflection_attribute(current_state),
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(tag),
+		putils_reflection_attribute(values)
+	);
+};
+#undef refltype
+
+#define refltype anonymous
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(i)
+	);
+};
+#undef refltype
+
+#define refltype with_unique_ptr
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(value)
+	);
+};
+#undef refltype
+
+#define refltype empty
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_attributes();
+};
+#undef refltype
+
+TEST(to_chars, to_chars) {
+	char buffer[256];
+	const position obj;
+	const auto result = putils::reflection::to_chars(buffer, buffer + sizeof(buffer), obj);
+	EXPECT_EQ(result.ec, std::errc());
+	EXPECT_EQ(std::string_view(buffer, result.ptr), "position{x: 1, y: -2}");
+}
+
+TEST(to_chars, to_chars_too_small) {
+	char buffer[8];
+	const position obj;
+	const auto result = putils::reflection::to_chars(buffer, buffer + sizeof(buffer), obj);
+	EXPECT_EQ(result.ec, std::errc::value_too_large);
+	EXPECT_EQ(result.ptr, buffer + sizeof(buffer));
+}
+
+TEST(to_chars, to_string) {
+	const log_entry obj;
+	EXPECT_EQ(
+		putils::reflection::to_string(obj),
+		"log_entry{pos: position{x: 1, y: -2}, speed: 0.5, active: true, current_state: 1, name: \"foo\", tag: null, values: [1, 2]}"
+	);
+}
+
+TEST(to_chars, formatted_size) {
+	const log_entry obj;
+	EXPECT_EQ(putils::reflection::formatted_size(obj), putils::reflection::to_string(obj).size());
+}
+
+TEST(to_chars, reflected_enum) {
+	EXPECT_EQ(putils::reflection::to_string(with_reflected_enum{}), "{dir: right, invalid: 42}");
+}
+
+TEST(to_chars, no_class_name) {
+	EXPECT_EQ(putils::reflection::to_string(anonymous{}), "{i: 0}");
+}
+
+TEST(to_chars, no_attributes) {
+	EXPECT_EQ(putils::reflection::to_string(empty{}), "empty{}");
+}
+
+TEST(to_chars, escaped_strings) {
+	log_entry obj;
+	obj.name = "a \"quoted\" \\ path\n\x01";
+	obj.tag = "tab\t";
+	const auto str = putils::reflection::to_string(obj);
+	EXPECT_NE(str.find(R"(name: "a \"quoted\" \\ path\n\001")"), std::string::npos) << str;
+	EXPECT_NE(str.find(R"(tag: "tab\t")"), std::string::npos) << str;
+	EXPECT_EQ(putils::reflection::formatted_size(obj), str.size());
+
+	char buffer[8];
+	const auto result = putils::reflection::to_chars(buffer, buffer + sizeof(buffer), '\'');
+	EXPECT_EQ(std::string_view(buffer, result.ptr), R"('\'')");
+}
+
+TEST(to_chars, writable) {
+	static_assert(putils::reflection::writable<log_entry>);
+	static_assert(putils::reflection::writable<std::vector<std::string>>);
+	static_assert(!putils::reflection::writable<std::unique_ptr<int>>);
+	static_assert(!putils::reflection::writable<with_unique_ptr>);
+
+	// to_string is only for reflectible objects
+	static_assert(has_to_string<log_entry>);
+	static_assert(!has_to_string<int>);
+	static_assert(!has_to_string<std::string>);
+	SUCCEED();
+}
@@ -0,0 +1,12 @@
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/type_id.hpp"
+
+TEST(type_id, unique) {
+	static_assert(putils::reflection::get_type_id<int>() == putils::reflection::get_type_id<int>());
+	static_assert(putils::reflection::get_type_id<int>() != putils::reflection::get_type_id<float>());
+	static_assert(putils::reflection::get_type_id<int>() != putils::reflection::get_type_id<const int>());
+	SUCCEED();
+}
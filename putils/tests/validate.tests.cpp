@@ -0,0 +1,95 @@
+// stl
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// reflection
+#include "putils/reflection_helpers/validate.hpp"
+
+namespace {
+	struct order {
+		int quantity = 1;
+		float price = 0;
+		std::string customer = "someone";
+		std::string comment;
+		std::vector<int> items = { 0 };
+		int unchecked = 0;
+	};
+}
+
+#define refltype order
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(quantity, putils_reflection_metadata("min", 1), putils_reflection_metadata("max", 100)),
+		putils_reflection_attribute(price, putils_reflection_metadata("min", 0.f)),
+		putils_reflection_attribute(customer, putils_reflection_metadata("non_empty", true), putils_reflection_metadata("max_length", 8)),
+		putils_reflection_attribute(comment, putils_reflection_metadata("max_length", std::size_t(4))),
+		putils_reflection_attribute(items, putils_reflection_metadata("non_empty", true)),
+		putils_reflection_attribute(unchecked)
+	);
+};
+#undef refltype
+
+using putils::reflection::validation_rule;
+
+TEST(validate, valid) {
+	std::vector<order> orders(10);
+
+	std::vector<putils::reflection::validation_error> errors;
+	EXPECT_TRUE(putils::reflection::validate(std::span<const order>(orders), errors));
+	EXPECT_TRUE(errors.empty());
+}
+
+TEST(validate, errors) {
+	std::vector<order> orders(4);
+	orders[0].quantity = 0;
+	orders[1].quantity = 101;
+	orders[1].price = -1.f;
+	orders[2].customer.clear();
+	orders[2].items.clear();
+	orders[3].customer = "a long customer name";
+	orders[3].comment = "hello";
+	orders[3].unchecked = -1000;
+
+	std::vector<putils::reflection::validation_error> errors;
+	EXPECT_FALSE(putils::reflection::validate(std::span<const order>(orders), errors));
+
+	const std::vector<std::pair<std::size_t, std::string_view>> expected_errors = {
+		{ 0, "quantity" },
+		{ 1, "quantity" },
+		{ 1, "price" },
+		{ 2, "customer" },
+		{ 3, "customer" },
+		{ 3, "comment" },
+		{ 2, "items" },
+	};
+	const std::vector<validation_rule> expected_rules = {
+		validation_rule::below_min,
+		validation_rule::above_max,
+		validation_rule::below_min,
+		validation_rule::empty,
+		validation_rule::too_long,
+		validation_rule::too_long,
+		validation_rule::empty,
+	};
+
+	ASSERT_EQ(errors.size(), expected_errors.size());
+	for (std::size_t i = 0; i < errors.size(); ++i) {
+		EXPECT_EQ(errors[i].index, expected_errors[i].first);
+		EXPECT_EQ(errors[i].attribute, expected_errors[i].second);
+		EXPECT_EQ(errors[i].rule, expected_rules[i]);
+	}
+}
+
+TEST(validate, single_object) {
+	order obj;
+	obj.quantity = 1000;
+
+	std::vector<putils::reflection::validation_error> errors;
+	EXPECT_FALSE(putils::reflection::validate(obj, errors));
+	ASSERT_EQ(errors.size(), 1u);
+	EXPECT_EQ(errors[0].attribute, "quantity");
+	EXPECT_EQ(putils::reflection::enum_to_string(errors[0].rule), "above_max");
+}
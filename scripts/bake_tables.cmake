@@ -0,0 +1,34 @@
+function(putils_bake_table)
+    set(options)
+    set(oneValueArgs TARGET DATA TYPE NAME OUTPUT)
+    set(multiValueArgs INCLUDES)
+    cmake_parse_arguments(ARGUMENTS "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    foreach(arg_name TARGET DATA TYPE NAME OUTPUT)
+        if(NOT ARGUMENTS_${arg_name})
+            message(FATAL_ERROR "Missing ${arg_name} argument to putils_bake_table")
+        endif()
+    endforeach()
+
+    set(python_script ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/bake_tables.py)
+    set(command python ${python_script} ${ARGUMENTS_DATA} --type ${ARGUMENTS_TYPE} --name ${ARGUMENTS_NAME} --output ${ARGUMENTS_OUTPUT})
+    if (ARGUMENTS_INCLUDES)
+        list(APPEND command --include ${ARGUMENTS_INCLUDES})
+    endif()
+
+    add_custom_command(
+            OUTPUT ${ARGUMENTS_OUTPUT}
+            COMMENT "Baking ${ARGUMENTS_DATA} into ${ARGUMENTS_OUTPUT}"
+            COMMAND ${command}
+            DEPENDS ${ARGUMENTS_DATA} ${python_script}
+    )
+
+    # Create a new target generating the header, and depended upon by `ARGUMENTS_TARGET`
+    set(bake_target ${ARGUMENTS_TARGET}_bake_${ARGUMENTS_NAME})
+    add_custom_target(
+            ${bake_target}
+            COMMENT "Baked ${ARGUMENTS_NAME} for ${ARGUMENTS_TARGET}"
+            DEPENDS ${ARGUMENTS_OUTPUT}
+    )
+    add_dependencies(${ARGUMENTS_TARGET} ${bake_target})
+endfunction()
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+
+import argparse
+import csv
+import json
+import math
+import os
+import re
+
+parser = argparse.ArgumentParser(description = 'Generate headers holding constexpr tables of reflectible objects from data files')
+parser.add_argument('data', help = 'input data file (.json or .csv)')
+parser.add_argument('--type', help = 'fully qualified type of the objects', required = True)
+parser.add_argument('--name', help = 'name of the generated table', required = True)
+parser.add_argument('--include', help = 'headers to include in the generated file, e.g. the one declaring TYPE', nargs = '*', default = [])
+parser.add_argument('--output', help = 'output header (defaults to the data file with a .baked.hpp extension)', required = False)
+
+args = parser.parse_args()
+
+identifier = re.compile(r'^[A-Za-z_]\w*$')
+index = re.compile(r'^\d+$')
+
+# Objects are flattened to a list of (path, text, number), where path is a list of attribute names and array indices
+# `text` is the value as written in the data file, and `number` its value if it's a number or a boolean (None otherwise)
+# Which one is used is decided by the C++ type of the attribute, see putils::reflection::bake_attribute
+
+def check_path(path):
+	for key in path:
+		if not identifier.match(key) and not index.match(key):
+			raise ValueError(f'invalid attribute path "{".".join(path)}"')
+
+def flatten(value, path, out):
+	if value is None:
+		return
+	if isinstance(value, dict):
+		for key, child in value.items():
+			if not identifier.match(key):
+				raise ValueError(f'invalid attribute name "{key}"')
+			flatten(child, path + [key], out)
+	elif isinstance(value, list):
+		for i, child in enumerate(value):
+			flatten(child, path + [str(i)], out)
+	elif isinstance(value, bool):
+		out.append((path, 'true' if value else 'false', value))
+	elif isinstance(value, (int, float)):
+		if isinstance(value, float) and not math.isfinite(value):
+			raise ValueError(f'{".".join(path)}: non-finite numbers can\'t be baked')
+		out.append((path, repr(value), value))
+	else:
+		out.append((path, str(value), None))
+
+def load_json(file_name):
+	with open(file_name, encoding = 'utf-8') as f:
+		objects = json.load(f)
+	if not isinstance(objects, list):
+		raise ValueError('JSON data should be an array of objects')
+
+	ret = []
+	for obj in objects:
+		values = []
+		flatten(obj, [], values)
+		ret.append(values)
+	return ret
+
+# CSV data has a header row with the attribute paths, e.g. "position.x" or "tags.0" for nested attributes and array elements
+# Cells are kept as text, along with their value if they look like a number or a boolean, since only the C++ type knows which to use
+def load_csv(file_name):
+	def parse_number(cell):
+		if cell in ['true', 'false']:
+			return cell == 'true'
+		try:
+			return int(cell)
+		except ValueError:
+			pass
+		try:
+			value = float(cell)
+			return value if math.isfinite(value) else None
+		except ValueError:
+			return None
+
+	objects = []
+	with open(file_name, encoding = 'utf-8', newline = '') as f:
+		reader = csv.reader(f)
+		header = [column.strip().split('.') for column in next(reader, [])]
+		for path in header:
+			check_path(path)
+		for row in reader:
+			values = []
+			for path, cell in zip(header, row):
+				# Empty cells are left to their default value
+				if cell != '':
+					values.append((path, cell, parse_number(cell)))
+			objects.append(values)
+	return objects
+
+def cpp_string(value):
+	result = '"'
+	for c in value:
+		if c in '"\\':
+			result += '\\' + c
+		elif ord(c) < 0x20 or ord(c) == 0x7f:
+			result += f'\\{ord(c):03o}'
+		else:
+			result += c
+	return result + '"'
+
+def cpp_number(value):
+	if isinstance(value, bool):
+		return 'true' if value else 'false'
+	return repr(value)
+
+def generate_assignment(target, path, text, number):
+	arguments = [target, cpp_string('.'.join(path)), cpp_string(text)]
+	if number is not None:
+		arguments.append(cpp_number(number))
+	return f'\tputils::reflection::bake_attribute({", ".join(arguments)});\n'
+
+def generate_table(objects):
+	result = '#pragma once\n\n'
+	result += f'// Generated by bake_tables.py from {os.path.basename(args.data)}, do not edit\n\n'
+	result += '#include <array>\n'
+	result += '#include "putils/reflection_helpers/bake.hpp"\n'
+	for header in args.include:
+		result += f'#include "{header}"\n'
+
+	result += f'\ninline constexpr auto {args.name} = [] {{\n'
+	result += f'\tstd::array<{args.type}, {len(objects)}> ret{{}};\n'
+	for i, values in enumerate(objects):
+		for path, text, number in values:
+			result += generate_assignment(f'ret[{i}]', path, text, number)
+	result += '\treturn ret;\n'
+	result += '}();\n'
+
+	# Only reflected attributes may be baked, as for the other data loaders. bake_attribute also fails for unknown paths,
+	# but these give a readable error
+	paths = []
+	for values in objects:
+		for path, text, number in values:
+			dotted = '.'.join(path)
+			if dotted not in paths:
+				paths.append(dotted)
+	if paths:
+		result += '\n'
+	for path in paths:
+		result += f'static_assert(putils::reflection::has_attribute_path<{args.type}>("{path}"), "{path} is not a reflected attribute of {args.type}");\n'
+	return result
+
+#
+# Main
+#
+
+extension = os.path.splitext(args.data)[1]
+if extension == '.json':
+	objects = load_json(args.data)
+elif extension == '.csv':
+	objects = load_csv(args.data)
+else:
+	parser.error(f'unsupported data file extension "{extension}"')
+
+output_file = args.output or os.path.splitext(args.data)[0] + '.baked.hpp'
+with open(output_file, 'w', encoding = 'utf-8') as f:
+	f.write(generate_table(objects))
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+
+# Compare the build time of a synthetic project of many reflected types, consuming the library either through
+# `#include "putils/reflection.hpp"` or through `import putils.reflection;`
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+parser = argparse.ArgumentParser(description = 'Benchmark header vs module consumption of putils reflection')
+parser.add_argument('--types', help = 'number of reflected types (one translation unit each)', type = int, default = 200)
+parser.add_argument('--attributes', help = 'number of attributes per type', type = int, default = 8)
+parser.add_argument('--cxx', help = 'C++ compiler', default = 'g++')
+parser.add_argument('--compiler-kind', help = 'how to build and import the module', choices = ['gcc', 'clang'], default = None)
+parser.add_argument('--include', help = 'extra include directory (e.g. for putils/meta)', action = 'append', default = [])
+parser.add_argument('--flags', help = 'extra compiler flags', default = '')
+parser.add_argument('--jobs', help = 'number of translation units compiled in parallel', type = int, default = 1)
+parser.add_argument('--keep', help = 'generate the project in this directory and keep it', default = None)
+
+args = parser.parse_args()
+
+repo_root = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+compiler_kind = args.compiler_kind or ('clang' if 'clang' in os.path.basename(args.cxx) else 'gcc')
+
+def generate_type(index):
+	header = '#pragma once\n\n#include <string>\n\n'
+	header += f'struct type_{index} {{\n'
+	for attr in range(args.attributes):
+		attr_type = 'std::string' if attr % 4 == 3 else ['int', 'float', 'double'][attr % 3]
+		header += f'\t{attr_type} attr_{attr}{{}};\n'
+	header += '\tint get() const noexcept { return attr_0; }\n};\n'
+	return header
+
+# Same layout as generate_reflection_headers's output
+def generate_reflection_header(index, module):
+	# Headers come before the import, as some compilers can't merge declarations included after it with the module's
+	result = f'#pragma once\n\n#include "type_{index}.hpp"\n'
+	if module:
+		result += '#include "putils/reflection_macros.hpp"\nimport putils.reflection;\n'
+	else:
+		result += '#include "putils/reflection.hpp"\n'
+	result += f'\n#define refltype type_{index}\nputils_reflection_info {{\n'
+	result += '\tputils_reflection_class_name;\n\tputils_reflection_attributes(\n'
+	result += ',\n'.join(f'\t\tputils_reflection_attribute(attr_{attr})' for attr in range(args.attributes))
+	result += '\n\t);\n\tputils_reflection_methods(\n\t\tputils_reflection_attribute(get)\n\t);\n};\n#undef refltype\n'
+	return result
+
+def generate_source(index):
+	source = f'#include "type_{index}.rpp"\n\n'
+	source += f'int use_type_{index}(type_{index} & obj) {{\n'
+	source += '\tint count = 0;\n'
+	source += '\tputils::reflection::for_each_attribute(obj, [&](const auto &) { ++count; });\n'
+	source += '\tif (const auto attr = putils::reflection::get_attribute<int>(obj, "attr_0"))\n\t\tcount += *attr;\n'
+	source += '\treturn count;\n}\n'
+	return source
+
+def generate_project(directory, module):
+	os.makedirs(directory, exist_ok = True)
+	sources = []
+	for index in range(args.types):
+		with open(os.path.join(directory, f'type_{index}.hpp'), 'w') as f:
+			f.write(generate_type(index))
+		with open(os.path.join(directory, f'type_{index}.rpp'), 'w') as f:
+			f.write(generate_reflection_header(index, module))
+		source = os.path.join(directory, f'use_type_{index}.cpp')
+		with open(source, 'w') as f:
+			f.write(generate_source(index))
+		sources.append(source)
+	return sources
+
+def compile(command, directory):
+	result = subprocess.run(command, cwd = directory, capture_output = True, text = True)
+	if result.returncode != 0:
+		raise RuntimeError(f'{" ".join(command)}\n{result.stderr[-2000:]}')
+
+def base_command(directory):
+	command = [args.cxx, '-std=c++20', f'-I{repo_root}', f'-I{directory}']
+	command += [f'-I{include}' for include in args.include]
+	command += args.flags.split()
+	return command
+
+def build(directory, sources, module_flags):
+	start = time.perf_counter()
+	with ThreadPoolExecutor(max_workers = args.jobs) as executor:
+		commands = [base_command(directory) + module_flags + ['-c', source, '-o', source + '.o'] for source in sources]
+		list(executor.map(lambda command: compile(command, directory), commands))
+	return time.perf_counter() - start
+
+def build_module_interface(directory):
+	interface = os.path.join(repo_root, 'putils', 'reflection.ixx')
+	start = time.perf_counter()
+	if compiler_kind == 'gcc':
+		# g++ writes the compiled interface to gcm.cache in the working directory
+		compile(base_command(directory) + ['-fmodules-ts', '-x', 'c++', '-c', interface, '-o', 'reflection.o'], directory)
+		flags = ['-fmodules-ts']
+	else:
+		pcm = os.path.join(directory, 'putils.reflection.pcm')
+		compile(base_command(directory) + ['--precompile', '-x', 'c++-module', interface, '-o', pcm], directory)
+		flags = [f'-fmodule-file=putils.reflection={pcm}']
+	return time.perf_counter() - start, flags
+
+def print_result(name, interface_time, build_time):
+	total = interface_time + build_time
+	print(f'{name:<8} interface {interface_time:7.2f}s  translation units {build_time:7.2f}s ({build_time / args.types * 1000:6.1f}ms each)  total {total:7.2f}s')
+
+#
+# Main
+#
+
+root = args.keep or tempfile.mkdtemp(prefix = 'putils_reflection_benchmark_')
+print(f'{args.types} types with {args.attributes} attributes, built with {args.cxx} in {root}')
+
+ok = True
+header_directory = os.path.join(root, 'header')
+try:
+	print_result('header', 0, build(header_directory, generate_project(header_directory, False), []))
+except RuntimeError as error:
+	print(f'header build failed:\n{error}', file = sys.stderr)
+	ok = False
+
+module_directory = os.path.join(root, 'module')
+try:
+	sources = generate_project(module_directory, True)
+	interface_time, module_flags = build_module_interface(module_directory)
+	print_result('module', interface_time, build(module_directory, sources, module_flags))
+except RuntimeError as error:
+	print(f'module build failed:\n{error}', file = sys.stderr)
+	ok = False
+
+if not args.keep:
+	shutil.rmtree(root)
+sys.exit(0 if ok else 1)
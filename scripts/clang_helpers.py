@@ -1,3 +1,4 @@
+import functools
 import re
 from clang.cindex import *
 
@@ -37,6 +38,23 @@ def get_fully_qualified_symbol(c):
             return res + '::' + c.spelling
         return c.spelling
 
+@functools.lru_cache(maxsize = None)
+def read_source(file_name):
+    with open(file_name, 'rb') as f:
+        return f.read()
+
+# libclang attaches an enum constant's comment to the following constants as well
+# Check that the node's comment is actually written between `previous_sibling` and the node
+def has_own_comment(node, previous_sibling):
+    if not node.raw_comment:
+        return False
+    if previous_sibling is None or node.location.file is None:
+        return True
+
+    source = read_source(node.location.file.name)
+    between = source[previous_sibling.extent.end.offset:node.extent.start.offset].decode('utf-8', errors = 'ignore')
+    return node.raw_comment.splitlines()[0].strip() in between
+
 open_brackets = '([{\'"'
 closed_brackets = ')]}\'"'
 
@@ -1,7 +1,7 @@
 include(${CMAKE_CURRENT_LIST_DIR}/build_clang_arguments.cmake)
 
 function(putils_generate_reflection_headers)
-    set(options)
+    set(options MODULE)
     set(oneValueArgs TARGET EXTENSION)
     set(multiValueArgs SOURCES CLANG_ARGS)
     cmake_parse_arguments(ARGUMENTS "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
@@ -24,6 +24,9 @@ function(putils_generate_reflection_headers)
         if (${ARGUMENTS_EXTENSION})
             list(APPEND command --extension ${ARGUMENTS_EXTENSION})
         endif()
+        if (ARGUMENTS_MODULE)
+            list(APPEND command --module)
+        endif()
 
         # Dummy file to avoid re-running the command if `source_file` hasn't changed
         get_target_property(binary_dir ${ARGUMENTS_TARGET} BINARY_DIR)
@@ -3,6 +3,7 @@
 import argparse
 import os
 import re
+import time
 from clang.cindex import *
 
 import clang_helpers
@@ -12,6 +13,8 @@ parser.add_argument('files', help = 'input headers to parse', nargs = '+')
 parser.add_argument('--extension', help = 'output file extension', default = '.rpp')
 parser.add_argument('--clang-args', help = 'extra arguments to pass to clang', nargs = argparse.REMAINDER, required = False)
 parser.add_argument('--diagnostics', help = 'Print clang diagnostic messages', action = 'store_true', required = False)
+parser.add_argument('--module', help = 'Import the experimental putils.reflection module instead of including the library', action = 'store_true', required = False)
+parser.add_argument('--timings', help = 'Print the time spent on each file', action = 'store_true', required = False)
 
 args = parser.parse_args()
 
@@ -61,9 +64,13 @@ def get_reflection_info_for_type(node, reflection_type):
 	add_list_property_to_reflection_infos('used_types')
 
 	def add_children_to_reflection_infos(node, target_reflection_type, target_kind):
+		previous_child = None
 		for child in node.get_children():
+			has_comment = clang_helpers.has_own_comment(child, previous_child)
+			previous_child = child
+
 			def should_reflect():
-				if child.brief_comment == 'putils reflect off':
+				if has_comment and child.brief_comment == 'putils reflect off':
 					return False
 
 				if re.match(r'^operator[^\w]', child.spelling):
@@ -71,7 +78,7 @@ def get_reflection_info_for_type(node, reflection_type):
 
 				if reflection_type in ['all', target_reflection_type]:
 					return True
-				if child.brief_comment == 'putils reflect':
+				if has_comment and child.brief_comment == 'putils reflect':
 					return True
 				return False
 
@@ -85,7 +92,7 @@ def get_reflection_info_for_type(node, reflection_type):
 				continue
 
 			child_info = { 'name': child.spelling }
-			metadata = get_metadata(child)
+			metadata = get_metadata(child) if has_comment else None
 			if metadata:
 				child_info['metadata'] = metadata
 
@@ -95,13 +102,14 @@ def get_reflection_info_for_type(node, reflection_type):
 
 	add_children_to_reflection_infos(node, 'attributes', CursorKind.FIELD_DECL)
 	add_children_to_reflection_infos(node, 'methods', CursorKind.CXX_METHOD)
+	add_children_to_reflection_infos(node, 'values', CursorKind.ENUM_CONSTANT_DECL)
 	return reflection_info
 
 def visit_node(node):
 	reflection_infos = []
 
 	def parse_reflection_info():
-		if node.kind not in [CursorKind.STRUCT_DECL, CursorKind.CLASS_DECL]:
+		if node.kind not in [CursorKind.STRUCT_DECL, CursorKind.CLASS_DECL, CursorKind.ENUM_DECL]:
 			return
 
 		# Ignore forward declarations
@@ -150,6 +158,7 @@ def generate_reflection_info(reflection_info):
 
 	result += generate_property_list('attributes', 'putils_reflection_attribute')
 	result += generate_property_list('methods', 'putils_reflection_attribute')
+	result += generate_property_list('values', 'putils_reflection_value')
 	result += generate_property_list('parents', 'putils_reflection_type')
 	result += generate_property_list('used_types', 'putils_reflection_type')
 	result += generate_property_list('type_metadata', 'putils_reflection_metadata')
@@ -164,25 +173,53 @@ def get_output_file(input_file):
 		return None
 	return base_file + args.extension
 
+# Cheap textual check, to avoid parsing files that can't produce any reflection code
+# This may let through files that only mention the annotation (e.g. in a regular comment), which are then parsed as before
+def has_reflection_annotation(file_name):
+	try:
+		with open(file_name, encoding = 'utf-8', errors = 'ignore') as f:
+			return 'putils reflect' in f.read()
+	except OSError:
+		return True # Let libclang report the error
+
+def print_timing(file_name, step_times):
+	if args.timings:
+		total = sum(step_times.values())
+		steps = ', '.join(f'{step} {duration * 1000:.1f}ms' for step, duration in step_times.items())
+		print(f'{file_name}: {total * 1000:.1f}ms ({steps})')
+
 #
 # Main
 #
 
-# Truncate all existing output files
+start_time = time.perf_counter()
+
+# Truncate the output files for annotated headers, and remove the others
+annotated_files = []
 for input_file in args.files:
 	output_file = get_output_file(input_file)
 	if not output_file:
 		continue
 
-	with open(output_file, 'w'):
-		pass
+	scan_start = time.perf_counter()
+	annotated = has_reflection_annotation(input_file)
+	scan_time = time.perf_counter() - scan_start
 
-parsed_files = clang_helpers.parse_files(args.files, args.clang_args)
+	if annotated:
+		annotated_files.append((input_file, scan_time))
+		with open(output_file, 'w'):
+			pass
+	else:
+		if os.path.exists(output_file):
+			os.remove(output_file)
+		print_timing(input_file, { 'scan': scan_time })
 
-for file_name, parsed_file in parsed_files.items():
+for file_name, scan_time in annotated_files:
 	output_file = get_output_file(file_name)
-	if not output_file:
-		continue
+
+	parse_start = time.perf_counter()
+	parsed_file = clang_helpers.parse_files([file_name], args.clang_args)[file_name]
+	parse_time = time.perf_counter() - parse_start
 
 	if args.diagnostics:
 		diagnostics = parsed_file['diagnostics']
@@ -191,6 +228,7 @@ for file_name, parsed_file in parsed_files.items():
 			for diagnostic in diagnostics:
 				print(f'\t{diagnostic}')
 
+	generate_start = time.perf_counter()
 	reflection_infos = []
 	for node in parsed_file['nodes']:
 		reflection_infos += visit_node(node)
@@ -198,11 +236,17 @@ for file_name, parsed_file in parsed_files.items():
 	if not reflection_infos:
 		if os.path.exists(output_file):
 			os.remove(output_file)
-		continue
-
-	result = '#pragma once\n\n#include "putils/reflection.hpp"'
-	for reflection_info in reflection_infos:
-		result += generate_reflection_info(reflection_info)
-
-	with open(output_file, 'w') as f:
-		f.write(result)
\ No newline at end of file
+	else:
+		if args.module:
+			result = '#pragma once\n\n#include "putils/reflection_macros.hpp"\nimport putils.reflection;'
+		else:
+			result = '#pragma once\n\n#include "putils/reflection.hpp"'
+		for reflection_info in reflection_infos:
+			result += generate_reflection_info(reflection_info)
+
+		with open(output_file, 'w') as f:
+			f.write(result)
+	print_timing(file_name, { 'scan': scan_time, 'parse': parse_time, 'generate': time.perf_counter() - generate_start })
+
+if args.timings:
+	print(f'Total: {(time.perf_counter() - start_time) * 1000:.1f}ms for {len(args.files)} files, {len(annotated_files)} parsed')
\ No newline at end of file
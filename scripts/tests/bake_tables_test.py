@@ -0,0 +1,63 @@
+import os
+import shutil
+import subprocess
+import sys
+
+import pytest
+
+current_path = os.path.dirname(os.path.realpath(__file__))
+repo_root = os.path.dirname(os.path.dirname(current_path))
+meta_include = os.environ.get('PUTILS_META_INCLUDE', os.path.join(repo_root, 'meta'))
+cxx = os.environ.get('CXX', 'g++')
+
+def bake(data_file, output, name = 'monsters'):
+    script = os.path.join(os.path.dirname(current_path), 'bake_tables.py')
+    data = os.path.join(current_path, data_file)
+    result = subprocess.run([sys.executable, script, data, '--type', 'game::monster', '--name', name, '--include', 'monster.hpp', '--output', str(output)], capture_output = True, text = True)
+    assert result.returncode == 0, result.stderr
+    return output.read_text()
+
+def test_bake_json(tmp_path):
+    output = bake('monsters.json', tmp_path / 'monsters.baked.hpp')
+    with open(os.path.join(current_path, 'expected_monsters.hpp')) as reference:
+        assert output == reference.read()
+
+def test_bake_csv(tmp_path):
+    json_output = bake('monsters.json', tmp_path / 'monsters.baked.hpp')
+    csv_output = bake('monsters.csv', tmp_path / 'monsters_csv.baked.hpp')
+
+    # Cells that look like numbers keep their text, so string attributes get it unchanged
+    assert 'bake_attribute(ret[0], "code", "007", 7);' in csv_output
+    assert 'bake_attribute(ret[1], "code", "1e3", 1000.0);' in csv_output
+
+    # Other than that, only the "Generated from" line differs
+    csv_output = csv_output.replace(', "007", 7);', ', "007");').replace(', "1e3", 1000.0);', ', "1e3");')
+    assert json_output.replace('monsters.json', 'monsters.csv') == csv_output
+
+def test_nested_paths_checked(tmp_path):
+    output = bake('monsters.json', tmp_path / 'monsters.baked.hpp')
+    assert 'static_assert(putils::reflection::has_attribute_path<game::monster>("position.x")' in output
+    assert 'static_assert(putils::reflection::has_attribute_path<game::monster>("loot.1")' in output
+
+source = '''
+#include "monsters.baked.hpp"
+#include "monsters_csv.baked.hpp"
+
+static_assert(monsters[0].code == "007" && monsters_csv[0].code == "007");
+static_assert(monsters[1].code == "1e3" && monsters_csv[1].code == "1e3");
+static_assert(monsters[1].name == "dragon \\"the red\\"");
+static_assert(monsters_csv[1].kind == game::monster_kind::ranged);
+static_assert(monsters_csv[1].hp == 1000 && monsters_csv[0].speed == 1.5f);
+static_assert(monsters_csv[0].position.y == 2 && monsters_csv[1].loot[0] == 42);
+static_assert(monsters[0].get_level() == 3 && monsters_csv[1].get_level() == 50);
+'''
+
+@pytest.mark.skipif(not os.path.exists(os.path.join(meta_include, 'putils', 'meta', 'table.hpp')), reason = 'putils/meta not found, set PUTILS_META_INCLUDE')
+@pytest.mark.skipif(shutil.which(cxx) is None, reason = f'{cxx} not found')
+def test_baked_tables_compile(tmp_path):
+    bake('monsters.json', tmp_path / 'monsters.baked.hpp')
+    bake('monsters.csv', tmp_path / 'monsters_csv.baked.hpp', 'monsters_csv')
+    source_file = tmp_path / 'tables.cpp'
+    source_file.write_text(source)
+    result = subprocess.run([cxx, '-std=c++20', '-fsyntax-only', f'-I{repo_root}', f'-I{meta_include}', f'-I{current_path}', f'-I{tmp_path}', str(source_file)], capture_output = True, text = True)
+    assert result.returncode == 0, result.stderr
@@ -0,0 +1,61 @@
+import os
+import re
+import shutil
+import subprocess
+
+import pytest
+
+# Check that reflection-based visitors compile down to the same code as the member-pointer workaround they replace
+
+repo_root = os.path.dirname(os.path.dirname(os.path.dirname(os.path.realpath(__file__))))
+meta_include = os.environ.get('PUTILS_META_INCLUDE', os.path.join(repo_root, 'meta'))
+cxx = os.environ.get('CXX', 'g++')
+
+source = '''
+#include "putils/reflection.hpp"
+
+struct particle {
+	float x, y, z;
+	int age;
+	double mass;
+};
+
+#define refltype particle
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y),
+		putils_reflection_attribute(z),
+		putils_reflection_attribute(age),
+		putils_reflection_attribute(mass)
+	);
+};
+#undef refltype
+
+extern "C" void copy_zip(particle & dst, const particle & src) {
+	putils::reflection::for_each_attribute_zip(dst, src, [](const auto &, auto & d, const auto & s) noexcept { d = s; });
+}
+
+extern "C" void copy_member_pointers(particle & dst, const particle & src) {
+	putils::reflection::for_each_attribute<particle>([&](const auto & attr) noexcept { dst.*attr.ptr = src.*attr.ptr; });
+}
+'''
+
+def get_function_instructions(assembly, name):
+	match = re.search(rf'^{name}:\n(.*?)\.cfi_endproc', assembly, re.MULTILINE | re.DOTALL)
+	assert match, f'{name} not found in assembly'
+	lines = [line.strip() for line in match.group(1).splitlines() if line.startswith('\t')]
+	return [line.split()[0] for line in lines if line and not line.startswith('.')]
+
+@pytest.mark.skipif(not os.path.exists(os.path.join(meta_include, 'putils', 'meta', 'table.hpp')), reason = 'putils/meta not found, set PUTILS_META_INCLUDE')
+@pytest.mark.skipif(shutil.which(cxx) is None, reason = f'{cxx} not found')
+def test_for_each_attribute_zip_inlined(tmp_path):
+	source_file = tmp_path / 'codegen.cpp'
+	source_file.write_text(source)
+	result = subprocess.run([cxx, '-std=c++20', '-O2', '-S', '-o', '-', f'-I{repo_root}', f'-I{meta_include}', str(source_file)], capture_output = True, text = True)
+	assert result.returncode == 0, result.stderr
+
+	zip_instructions = get_function_instructions(result.stdout, 'copy_zip')
+	# No calls left, and no tail calls (x86 and ARM)
+	assert not any(instruction.startswith('call') or instruction in ('jmp', 'b', 'bl') for instruction in zip_instructions)
+	assert len(zip_instructions) <= len(get_function_instructions(result.stdout, 'copy_member_pointers'))
@@ -0,0 +1,43 @@
+#pragma once
+
+// Generated by bake_tables.py from monsters.json, do not edit
+
+#include <array>
+#include "putils/reflection_helpers/bake.hpp"
+#include "monster.hpp"
+
+inline constexpr auto monsters = [] {
+	std::array<game::monster, 2> ret{};
+	putils::reflection::bake_attribute(ret[0], "name", "goblin");
+	putils::reflection::bake_attribute(ret[0], "code", "007");
+	putils::reflection::bake_attribute(ret[0], "kind", "melee");
+	putils::reflection::bake_attribute(ret[0], "health", "10", 10);
+	putils::reflection::bake_attribute(ret[0], "speed", "1.5", 1.5);
+	putils::reflection::bake_attribute(ret[0], "boss", "false", false);
+	putils::reflection::bake_attribute(ret[0], "position.x", "1", 1);
+	putils::reflection::bake_attribute(ret[0], "position.y", "2", 2);
+	putils::reflection::bake_attribute(ret[0], "loot.0", "1", 1);
+	putils::reflection::bake_attribute(ret[0], "loot.1", "2", 2);
+	putils::reflection::bake_attribute(ret[0], "level", "3", 3);
+	putils::reflection::bake_attribute(ret[1], "name", "dragon \"the red\"");
+	putils::reflection::bake_attribute(ret[1], "code", "1e3");
+	putils::reflection::bake_attribute(ret[1], "kind", "ranged");
+	putils::reflection::bake_attribute(ret[1], "health", "1000", 1000);
+	putils::reflection::bake_attribute(ret[1], "speed", "0.25", 0.25);
+	putils::reflection::bake_attribute(ret[1], "boss", "true", true);
+	putils::reflection::bake_attribute(ret[1], "loot.0", "42", 42);
+	putils::reflection::bake_attribute(ret[1], "level", "50", 50);
+	return ret;
+}();
+
+static_assert(putils::reflection::has_attribute_path<game::monster>("name"), "name is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("code"), "code is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("kind"), "kind is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("health"), "health is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("speed"), "speed is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("boss"), "boss is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("position.x"), "position.x is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("position.y"), "position.y is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("loot.0"), "loot.0 is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("loot.1"), "loot.1 is not a reflected attribute of game::monster");
+static_assert(putils::reflection::has_attribute_path<game::monster>("level"), "level is not a reflected attribute of game::monster");
@@ -1,15 +1,118 @@
 import os
 import filecmp
+import pytest
+import shutil
+import subprocess
+import sys
 
-def test_generate_reflection_headers():
+current_path = os.path.dirname(os.path.realpath(__file__))
+repo_root = os.path.dirname(os.path.dirname(current_path))
+meta_include = os.environ.get('PUTILS_META_INCLUDE', os.path.join(repo_root, 'meta'))
+cxx = os.environ.get('CXX', 'g++')
+
+def test_generate_reflection_headers(tmp_path):
     current_file = os.path.realpath(__file__)
     current_path = os.path.dirname(current_file)
     parent_directory = os.path.dirname(current_path)
 
+    # The reflection header is written next to the parsed one
     script = os.path.join(parent_directory, 'generate_reflection_headers.py')
-    header = os.path.join(current_path, 'reflectible.hpp')
+    header = tmp_path / 'reflectible.hpp'
+    shutil.copy(os.path.join(current_path, 'reflectible.hpp'), header)
     os.system(f'python {script} {header} --clang-args -std=c++20')
 
-    reflection_header = os.path.join(current_path, 'reflectible.rpp')
+    reflection_header = tmp_path / 'reflectible.rpp'
     reference_header = os.path.join(current_path, 'expected.rpp')
     assert filecmp.cmp(reflection_header, reference_header)
+
+def test_skip_unannotated_header(tmp_path):
+    current_file = os.path.realpath(__file__)
+    parent_directory = os.path.dirname(os.path.dirname(current_file))
+    script = os.path.join(parent_directory, 'generate_reflection_headers.py')
+
+    header = tmp_path / 'unannotated.hpp'
+    header.write_text('#pragma once\n\nstruct unannotated {};\n')
+    reflection_header = tmp_path / 'unannotated.rpp'
+    reflection_header.write_text('stale')
+
+    result = subprocess.run([sys.executable, script, str(header), '--timings'], capture_output = True, text = True)
+    assert result.returncode == 0
+    assert not reflection_header.exists()
+    assert '0 parsed' in result.stdout
+
+enum_header = '''#pragma once
+
+namespace game {
+	//! putils reflect values
+	enum class direction : unsigned char {
+		north = 1,
+		east = 2,
+		//! putils reflect off
+		none = 0,
+		south = 4,
+		west = 8,
+	};
+
+	struct unit {
+		//! putils reflect none
+		enum state {
+			idle,
+			//! putils reflect
+			moving,
+			dead,
+		};
+	};
+}
+'''
+
+expected_enum_reflection = '''
+
+#define refltype game::direction
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_values(
+		putils_reflection_value(north),
+		putils_reflection_value(east),
+		putils_reflection_value(south),
+		putils_reflection_value(west)
+	);
+};
+#undef refltype
+
+#define refltype game::unit::state
+putils_reflection_info {
+	putils_reflection_class_name;
+	putils_reflection_values(
+		putils_reflection_value(moving)
+	);
+};
+#undef refltype'''
+
+enum_source = '''#include "enums.hpp"
+#include "enums.rpp"
+
+static_assert(putils::reflection::enum_to_string(game::direction::south) == "south");
+static_assert(putils::reflection::enum_from_string<game::direction>("west") == game::direction::west);
+static_assert(!putils::reflection::enum_from_string<game::direction>("none"));
+static_assert(putils::reflection::enum_from_string<game::unit::state>("moving") == game::unit::moving);
+static_assert(!putils::reflection::enum_from_string<game::unit::state>("idle"));
+'''
+
+def generate_enum_reflection(tmp_path):
+    script = os.path.join(repo_root, 'scripts', 'generate_reflection_headers.py')
+    header = tmp_path / 'enums.hpp'
+    header.write_text(enum_header)
+    subprocess.run([sys.executable, script, str(header), '--clang-args', '-std=c++20'], check = True)
+    return (tmp_path / 'enums.rpp').read_text()
+
+def test_annotated_enums(tmp_path):
+    assert generate_enum_reflection(tmp_path).endswith(expected_enum_reflection)
+
+@pytest.mark.skipif(not os.path.exists(os.path.join(meta_include, 'putils', 'meta', 'table.hpp')), reason = 'putils/meta not found, set PUTILS_META_INCLUDE')
+@pytest.mark.skipif(shutil.which(cxx) is None, reason = f'{cxx} not found')
+def test_annotated_enums_compile(tmp_path):
+    generate_enum_reflection(tmp_path)
+    source_file = tmp_path / 'enums.cpp'
+    source_file.write_text(enum_source)
+    result = subprocess.run([cxx, '-std=c++20', '-fsyntax-only', f'-I{repo_root}', f'-I{meta_include}', f'-I{tmp_path}', str(source_file)], capture_output = True, text = True)
+    assert result.returncode == 0, result.stderr
@@ -0,0 +1,72 @@
+#pragma once
+
+// stl
+#include <array>
+#include <string_view>
+
+// reflection
+#include "putils/reflection.hpp"
+
+namespace game {
+	enum class monster_kind {
+		melee,
+		ranged,
+	};
+
+	struct position {
+		int x = 0;
+		int y = 0;
+	};
+
+	struct monster {
+		std::string_view name;
+		std::string_view code;
+		monster_kind kind = monster_kind::melee;
+		int hp = 0;
+		float speed = 0;
+		bool boss = false;
+		game::position position;
+		std::array<int, 4> loot{};
+
+		constexpr int get_level() const noexcept { return _level; }
+
+	private:
+		int _level = 1;
+		putils_reflection_friend(monster);
+	};
+}
+
+#define refltype game::monster_kind
+putils_reflection_info {
+	putils_reflection_values(
+		putils_reflection_value(melee),
+		putils_reflection_value(ranged)
+	);
+};
+#undef refltype
+
+#define refltype game::position
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(x),
+		putils_reflection_attribute(y)
+	);
+};
+#undef refltype
+
+#define refltype game::monster
+putils_reflection_info {
+	putils_reflection_attributes(
+		putils_reflection_attribute(name),
+		putils_reflection_attribute(code),
+		putils_reflection_attribute(kind),
+		// Reflected under a different name than the member's
+		putils::reflection::attribute_info{ .name = "health", .ptr = &game::monster::hp, .metadata = putils::make_table() },
+		putils_reflection_attribute(speed),
+		putils_reflection_attribute(boss),
+		putils_reflection_attribute(position),
+		putils_reflection_attribute(loot),
+		putils_reflection_attribute_private(_level)
+	);
+};
+#undef refltype
@@ -16,4 +16,14 @@ struct reflectible : base {
 	//! metadata: [("zero", 0), ("foo", "bar"), (("key", "morekey"), ("value", ["morevalue1", "morevalue2"]))]
 	void f() noexcept;
 	int g() const noexcept;
+};
+
+//! putils reflect all
+enum class color {
+	red,
+	//! metadata: [("key", "value")]
+	green,
+	//! putils reflect off
+	internal,
+	blue,
 };
\ No newline at end of file